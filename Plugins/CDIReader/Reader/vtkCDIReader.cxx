@@ -61,6 +61,8 @@
 #include "cdi.h"
 #include "vtk_netcdf.h"
 
+#include <algorithm>
+#include <array>
 #include <sstream>
 
 using namespace std;
@@ -107,6 +109,7 @@ public:
       this->CellVarIDs[i] = -1;
       this->DomainVars[i] = std::string("");
     }
+    this->LoadedDataKey.fill(-1);
   }
   ~Internal() = default;
 
@@ -115,6 +118,10 @@ public:
   CDIVar PointVars[MAX_VARS];
   string DomainVars[MAX_VARS];
 
+  // Time step, vertical level (-1 for the multilayer view), piece and number
+  // of pieces the variable data arrays were read for.
+  std::array<int, 4> LoadedDataKey;
+
   // The Point data we expect to receive from each process.
   vtkSmartPointer<vtkIdTypeArray> PointsExpectedFromProcessesLengths;
   vtkSmartPointer<vtkIdTypeArray> PointsExpectedFromProcessesOffsets;
@@ -730,45 +737,27 @@ int vtkCDIReader::RequestUpdateExtent(
 long vtkCDIReader::GetPartitioning(int piece, int numPieces, int numCellsPerLevel,
   int numPointsPerCell, int& beginPoint, int& endPoint, int& beginCell, int& endCell)
 {
-  if (numPieces == 1)
-  {
-    beginPoint = 0;
-    endPoint = (numCellsPerLevel * numPointsPerCell) - 1;
-    beginCell = 0;
-    endCell = numCellsPerLevel - 1;
+  // Each piece reads one contiguous range of cells, of all levels at once in
+  // the multilayer view. The remainder is spread over the pieces so that
+  // their sizes differ by at most one cell.
+  const long long numCells = numCellsPerLevel;
+  numPieces = std::max(numPieces, 1);
+  beginCell = static_cast<int>(numCells * piece / numPieces);
+  endCell = static_cast<int>(numCells * (piece + 1) / numPieces) - 1;
+  beginPoint = beginCell * numPointsPerCell;
+  endPoint = ((endCell + 1) * numPointsPerCell) - 1;
 
-    return numCellsPerLevel;
-  }
-  else
-  {
-    long localCells = 0;
-    int cells_per_piece = floor(numCellsPerLevel / numPieces);
-    if (piece == 0)
-    {
-      beginCell = 0;
-      endCell = (piece + 1) * cells_per_piece - 1;
-      beginPoint = 0;
-      endPoint = ((endCell + 1) * numPointsPerCell) - 1;
-      localCells = 1 + endCell;
-    }
-    else if (piece < (numPieces - 1))
-    {
-      beginCell = piece * cells_per_piece;
-      endCell = (piece + 1) * cells_per_piece;
-      beginPoint = beginCell * numPointsPerCell;
-      endPoint = (endCell * numPointsPerCell) - 1;
-      localCells = endCell - beginCell;
-    }
-    else if (piece == (numPieces - 1))
-    {
-      beginCell = piece * cells_per_piece;
-      endCell = numCellsPerLevel - 1;
-      beginPoint = beginCell * numPointsPerCell;
-      endPoint = ((endCell + 1) * numPointsPerCell) - 1;
-      localCells = 1 + endCell - beginCell;
-    }
-    return localCells;
-  }
+  return endCell - beginCell + 1;
+}
+
+//----------------------------------------------------------------------------
+// Index, in the current file, of the time step to read for a time value.
+//----------------------------------------------------------------------------
+int vtkCDIReader::GetTimestepIndex(double dTime)
+{
+  int global_timestep = dTime / this->TStepDistance;
+  int local_timestep = global_timestep - (this->NumberOfTimeSteps * this->FileSeriesNumber);
+  return min(local_timestep, this->NumberOfTimeSteps - 1);
 }
 
 //----------------------------------------------------------------------------
@@ -793,16 +782,6 @@ int vtkCDIReader::RequestData(vtkInformation* vtkNotUsed(reqInfo),
   this->NumberLocalCells = this->GetPartitioning(this->Piece, this->NumPieces, this->NumberOfCells,
     this->PointsPerCell, this->BeginPoint, this->EndPoint, this->BeginCell, this->EndCell);
 
-  if (this->DataRequested)
-  {
-    this->DestroyData();
-  }
-
-  if (!this->ReadAndOutputGrid(true))
-  {
-    return 0;
-  }
-
   double requestedTimeStep = 0.;
 #ifndef NDEBUG
   int numRequestedTimeSteps = 0;
@@ -821,6 +800,22 @@ int vtkCDIReader::RequestData(vtkInformation* vtkNotUsed(reqInfo),
   vtkDebugMacro("Num Time steps requested: " << numRequestedTimeSteps << endl);
   this->DTime = requestedTimeStep;
   vtkDebugMacro("this->DTime: " << this->DTime << endl);
+
+  // Variables already read for this time step, vertical level and piece are
+  // kept, so that only newly selected variables are read.
+  const std::array<int, 4> loadedDataKey = { { this->GetTimestepIndex(this->DTime),
+    this->ShowMultilayerView ? -1 : this->VerticalLevelSelected, this->Piece, this->NumPieces } };
+  if (this->DataRequested && loadedDataKey != this->Internals->LoadedDataKey)
+  {
+    this->DestroyData();
+  }
+  this->Internals->LoadedDataKey = loadedDataKey;
+
+  if (!this->ReadAndOutputGrid(true))
+  {
+    return 0;
+  }
+
   double dTimeTemp = this->DTime;
   output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), dTimeTemp);
   vtkDebugMacro("dTimeTemp: " << dTimeTemp << endl);
@@ -830,8 +825,11 @@ int vtkCDIReader::RequestData(vtkInformation* vtkNotUsed(reqInfo),
   {
     if (this->GetCellArrayStatus(this->Internals->CellVars[var].Name))
     {
-      vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
-      this->LoadCellVarData(var, this->DTime);
+      if (this->CellVarDataArray[var] == nullptr)
+      {
+        vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
+        this->LoadCellVarData(var, this->DTime);
+      }
       output->GetCellData()->AddArray(this->CellVarDataArray[var]);
     }
   }
@@ -839,8 +837,11 @@ int vtkCDIReader::RequestData(vtkInformation* vtkNotUsed(reqInfo),
   {
     if (this->GetPointArrayStatus(this->Internals->PointVars[var].Name))
     {
-      vtkDebugMacro("Loading Point Variable: " << var << endl);
-      this->LoadPointVarData(var, this->DTime);
+      if (this->PointVarDataArray[var] == nullptr)
+      {
+        vtkDebugMacro("Loading Point Variable: " << var << endl);
+        this->LoadPointVarData(var, this->DTime);
+      }
       output->GetPointData()->AddArray(this->PointVarDataArray[var]);
     }
   }
@@ -849,9 +850,12 @@ int vtkCDIReader::RequestData(vtkInformation* vtkNotUsed(reqInfo),
   {
     if (this->GetDomainArrayStatus(this->Internals->DomainVars[var].c_str()))
     {
-      vtkDebugMacro(
-        "Loading Domain Variable: " << this->Internals->DomainVars[var].c_str() << endl);
-      this->LoadDomainVarData(var);
+      if (this->DomainVarDataArray[var] == nullptr)
+      {
+        vtkDebugMacro(
+          "Loading Domain Variable: " << this->Internals->DomainVars[var].c_str() << endl);
+        this->LoadDomainVarData(var);
+      }
       output->GetFieldData()->AddArray(this->DomainVarDataArray[var]);
     }
   }
@@ -2547,9 +2551,7 @@ int vtkCDIReader::LoadCellVarDataTemplate(
   CDIVar* cdiVar = &(this->Internals->CellVars[variableIndex]);
   int varType = cdiVar->Type;
 
-  int global_timestep = dTimeStep / this->TStepDistance;
-  int local_timestep = global_timestep - (this->NumberOfTimeSteps * this->FileSeriesNumber);
-  int Timestep = min(local_timestep, this->NumberOfTimeSteps - 1);
+  int Timestep = this->GetTimestepIndex(dTimeStep);
   vtkDebugMacro("Time: " << Timestep << endl);
   vtkDebugMacro("Dimensions: " << varType << endl);
 
@@ -2639,9 +2641,7 @@ int vtkCDIReader::LoadPointVarDataTemplate(
     dataTmp = new ValueType[this->NumberLocalPoints];
   }
 
-  int global_timestep = dTimeStep / this->TStepDistance;
-  int local_timestep = global_timestep - (this->NumberOfTimeSteps * this->FileSeriesNumber);
-  int Timestep = min(local_timestep, this->NumberOfTimeSteps - 1);
+  int Timestep = this->GetTimestepIndex(dTimeStep);
   vtkDebugMacro("Time: " << Timestep << endl);
   vtkDebugMacro("dTimeStep requested: " << dTimeStep << endl);
 
@@ -3055,39 +3055,13 @@ void vtkCDIReader::SetFileName(const char* val)
 //----------------------------------------------------------------------------
 void vtkCDIReader::SetVerticalLevel(int level)
 {
+  // The variables of the new level are read by the next RequestData.
   if (this->VerticalLevelSelected != level)
   {
     this->VerticalLevelSelected = level;
     this->Modified();
     vtkDebugMacro("Set VerticalLevelSelected to: " << level);
   }
-  vtkDebugMacro("InfoRequested?: " << this->InfoRequested);
-
-  if (!this->InfoRequested || !this->DataRequested)
-  {
-    return;
-  }
-
-  for (int var = 0; var < this->NumberOfPointVars; var++)
-  {
-    if (this->PointDataArraySelection->GetArraySetting(var))
-    {
-      vtkDebugMacro("Loading Point Variable: " << this->Internals->PointVars[var].Name << endl);
-      this->LoadPointVarData(var, this->DTime);
-    }
-  }
-
-  for (int var = 0; var < this->NumberOfCellVars; var++)
-  {
-    if (this->CellDataArraySelection->GetArraySetting(var))
-    {
-      vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
-      this->LoadCellVarData(var, this->DTime);
-    }
-  }
-
-  this->PointDataArraySelection->Modified();
-  this->CellDataArraySelection->Modified();
 }
 
 //----------------------------------------------------------------------------
@@ -182,6 +182,7 @@ protected:
     double* PointLon, double* PointLat, int temp_nbr_vertices, int* triangle_list, int* nbr_cells);
   long GetPartitioning(int piece, int numPieces, int numCellsPerLevel, int numPointsPerCell,
     int& beginPoint, int& endPoint, int& beginCell, int& endCell);
+  int GetTimestepIndex(double dTime);
   void SetupPointConnectivity();
 
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -0,0 +1,184 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestGMVReaderConcurrentReads.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that two vtkGMVReader instances reading different files on different
+// threads at the same time produce the same output as reading the files one
+// at a time.
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkGMVReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+// Writes an ASCII GMV file with a `dim`^3 block of hexahedra and a node
+// variable "nodeid" set to `scale` times the node index.
+bool WriteHexBlock(const std::string& fname, int dim, double scale)
+{
+  std::ofstream file(fname.c_str());
+  if (!file)
+  {
+    return false;
+  }
+  const int npts = dim + 1;
+  file << "gmvinput ascii\n";
+  file << "nodes " << npts * npts * npts << "\n";
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (int k = 0; k < npts; ++k)
+    {
+      for (int j = 0; j < npts; ++j)
+      {
+        for (int i = 0; i < npts; ++i)
+        {
+          file << (axis == 0 ? i : (axis == 1 ? j : k)) << " ";
+        }
+        file << "\n";
+      }
+    }
+  }
+  file << "cells " << dim * dim * dim << "\n";
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        // node ids start at 1.
+        const int p0 = 1 + i + j * npts + k * npts * npts;
+        const int p1 = p0 + 1;
+        const int p2 = p1 + npts;
+        const int p3 = p0 + npts;
+        const int dk = npts * npts;
+        file << "hex 8 " << p0 << " " << p1 << " " << p2 << " " << p3 << " " << p0 + dk << " "
+             << p1 + dk << " " << p2 + dk << " " << p3 + dk << "\n";
+      }
+    }
+  }
+  file << "variable\n";
+  file << "nodeid 1\n";
+  for (int cc = 0; cc < npts * npts * npts; ++cc)
+  {
+    file << scale * cc << "\n";
+  }
+  file << "endvars\n";
+  file << "endgmv\n";
+  return static_cast<bool>(file);
+}
+
+bool ReadAndVerify(const std::string& fname, int dim, double scale)
+{
+  vtkNew<vtkGMVReader> reader;
+  reader->SetFileName(fname.c_str());
+  reader->Update();
+
+  const vtkIdType npts = (dim + 1) * (dim + 1) * (dim + 1);
+  vtkIdType numCells = 0;
+  vtkDataSet* mesh = nullptr;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(reader->GetOutput()->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (auto ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+    {
+      numCells += ds->GetNumberOfCells();
+      mesh = ds->GetNumberOfCells() > 0 ? ds : mesh;
+    }
+  }
+  if (!mesh || numCells != dim * dim * dim || mesh->GetNumberOfPoints() != npts)
+  {
+    std::cerr << fname << ": expected " << dim * dim * dim << " cells and " << npts
+              << " points." << std::endl;
+    return false;
+  }
+
+  vtkDataArray* nodeid = mesh->GetPointData()->GetArray("nodeid");
+  if (!nodeid || nodeid->GetNumberOfTuples() != npts)
+  {
+    std::cerr << fname << ": missing or incomplete 'nodeid' array." << std::endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < npts; ++cc)
+  {
+    if (nodeid->GetComponent(cc, 0) != scale * cc)
+    {
+      std::cerr << fname << ": incorrect 'nodeid' value at " << cc << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestGMVReaderConcurrentReads(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fname1 = std::string(tempDir) + "/TestGMVReaderConcurrentReads1.gmv";
+  const std::string fname2 = std::string(tempDir) + "/TestGMVReaderConcurrentReads2.gmv";
+  delete[] tempDir;
+
+  // meshes of different sizes and values, so that any state shared between
+  // the two readers shows up in the output.
+  const int dim1 = 12, dim2 = 17;
+  const double scale1 = 1.0, scale2 = -0.5;
+  if (!WriteHexBlock(fname1, dim1, scale1) || !WriteHexBlock(fname2, dim2, scale2))
+  {
+    std::cerr << "Failed to write the test files." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // sequential reads, for reference.
+  if (!ReadAndVerify(fname1, dim1, scale1) || !ReadAndVerify(fname2, dim2, scale2))
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::atomic<bool> success(true);
+  const int repeats = 5;
+  std::thread thread1([&]() {
+    for (int cc = 0; cc < repeats; ++cc)
+    {
+      if (!ReadAndVerify(fname1, dim1, scale1))
+      {
+        success = false;
+      }
+    }
+  });
+  std::thread thread2([&]() {
+    for (int cc = 0; cc < repeats; ++cc)
+    {
+      if (!ReadAndVerify(fname2, dim2, scale2))
+      {
+        success = false;
+      }
+    }
+  });
+  thread1.join();
+  thread2.join();
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
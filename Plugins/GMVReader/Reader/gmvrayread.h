@@ -7,6 +7,17 @@
 #define EXTERN /**/
 #endif
 
+/*  Per thread reader state, see gmvread.h.  */
+#ifndef GMV_THREAD_LOCAL
+#if defined(__cplusplus)
+#define GMV_THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define GMV_THREAD_LOCAL _Thread_local
+#else
+#define GMV_THREAD_LOCAL /**/
+#endif
+#endif
+
 /*  Keyword types.  */
 #define RAYS        1
 #define RAYIDS      2
@@ -23,7 +34,7 @@ struct gmvray
           double *field[NRAYVARS];
          };
 
-EXTERN struct gmvray_data_type
+EXTERN GMV_THREAD_LOCAL struct gmvray_data_type
          {
           int     nrays;    /*  Number of rays in the file.  */
           int     nvars;    /*  Number of ray variable fields.  */
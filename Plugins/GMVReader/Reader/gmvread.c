@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <ctype.h>
     
 #define RDATA_INIT
 #include "gmvread.h"
@@ -44,26 +45,26 @@
 #define MAXFACES 10000
 #define GMV_MIN(a1,a2)   ( ((a1) < (a2)) ? (a1):(a2) )
 
-static int charsize = CHARSIZE, /*shortsize = SHORTSIZE,*/ intsize = INTSIZE, 
+static GMV_THREAD_LOCAL int charsize = CHARSIZE, /*shortsize = SHORTSIZE,*/ intsize = INTSIZE, 
            /*wordsize = WORDSIZE,*/ floatsize = FLOATSIZE,
            /*longsize = LONGSIZE,*/ doublesize = DOUBLESIZE,
            longlongsize = LONGLONGSIZE, charsize_in;
 
-static long numnodes, numcells, lncells, numcellsin, numfaces, lnfaces,
+static GMV_THREAD_LOCAL long numnodes, numcells, lncells, numcellsin, numfaces, lnfaces,
             numfacesin, ncells_struct;
 
-static int numsurf, lnsurf, numsurfin, numtracers, numunits;
+static GMV_THREAD_LOCAL int numsurf, lnsurf, numsurfin, numtracers, numunits;
 
-static short amrflag_in, structflag_in, fromfileflag, fromfileskip = 0;
-static short nodes_read = 0, cells_read = 0, faces_read = 0, 
+static GMV_THREAD_LOCAL short amrflag_in, structflag_in, fromfileflag, fromfileskip = 0;
+static GMV_THREAD_LOCAL short nodes_read = 0, cells_read = 0, faces_read = 0, 
              surface_read = 0, iend = 0, swapbytes_on = 0, skipflag = 0, 
              reading_fromfile = 0, vfaceflag = 0, node_inp_type, 
              printon = 0;
 
-static int curr_keyword, ftypeGlobal, ftype_sav, readkeyword, ff_keyword = -1;
+static GMV_THREAD_LOCAL int curr_keyword, ftypeGlobal, ftype_sav, readkeyword, ff_keyword = -1;
 
-static unsigned wordbuf;
-static char sav_keyword[MAXKEYWORDLENGTH+64], input_dir[MAXFILENAMELENGTH];
+static GMV_THREAD_LOCAL unsigned wordbuf;
+static GMV_THREAD_LOCAL char sav_keyword[MAXKEYWORDLENGTH+64], input_dir[MAXFILENAMELENGTH];
 
 void swapbytes(void *from, int size, int nitems),
      readnodes(FILE *gmvin, int ftype),
@@ -96,10 +97,10 @@ void swapbytes(void *from, int size, int nitems),
      readghosts(FILE *gmvin, int ftype),
      readvects(FILE *gmvin, int ftype),
      gmvrdmemerr(), ioerrtst(FILE *gmvin), endfromfile();
-static FILE *gmvinGlobal = NULL, *gmvin_sav = NULL;
+static GMV_THREAD_LOCAL FILE *gmvinGlobal = NULL, *gmvin_sav = NULL;
 
-static char *file_path = NULL;
-static int errormsgvarlen = 0;
+static GMV_THREAD_LOCAL char *file_path = NULL;
+static GMV_THREAD_LOCAL int errormsgvarlen = 0;
 
 int binread(void* ptr, int size, int type, long nitems, FILE* stream);
 int word2int(unsigned wordin);
@@ -1030,16 +1031,92 @@ void gmvread_data()
 }
 
 
+/*  ASCII numbers are scanned character by character with the unlocked  */
+/*  getc variants and converted with strtol/strtod, which is much faster */
+/*  than fscanf for the large arrays of ASCII files.                     */
+#if defined(_WIN32)
+#define GMV_GETC(f) _getc_nolock(f)
+#elif defined(__unix__) || defined(__APPLE__)
+#define GMV_GETC(f) getc_unlocked(f)
+#else
+#define GMV_GETC(f) getc(f)
+#endif
+
+#define MAXNUMBERLENGTH 128
+
+int rdnumber(FILE* gmvin, char* number)
+{
+  /*                                                          */
+  /*  Read the next whitespace separated token into number.   */
+  /*  Like fscanf, the separator that ends the token is left  */
+  /*  in the stream.  Returns the token length.               */
+  /*                                                          */
+  int c, len = 0;
+
+  do
+    c = GMV_GETC(gmvin);
+  while (c != EOF && isspace(c));
+
+  while (c != EOF && !isspace(c))
+    {
+      if (len < MAXNUMBERLENGTH - 1)
+        number[len] = (char)c;
+      len++;
+      c = GMV_GETC(gmvin);
+    }
+  if (c != EOF) ungetc(c, gmvin);
+
+  /*  Tokens too long for a number are reported as format errors.  */
+  if (len >= MAXNUMBERLENGTH) len = 0;
+  number[len] = '\0';
+  return len;
+}
+
+
+int rdlongnumber(FILE* gmvin, long* value)
+{
+  /*  Read an integer, returns 0 if the next token is not an integer.  */
+  char number[MAXNUMBERLENGTH], *end;
+  int len;
+  long val;
+
+  len = rdnumber(gmvin, number);
+  if (len == 0) return 0;
+  val = strtol(number, &end, 10);
+  if (end != number + len) return 0;
+  *value = val;
+  return 1;
+}
+
+
+int rddoublenumber(FILE* gmvin, double* value)
+{
+  /*  Read a real, returns 0 if the next token is not a number.  */
+  char number[MAXNUMBERLENGTH], *end;
+  int len;
+  double val;
+
+  len = rdnumber(gmvin, number);
+  if (len == 0) return 0;
+  val = strtod(number, &end);
+  if (end != number + len) return 0;
+  *value = val;
+  return 1;
+}
+
+
 void rdints(int iarray[], int nvals, FILE* gmvin)
 {
   /*                                                  */
   /*  Read an integer array from an ASCII text file.  */
   /*                                                  */
   int i, j, ret_stat;
+  long lval;
 
   for (i = 0; i < nvals; i++)
     {
-      ret_stat = fscanf(gmvin,"%d",&iarray[i]);
+      ret_stat = rdlongnumber(gmvin, &lval);
+      if (ret_stat) iarray[i] = (int)lval;
 
       /* File ends abruptly or could not be read from anymore? */
       if (feof(gmvin) != 0)
@@ -1089,7 +1166,7 @@ void rdlongs(long iarray[], long nvals, FILE* gmvin)
 
   for (i = 0; i < nvals; i++)
     {
-      ret_stat = fscanf(gmvin,"%ld",&iarray[i]);
+      ret_stat = rdlongnumber(gmvin, &iarray[i]);
 
       /* File ends abruptly or could not be read from anymore? */
       if (feof(gmvin) != 0)
@@ -1139,7 +1216,7 @@ void rdfloats(double farray[], long nvals, FILE* gmvin)
 
   for (i = 0; i < nvals; i++)
     {
-      ret_stat = fscanf(gmvin,"%lf",&farray[i]);
+      ret_stat = rddoublenumber(gmvin, &farray[i]);
 
       /* File ends abruptly or could not be read from anymore? */
       if (feof(gmvin) != 0)
@@ -2494,7 +2571,7 @@ void readxfaces(FILE* gmvin, int ftype)
 {
   int i, j, *tmpftvin;
   long *nxvertsin, *vertsin, totverts;
-  static int xfaceloc;
+  static GMV_THREAD_LOCAL int xfaceloc;
 
 
    if (readkeyword == 1)
@@ -5251,11 +5328,11 @@ int chk_gmvend(FILE *fin)
 }
 
 
-long *celltoface, *cell_faces, cellfaces_alloc, totfaces,
+static GMV_THREAD_LOCAL long *celltoface, *cell_faces, cellfaces_alloc, totfaces,
      *facetoverts, facetoverts_alloc, nfacesin,
      *faceverts, faceverts_alloc, nvertsin,
      *cellnnode, *cellnodes, cellnodes_alloc, totcellnodes;
-static short vfacetype;
+static GMV_THREAD_LOCAL short vfacetype;
 
 
 void rdcells(int nodetype_in);
@@ -5434,7 +5511,7 @@ void structmesh();
 
 void rdcells(int nodetype_in)
 {
-  static long icell;
+  static GMV_THREAD_LOCAL long icell;
   int i, nfa, nna;
   long nc;
 
@@ -5578,7 +5655,7 @@ void gencell(long icell, long nc)
   /*                                */
   int totverts, nfaces; 
   long i, j, k, nverts[MAXVERTS];
-  static long sumverts = 0, gcellcount = 0;
+  static GMV_THREAD_LOCAL long sumverts = 0, gcellcount = 0;
 
    /*  Save first face location for cell to faces pointer.  */
    celltoface[icell] = nfacesin;
@@ -6052,7 +6129,7 @@ void fillcellinfo(long nc, long *facecell1, long *facecell2);
 
 void rdfaces()
 {
-  static long iface, *facecell1, *facecell2;
+  static GMV_THREAD_LOCAL long iface, *facecell1, *facecell2;
   long nc, i, k;
   int nverts;
 
@@ -6121,8 +6198,8 @@ void rdfaces()
 
 void rdvfaces(long nc)
 {
-  static long iface, *facecell1, *facecell2;
-  static long *facepe, *oppface, *oppfacepe;
+  static GMV_THREAD_LOCAL long iface, *facecell1, *facecell2;
+  static GMV_THREAD_LOCAL long *facepe, *oppface, *oppfacepe;
   long i, k;
   int nverts;
 
@@ -6227,8 +6304,8 @@ void rdvfaces(long nc)
 
 void rdxfaces()
 {
-  static long *facecell1, *facecell2;
-  static long *facepe, *oppface, *oppfacepe;
+  static GMV_THREAD_LOCAL long *facecell1, *facecell2;
+  static GMV_THREAD_LOCAL long *facepe, *oppface, *oppfacepe;
   long nc, i, k, totverts;
   int maxnvert;
 
@@ -6923,14 +7000,14 @@ fgmvread_mesh_(long *nnodes, long *ncells, long *nfaces,
 
 
 /*  Code for gmv ray reader.  */
-static long numrays;
+static GMV_THREAD_LOCAL long numrays;
 
 void swapbytes(void *from, int size, int nitems),
      readray(FILE *gmvrayin, int ftype),
      readrayids(FILE *gmvrayin, int ftype),
      gmvrayrdmemerr(),  endfromfile();
 int ioerrtst2(FILE *gmvrayin);
-static FILE *gmvrayinGlobal;
+static GMV_THREAD_LOCAL FILE *gmvrayinGlobal;
 
 void readrays(FILE* gmvrayin, int ftype);
 void readrayids(FILE* gmvrayin, int ftype);
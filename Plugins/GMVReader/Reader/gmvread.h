@@ -7,6 +7,19 @@
 #define EXTERN /**/
 #endif
 
+/*  The reader state is kept per thread, so that files can be read     */
+/*  concurrently from different threads.  Each thread must open, read  */
+/*  and close a file before reading another one.                       */
+#ifndef GMV_THREAD_LOCAL
+#if defined(__cplusplus)
+#define GMV_THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define GMV_THREAD_LOCAL _Thread_local
+#else
+#define GMV_THREAD_LOCAL /**/
+#endif
+#endif
+
 /*  Keyword types.  */
 #define NODES       1
 #define CELLS       2
@@ -76,7 +89,7 @@
 #define MAXCUSTOMNAMELENGTH   33
 #define MAXFILENAMELENGTH    300
 
-EXTERN struct gmv_data_type
+EXTERN GMV_THREAD_LOCAL struct gmv_data_type
          {
           int     keyword;    /*  See above for definitions.  */
           int     datatype;   /*  See above for definitions.  */
@@ -106,7 +119,7 @@ EXTERN struct gmv_data_type
      gmv_data;
 
 
-EXTERN struct gmv_meshdata_type
+EXTERN GMV_THREAD_LOCAL struct gmv_meshdata_type
          {
           long    nnodes; 
           long    ncells;
@@ -41,6 +41,7 @@
 #include "vtkUnstructuredGrid.h"
 #include "vtkVertex.h"
 #include <algorithm>
+#include <cctype> // needed by gmvread.c
 #include <set>
 #include <vtksys/SystemTools.hxx>
 
@@ -42,7 +42,8 @@ static const int NO_COMPRESSION = 0;
 static const int LZ4_COMPRESSION = 1;
 static const int SQUIRT_COMPRESSION = 2;
 static const int ZLIB_COMPRESSION = 3;
-static const int NVPIPE_COMPRESSION = 4;
+static const int DELTA_COMPRESSION = 4;
+static const int NVPIPE_COMPRESSION = 5;
 //-----------------------------------------------------------------------------
 
 class pqImageCompressorWidget::pqInternals
@@ -78,6 +79,9 @@ pqImageCompressorWidget::pqImageCompressorWidget(
   this->connect(ui.zlibColorSpace, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibLevel, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibStripAlpha, SIGNAL(stateChanged(int)), SIGNAL(compressorConfigChanged()));
+  this->connect(ui.deltaTileSize, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
+  this->connect(
+    ui.deltaKeyFrameInterval, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
 
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
   ui.compressionType->addItem("NvPipe");
@@ -122,6 +126,16 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
                     "\\s+"     // space
                     "([0-9]+)" // num-of-bits.
                     "$");
+  QRegExp deltaRegExp("^vtkDeltaImageCompressor"
+                      "\\s+"
+                      "0"
+                      "\\s+"
+                      "([0-9]+)" // num-of-bits
+                      "\\s+"
+                      "([0-9]+)" // tile size
+                      "\\s+"
+                      "([0-9]+)" // key frame interval
+                      "$");
   QRegExp nvpipeRegExp("^vtkNvPipeCompressor"
                        "\\s+"     // space
                        "0"        // 0
@@ -151,6 +165,16 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
     ui.zlibColorSpace->setValue(numBits);
     ui.zlibStripAlpha->setCheckState(stripAlpha ? Qt::Checked : Qt::Unchecked);
   }
+  else if (deltaRegExp.exactMatch(value))
+  {
+    int numBits = deltaRegExp.cap(1).toInt();
+    int tileSize = deltaRegExp.cap(2).toInt();
+    int keyFrameInterval = deltaRegExp.cap(3).toInt();
+    ui.compressionType->setCurrentIndex(DELTA_COMPRESSION);
+    ui.squirtColorSpace->setValue(numBits);
+    ui.deltaTileSize->setValue(tileSize);
+    ui.deltaKeyFrameInterval->setValue(keyFrameInterval);
+  }
   else if (nvpipeRegExp.exactMatch(value))
   {
     int level = nvpipeRegExp.cap(1).toInt();
@@ -181,6 +205,12 @@ QString pqImageCompressorWidget::compressorConfig() const
         .arg(ui.zlibColorSpace->value())
         .arg(ui.zlibStripAlpha->isChecked() ? 1 : 0);
 
+    case DELTA_COMPRESSION: // delta
+      return QString("vtkDeltaImageCompressor 0 %1 %2 %3")
+        .arg(ui.squirtColorSpace->value())
+        .arg(ui.deltaTileSize->value())
+        .arg(ui.deltaKeyFrameInterval->value());
+
     case NVPIPE_COMPRESSION: // nvpipe
       return QString("vtkNvPipeCompressor 0 %1").arg(ui.nvpLevel->value());
   }
@@ -192,8 +222,10 @@ QString pqImageCompressorWidget::compressorConfig() const
 void pqImageCompressorWidget::currentIndexChanged(int index)
 {
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
-  ui.squirtLabel->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
-  ui.squirtColorSpace->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
+  const bool useColorSpace =
+    index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION || index == DELTA_COMPRESSION;
+  ui.squirtLabel->setVisible(useColorSpace);
+  ui.squirtColorSpace->setVisible(useColorSpace);
 
   ui.zlibLabel1->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibLabel2->setVisible(index == ZLIB_COMPRESSION);
@@ -201,6 +233,11 @@ void pqImageCompressorWidget::currentIndexChanged(int index)
   ui.zlibColorSpace->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibStripAlpha->setVisible(index == ZLIB_COMPRESSION);
 
+  ui.deltaLabel1->setVisible(index == DELTA_COMPRESSION);
+  ui.deltaLabel2->setVisible(index == DELTA_COMPRESSION);
+  ui.deltaTileSize->setVisible(index == DELTA_COMPRESSION);
+  ui.deltaKeyFrameInterval->setVisible(index == DELTA_COMPRESSION);
+
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
   ui.nvpLabel->setVisible(index == NVPIPE_COMPRESSION);
   ui.nvpLevel->setVisible(index == NVPIPE_COMPRESSION);
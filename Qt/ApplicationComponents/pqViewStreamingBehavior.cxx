@@ -33,14 +33,24 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "pqActiveObjects.h"
 #include "pqApplicationCore.h"
+#include "pqCoreUtilities.h"
+#include "pqDataRepresentation.h"
+#include "pqPipelineSource.h"
 #include "pqServer.h"
 #include "pqServerManagerModel.h"
 #include "pqView.h"
 #include "vtkCommand.h"
 #include "vtkPVView.h"
 #include "vtkRenderWindowInteractor.h"
+#include "vtkSMDataDeliveryManagerProxy.h"
 #include "vtkSMRenderViewProxy.h"
 #include "vtkSMSession.h"
+#include "vtkWeakPointer.h"
+
+#include <QMainWindow>
+#include <QStatusBar>
+#include <QStringList>
+#include <QTimer>
 
 // #define PV_DEBUG_STREAMING
 #include "vtkPVStreamingMacros.h"
@@ -54,6 +64,7 @@ pqViewStreamingBehavior::pqViewStreamingBehavior(QObject* parentObject)
   , Pass(0)
   , DelayUpdate(false)
   , DisableAutomaticUpdates(false)
+  , ShowingDeliveryProgress(false)
 {
   pqServerManagerModel* smmodel = pqApplicationCore::instance()->getServerManagerModel();
   QObject::connect(smmodel, SIGNAL(viewAdded(pqView*)), this, SLOT(onViewAdded(pqView*)));
@@ -80,6 +91,12 @@ void pqViewStreamingBehavior::onViewAdded(pqView* view)
   {
     rvProxy->AddObserver(
       vtkCommand::UpdateDataEvent, this, &pqViewStreamingBehavior::onViewUpdated);
+    rvProxy->AddObserver(vtkCommand::EndEvent, this, &pqViewStreamingBehavior::onViewRendered);
+    if (auto deliveryManager = rvProxy->GetDeliveryManager())
+    {
+      deliveryManager->AddObserver(
+        vtkCommand::ProgressEvent, this, &pqViewStreamingBehavior::onDeliveryProgress);
+    }
     rvProxy->GetInteractor()->AddObserver(
       vtkCommand::StartInteractionEvent, this, &pqViewStreamingBehavior::onStartInteractionEvent);
     rvProxy->GetInteractor()->AddObserver(
@@ -102,6 +119,85 @@ void pqViewStreamingBehavior::onViewUpdated(vtkObject* vtkNotUsed(caller), unsig
   }
 }
 
+//-----------------------------------------------------------------------------
+void pqViewStreamingBehavior::onViewRendered(vtkObject* caller, unsigned long, void* calldata)
+{
+  // with incremental geometry delivery, keep rendering until all geometry has
+  // been delivered. While interacting, the interaction renders deliver the
+  // remaining geometry; a still render would switch to full resolution
+  // geometry in the middle of the interaction.
+  vtkSMViewProxy* viewProxy = vtkSMViewProxy::SafeDownCast(caller);
+  if (!viewProxy || !viewProxy->HasPendingDeliveries() || this->DelayUpdate)
+  {
+    return;
+  }
+
+  const bool interactive = calldata && *reinterpret_cast<int*>(calldata) != 0;
+  if (interactive)
+  {
+    // re-issue the same kind of render, once this one is done.
+    vtkWeakPointer<vtkSMViewProxy> weakViewProxy(viewProxy);
+    QTimer::singleShot(0, this, [weakViewProxy]() {
+      if (weakViewProxy && weakViewProxy->HasPendingDeliveries())
+      {
+        weakViewProxy->InteractiveRender();
+      }
+    });
+  }
+  else
+  {
+    pqServerManagerModel* smmodel = pqApplicationCore::instance()->getServerManagerModel();
+    if (pqView* view = smmodel->findItem<pqView*>(viewProxy))
+    {
+      view->render();
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void pqViewStreamingBehavior::onDeliveryProgress(
+  vtkObject* caller, unsigned long, void* calldata)
+{
+  auto deliveryManager = vtkSMDataDeliveryManagerProxy::SafeDownCast(caller);
+  QMainWindow* mainWindow = qobject_cast<QMainWindow*>(pqCoreUtilities::mainWidget());
+  if (!deliveryManager || !mainWindow || !calldata)
+  {
+    return;
+  }
+
+  const double progress = *reinterpret_cast<double*>(calldata);
+  if (progress >= 1.0)
+  {
+    if (this->ShowingDeliveryProgress)
+    {
+      mainWindow->statusBar()->clearMessage();
+      this->ShowingDeliveryProgress = false;
+    }
+    return;
+  }
+
+  // list the representations still rendering previously delivered geometry.
+  QStringList pending;
+  pqServerManagerModel* smmodel = pqApplicationCore::instance()->getServerManagerModel();
+  if (pqView* view = smmodel->findItem<pqView*>(deliveryManager->GetViewProxy()))
+  {
+    foreach (pqRepresentation* repr, view->getRepresentations())
+    {
+      auto dataRepr = qobject_cast<pqDataRepresentation*>(repr);
+      if (dataRepr && dataRepr->isVisible() && dataRepr->getInput() &&
+        deliveryManager->GetDeliveryProgress(dataRepr->getProxy()) < 1.0)
+      {
+        pending << dataRepr->getInput()->getSMName();
+      }
+    }
+  }
+
+  mainWindow->statusBar()->showMessage(tr("Delivering geometry (%1%): %2")
+                                         .arg(static_cast<int>(100 * progress))
+                                         .arg(pending.join(", ")));
+  this->ShowingDeliveryProgress = true;
+}
+
 //-----------------------------------------------------------------------------
 void pqViewStreamingBehavior::onStartInteractionEvent()
 {
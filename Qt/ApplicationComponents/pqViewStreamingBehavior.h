@@ -50,6 +50,11 @@ class vtkObject;
 * there is no more data to be streamed. The periodic updates resume after the
 * next time the view updates since the view now may have newer data that needs
 * to be streamed.
+*
+* pqViewStreamingBehavior also requests renders on views that have geometry
+* left to deliver when incremental geometry delivery is enabled, until all the
+* geometry has been delivered, and reports the delivery progress, with the
+* representations still waiting for their geometry, in the status bar.
 */
 class PQAPPLICATIONCOMPONENTS_EXPORT pqViewStreamingBehavior : public QObject
 {
@@ -71,6 +76,8 @@ public:
 protected Q_SLOTS:
   void onViewAdded(pqView*);
   void onViewUpdated(vtkObject*, unsigned long, void*);
+  void onViewRendered(vtkObject*, unsigned long, void*);
+  void onDeliveryProgress(vtkObject*, unsigned long, void*);
   void onTimeout();
 
 private:
@@ -79,6 +86,7 @@ private:
   int Pass;
   bool DelayUpdate;
   bool DisableAutomaticUpdates;
+  bool ShowingDeliveryProgress;
 
   void onStartInteractionEvent();
   void onEndInteractionEvent();
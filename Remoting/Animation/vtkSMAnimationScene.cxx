@@ -48,6 +48,19 @@ bool vtkSMAnimationScene::GetGlobalUseGeometryCache()
   return vtkSMAnimationScene::GlobalUseGeometryCache;
 }
 
+unsigned long vtkSMAnimationScene::GlobalGeometryCacheLimit = 0;
+//----------------------------------------------------------------------------
+void vtkSMAnimationScene::SetGlobalGeometryCacheLimit(unsigned long val)
+{
+  vtkSMAnimationScene::GlobalGeometryCacheLimit = val;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkSMAnimationScene::GetGlobalGeometryCacheLimit()
+{
+  return vtkSMAnimationScene::GlobalGeometryCacheLimit;
+}
+
 //----------------------------------------------------------------------------
 class vtkSMAnimationScene::vtkInternals
 {
@@ -120,6 +133,34 @@ public:
       iter->GetPointer()->UpdateProperty("UseCache");
     }
   }
+
+  // Pushes the global geometry cache limit to the view if it differs from the
+  // one it uses, so that changes to the limit apply to views already in the
+  // scene and not only when caching is turned on.
+  void PassCacheSizeLimit(vtkSMViewProxy* view)
+  {
+    if (view->GetProperty("CacheSizeLimit") == nullptr)
+    {
+      return;
+    }
+    const int limit = static_cast<int>(
+      std::min<unsigned long>(vtkSMAnimationScene::GetGlobalGeometryCacheLimit(), VTK_INT_MAX));
+    vtkSMPropertyHelper helper(view, "CacheSizeLimit");
+    if (helper.GetAsInt() != limit)
+    {
+      helper.Set(limit);
+      view->UpdateProperty("CacheSizeLimit");
+    }
+  }
+
+  void PassCacheSizeLimit()
+  {
+    for (VectorOfViews::iterator iter = this->ViewModules.begin(); iter != this->ViewModules.end();
+         ++iter)
+    {
+      this->PassCacheSizeLimit(iter->GetPointer());
+    }
+  }
 };
 
 namespace
@@ -384,6 +425,7 @@ void vtkSMAnimationScene::AddViewProxy(vtkSMViewProxy* view)
     }
   }
   this->Internals->ViewModules.push_back(view);
+  this->Internals->PassCacheSizeLimit(view);
 }
 
 //----------------------------------------------------------------------------
@@ -462,6 +504,7 @@ void vtkSMAnimationScene::TickInternal(double currenttime, double deltatime, dou
   // all.
   bool caching_enabled =
     (!this->ForceDisableCaching) && vtkSMAnimationScene::GlobalUseGeometryCache;
+  this->Internals->PassCacheSizeLimit();
   if (caching_enabled)
   {
     this->Internals->PassUseCache(true);
@@ -200,6 +200,18 @@ public:
   static bool GetGlobalUseGeometryCache();
   //@}
 
+  //@{
+  /**
+   * Set the limit, in kibibytes, for the geometry cached by each view on any
+   * rank when caching is enabled. 0 implies no limit. The limit is passed on
+   * to the views when they are added to a scene and on every tick afterwards.
+   * Typically, one uses vtkPVGeneralSettings to set this rather than using
+   * this API directly.
+   */
+  static void SetGlobalGeometryCacheLimit(unsigned long);
+  static unsigned long GetGlobalGeometryCacheLimit();
+  //@}
+
 protected:
   vtkSMAnimationScene();
   ~vtkSMAnimationScene() override;
@@ -244,6 +256,7 @@ private:
   unsigned long TimestepValuesObserverID;
 
   static bool GlobalUseGeometryCache;
+  static unsigned long GlobalGeometryCacheLimit;
 };
 
 #endif
@@ -39,7 +39,14 @@
 #include "vtkSMViewLayoutProxy.h"
 #include "vtkSMViewProxy.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace vtkSMSaveAnimationProxyNS
@@ -62,6 +69,129 @@ public:
   }
 };
 
+/**
+ * Bounded queue of captured frames written by a pool of encoder threads. Frames
+ * are written as soon as an encoder is available, hence possibly out of order,
+ * so each frame carries its index in the sequence. Pushing a frame blocks while
+ * the queue is full, which keeps rendering from getting too far ahead of the
+ * encoders.
+ */
+class FrameEncoderQueue
+{
+public:
+  struct Frame
+  {
+    int Index;
+    double Time;
+    vtkSmartPointer<vtkImageData> Left;
+    vtkSmartPointer<vtkImageData> Right;
+  };
+  using EncodeFunction = std::function<bool(int encoder, const Frame& frame)>;
+
+  FrameEncoderQueue() = default;
+  ~FrameEncoderQueue() { this->Finish(); }
+
+  /**
+   * Starts `numberOfEncoders` threads calling `encode` for each frame pushed.
+   */
+  void Start(int numberOfEncoders, size_t maxNumberOfFrames, EncodeFunction encode)
+  {
+    this->Finish();
+    this->Encode = encode;
+    this->MaxNumberOfFrames = std::max<size_t>(maxNumberOfFrames, 1);
+    this->Done = false;
+    this->Success = true;
+    for (int cc = 0; cc < numberOfEncoders; ++cc)
+    {
+      this->Encoders.emplace_back(&FrameEncoderQueue::Run, this, cc);
+    }
+  }
+
+  bool IsRunning() const { return !this->Encoders.empty(); }
+
+  /**
+   * Queues a frame, waiting for room in the queue if needed. Returns false if
+   * writing a previous frame failed.
+   */
+  bool Push(Frame&& frame)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->NotFull.wait(lock, [this]() {
+      return this->Frames.size() < this->MaxNumberOfFrames || !this->Success;
+    });
+    if (!this->Success)
+    {
+      return false;
+    }
+    this->Frames.push_back(std::move(frame));
+    this->NotEmpty.notify_one();
+    return true;
+  }
+
+  /**
+   * Waits for all queued frames to be written and stops the encoder threads.
+   * Returns false if writing any frame failed.
+   */
+  bool Finish()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Done = true;
+    }
+    this->NotEmpty.notify_all();
+    for (auto& encoder : this->Encoders)
+    {
+      encoder.join();
+    }
+    this->Encoders.clear();
+    this->Frames.clear();
+    return this->Success;
+  }
+
+private:
+  FrameEncoderQueue(const FrameEncoderQueue&) = delete;
+  void operator=(const FrameEncoderQueue&) = delete;
+
+  void Run(int encoder)
+  {
+    while (true)
+    {
+      Frame frame;
+      bool skip;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->NotEmpty.wait(lock, [this]() { return !this->Frames.empty() || this->Done; });
+        if (this->Frames.empty())
+        {
+          return;
+        }
+        frame = std::move(this->Frames.front());
+        this->Frames.pop_front();
+        // once a frame failed, remaining frames are dropped.
+        skip = !this->Success;
+      }
+      this->NotFull.notify_one();
+
+      if (!skip && !this->Encode(encoder, frame))
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Success = false;
+        this->NotFull.notify_all();
+      }
+    }
+  }
+
+  EncodeFunction Encode;
+  size_t MaxNumberOfFrames = 1;
+  bool Done = true;
+  bool Success = true;
+  std::deque<Frame> Frames;
+  std::vector<std::thread> Encoders;
+  std::mutex Mutex;
+  std::condition_variable NotEmpty;
+  std::condition_variable NotFull;
+};
+
 template <class T>
 class SceneImageWriter : public vtkSMAnimationSceneWriter
 {
@@ -74,8 +204,18 @@ public:
    */
   void SetHelper(vtkSMSaveAnimationProxy* helper) { this->Helper = helper; }
 
+  /**
+   * Set the number of threads writing frames while the next frames are being
+   * rendered. 0 means frames are written as soon as they are captured.
+   */
+  void SetNumberOfEncoderThreads(int count) { this->NumberOfEncoderThreads = count; }
+
 protected:
-  SceneImageWriter() {}
+  SceneImageWriter()
+    : NumberOfEncoderThreads(0)
+    , FrameIndex(0)
+  {
+  }
   ~SceneImageWriter() {}
   bool SaveInitialize(int vtkNotUsed(startCount)) override
   {
@@ -83,6 +223,19 @@ protected:
     // since it's a waste of rendering, the code to save the images will call
     // render anyways.
     this->AnimationScene->SetOverrideStillRender(1);
+
+    this->FrameIndex = 0;
+    const int numberOfEncoders =
+      std::min(this->NumberOfEncoderThreads, this->GetMaximumNumberOfEncoders());
+    if (numberOfEncoders > 0)
+    {
+      // Keep a couple of frames per encoder to absorb variations in render
+      // and encode times.
+      this->Queue.Start(numberOfEncoders, 2 * static_cast<size_t>(numberOfEncoders),
+        [this](int encoder, const FrameEncoderQueue::Frame& frame) {
+          return this->WriteFrameImage(encoder, frame.Index, frame.Time, frame.Left, frame.Right);
+        });
+    }
     return true;
   }
 
@@ -101,16 +254,38 @@ protected:
       return true;
     }
 
-    return this->WriteFrameImage(time, image_pair.first, image_pair.second);
+    const int index = this->FrameIndex++;
+    if (this->Queue.IsRunning())
+    {
+      return this->Queue.Push({ index, time, image_pair.first, image_pair.second });
+    }
+    return this->WriteFrameImage(0, index, time, image_pair.first, image_pair.second);
   }
 
   bool SaveFinalize() override
   {
+    bool status = this->FlushFrames();
     this->AnimationScene->SetOverrideStillRender(0);
-    return true;
+    return status;
   }
 
-  virtual bool WriteFrameImage(double time, vtkImageData* dataLeft, vtkImageData* dataRight) = 0;
+  /**
+   * Waits for all captured frames to be written. Returns false if writing any
+   * of them failed.
+   */
+  bool FlushFrames() { return this->Queue.Finish(); }
+
+  /**
+   * Returns the maximum number of frames that can be written concurrently.
+   */
+  virtual int GetMaximumNumberOfEncoders() = 0;
+
+  /**
+   * Writes the `index`-th frame of the sequence. When using encoder threads,
+   * this is called on the `encoder`-th thread, possibly out of order.
+   */
+  virtual bool WriteFrameImage(
+    int encoder, int index, double time, vtkImageData* dataLeft, vtkImageData* dataRight) = 0;
 
   std::string GetStereoFileName(const std::string& filename, bool left)
   {
@@ -120,6 +295,9 @@ protected:
 private:
   SceneImageWriter(const SceneImageWriter&) = delete;
   void operator=(const SceneImageWriter&) = delete;
+  int NumberOfEncoderThreads;
+  int FrameIndex;
+  FrameEncoderQueue Queue;
 };
 
 class SceneImageWriterMovie : public SceneImageWriter<vtkGenericMovieWriter>
@@ -157,8 +335,11 @@ protected:
     return this->Superclass::SaveInitialize(startCount);
   }
 
-  bool WriteFrameImage(
-    double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
+  // Movie frames must be encoded in order.
+  int GetMaximumNumberOfEncoders() override { return 1; }
+
+  bool WriteFrameImage(int vtkNotUsed(encoder), int vtkNotUsed(index), double vtkNotUsed(time),
+    vtkImageData* dataLeft, vtkImageData* dataRight) override
   {
     vtkImageData* data[] = { dataLeft, dataRight };
     bool status = true;
@@ -183,6 +364,8 @@ protected:
 
   bool SaveFinalize() override
   {
+    // all frames must be written before ending the movie.
+    bool status = this->FlushFrames();
     if (this->Started)
     {
       for (int cc = 0; cc < 2; ++cc)
@@ -194,7 +377,7 @@ protected:
       }
     }
     this->Started = false;
-    return this->Superclass::SaveFinalize();
+    return this->Superclass::SaveFinalize() && status;
   }
 
 private:
@@ -206,7 +389,7 @@ vtkStandardNewMacro(SceneImageWriterMovie);
 
 class SceneImageWriterImageSeries : public SceneImageWriter<vtkImageWriter>
 {
-  vtkImageWriter* Writer;
+  std::vector<vtkImageWriter*> Writers;
 
 public:
   static SceneImageWriterImageSeries* New();
@@ -221,11 +404,17 @@ public:
   /**
    * Set the writer to use.
    */
-  void SetWriter(vtkImageWriter* writer) { this->Writer = writer; }
+  void SetWriter(vtkImageWriter* writer) { this->Writers.assign(1, writer); }
+
+  /**
+   * Add a writer, configured identically to the one passed to `SetWriter`, to
+   * let another encoder thread write frames concurrently.
+   */
+  void AddWriter(vtkImageWriter* writer) { this->Writers.push_back(writer); }
 
 protected:
   SceneImageWriterImageSeries()
-    : Counter(0)
+    : StartCount(0)
     , SuffixFormat(nullptr)
   {
   }
@@ -233,7 +422,7 @@ protected:
 
   bool SaveInitialize(int startCount) override
   {
-    this->Counter = startCount;
+    this->StartCount = startCount;
     auto path = vtksys::SystemTools::GetFilenamePath(this->FileName);
     auto prefix = vtksys::SystemTools::GetFilenameWithoutLastExtension(this->FileName);
     this->Prefix = path.empty() ? prefix : path + "/" + prefix;
@@ -241,18 +430,21 @@ protected:
     return this->Superclass::SaveInitialize(startCount);
   }
 
-  bool WriteFrameImage(
-    double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
+  // Each writer can write a different frame at the same time.
+  int GetMaximumNumberOfEncoders() override { return static_cast<int>(this->Writers.size()); }
+
+  bool WriteFrameImage(int encoder, int index, double vtkNotUsed(time), vtkImageData* dataLeft,
+    vtkImageData* dataRight) override
   {
     bool success = true;
 
-    auto writer = this->Writer;
+    auto writer = this->Writers[encoder];
     assert(dataLeft);
     assert(this->SuffixFormat);
     assert(writer);
 
     char buffer[1024];
-    snprintf(buffer, 1024, this->SuffixFormat, this->Counter);
+    snprintf(buffer, 1024, this->SuffixFormat, this->StartCount + index);
 
     std::ostringstream str;
     str << this->Prefix << buffer << this->Extension;
@@ -274,14 +466,13 @@ protected:
     writer->SetInputData(nullptr);
 
     success &= writer->GetErrorCode() == vtkErrorCode::NoError;
-    this->Counter += success ? 1 : 0;
     return success;
   }
 
 private:
   SceneImageWriterImageSeries(const SceneImageWriterImageSeries&) = delete;
   void operator=(const SceneImageWriterImageSeries&) = delete;
-  int Counter;
+  int StartCount;
   char* SuffixFormat;
   std::string Prefix;
   std::string Extension;
@@ -389,6 +580,21 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
   // check if we're writing 2-stereo video streams at the same time.
   vtkSmartPointer<vtkSMProxy> otherFormatProxy;
 
+  // additional format proxies for the threads writing images concurrently.
+  std::vector<vtkSmartPointer<vtkSMProxy> > encoderFormatProxies;
+  const int numberOfEncoderThreads =
+    vtkSMPropertyHelper(this, "NumberOfEncoderThreads", /*quiet=*/true).GetAsInt();
+
+  auto cloneFormatProxy = [this, formatProxy]() {
+    auto pxm = this->GetSessionProxyManager();
+    vtkSmartPointer<vtkSMProxy> clone;
+    clone.TakeReference(pxm->NewProxy(formatProxy->GetXMLGroup(), formatProxy->GetXMLName()));
+    clone->SetLocation(formatProxy->GetLocation());
+    clone->Copy(formatProxy);
+    clone->UpdateVTKObjects();
+    return clone;
+  };
+
   // based on the format, we create an appropriate SceneImageWriter.
   auto formatObj = formatProxy->GetClientSideObject();
   if (auto imgWriter = vtkImageWriter::SafeDownCast(formatObj))
@@ -397,6 +603,18 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
     realWriter->SetSuffixFormat(vtkSMPropertyHelper(formatProxy, "SuffixFormat").GetAsString());
     realWriter->SetHelper(this);
     realWriter->SetWriter(imgWriter);
+
+    // image writers are not thread safe, so each encoder thread gets its own.
+    for (int cc = 1; cc < numberOfEncoderThreads; ++cc)
+    {
+      auto clone = cloneFormatProxy();
+      if (auto cloneWriter = vtkImageWriter::SafeDownCast(clone->GetClientSideObject()))
+      {
+        realWriter->AddWriter(cloneWriter);
+        encoderFormatProxies.push_back(clone);
+      }
+    }
+    realWriter->SetNumberOfEncoderThreads(numberOfEncoderThreads);
     writer = realWriter;
   }
   else if (auto movieWriter = vtkGenericMovieWriter::SafeDownCast(formatObj))
@@ -408,15 +626,11 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
     // we need two movie writers when writing stereo videos
     if (vtkSMPropertyHelper(this, "StereoMode").GetAsInt() == VTK_STEREO_EMULATE)
     {
-      auto pxm = this->GetSessionProxyManager();
-      otherFormatProxy.TakeReference(
-        pxm->NewProxy(formatProxy->GetXMLGroup(), formatProxy->GetXMLName()));
-      otherFormatProxy->SetLocation(formatProxy->GetLocation());
-      otherFormatProxy->Copy(formatProxy);
-      otherFormatProxy->UpdateVTKObjects();
+      otherFormatProxy = cloneFormatProxy();
       realWriter->SetWriter(
         1, vtkGenericMovieWriter::SafeDownCast(otherFormatProxy->GetClientSideObject()));
     }
+    realWriter->SetNumberOfEncoderThreads(numberOfEncoderThreads);
     writer = realWriter;
   }
   else
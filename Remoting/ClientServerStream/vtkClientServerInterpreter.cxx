@@ -84,6 +84,8 @@ vtkClientServerInterpreter::vtkClientServerInterpreter()
   this->NextAvailableId = 0;
   this->Internal = new vtkClientServerInterpreterInternals;
   this->LastResultMessage = new vtkClientServerStream(this);
+  this->InvokedMethod = nullptr;
+  this->InvokedMethodHash = 0;
   this->LogStream = 0;
   this->LogFileStream = 0;
 }
@@ -421,8 +423,17 @@ int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream
     // Find the command function for this object's type.
     if (obj && this->HasCommandFunction(obj->GetClassName()))
     {
-      if (this->CallCommandFunction(
-            obj->GetClassName(), obj, method, msg, *this->LastResultMessage))
+      // Hash the method name once for all the levels of the class hierarchy.
+      // The previous method is restored for nested invocations.
+      const char* invokedMethod = this->InvokedMethod;
+      const unsigned int invokedMethodHash = this->InvokedMethodHash;
+      this->InvokedMethod = method;
+      this->InvokedMethodHash = HashMethodName(method);
+      const int called =
+        this->CallCommandFunction(obj->GetClassName(), obj, method, msg, *this->LastResultMessage);
+      this->InvokedMethod = invokedMethod;
+      this->InvokedMethodHash = invokedMethodHash;
+      if (called)
       {
         return 1;
       }
@@ -149,6 +149,31 @@ public:
   int CallCommandFunction(const char* classname, vtkObjectBase* ptr, const char* method,
     const vtkClientServerStream& msg, vtkClientServerStream& result);
 
+  /**
+   * Returns the FNV-1a hash of a method name, which must match the hash
+   * computed by vtkWrapClientServer when generating the wrappers.
+   */
+  static unsigned int HashMethodName(const char* name)
+  {
+    unsigned int hash = 2166136261u;
+    for (; *name; ++name)
+    {
+      hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+    }
+    return hash;
+  }
+
+  /**
+   * Called by generated code to dispatch on the method name. Returns the hash
+   * of the method being invoked, computed once by ProcessCommandInvoke and
+   * shared by the command functions of all the superclasses, or computes it
+   * if `method` is not the method being invoked. Do not call directly.
+   */
+  unsigned int GetMethodHash(const char* method) const
+  {
+    return method == this->InvokedMethod ? this->InvokedMethodHash : HashMethodName(method);
+  }
+
   /**
    * Add a function used to create new objects.
    */
@@ -216,6 +241,10 @@ private:
   // Message containing the result of the last command.
   vtkClientServerStream* LastResultMessage;
 
+  // Method being invoked by ProcessCommandInvoke, and its hash.
+  const char* InvokedMethod;
+  unsigned int InvokedMethodHash;
+
   // Internal implementation details.
   vtkClientServerInterpreterInternals* Internal;
 
@@ -17,8 +17,10 @@
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommunicator.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
+#include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVDataInformation.h"
@@ -26,9 +28,181 @@
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <utility>
 #include <vector>
 
+namespace
+{
+// Serialized information gathered in this process, indexed by entry key. The
+// least recently used entries are dropped when the index exceeds MaximumSize
+// bytes; they can still be found in the sidecar files, if enabled.
+class vtkMemoryIndex
+{
+public:
+  static const size_t MaximumSize = 16 * 1024 * 1024;
+
+  const std::vector<unsigned char>* Find(const std::string& entryKey)
+  {
+    auto iter = this->Entries.find(entryKey);
+    if (iter == this->Entries.end())
+    {
+      return nullptr;
+    }
+    this->Order.splice(this->Order.begin(), this->Order, iter->second.second);
+    return &iter->second.first;
+  }
+
+  void Insert(const std::string& entryKey, std::vector<unsigned char> data)
+  {
+    this->Erase(entryKey);
+    this->Size += data.size();
+    this->Order.push_front(entryKey);
+    this->Entries[entryKey] = std::make_pair(std::move(data), this->Order.begin());
+    // always keep the entry just inserted.
+    while (this->Size > MaximumSize && this->Order.size() > 1)
+    {
+      this->Erase(this->Order.back());
+    }
+  }
+
+  void Erase(const std::string& entryKey)
+  {
+    auto iter = this->Entries.find(entryKey);
+    if (iter != this->Entries.end())
+    {
+      this->Size -= iter->second.first.size();
+      this->Order.erase(iter->second.second);
+      this->Entries.erase(iter);
+    }
+  }
+
+private:
+  // Most recently used first.
+  std::list<std::string> Order;
+  std::map<std::string,
+    std::pair<std::vector<unsigned char>, std::list<std::string>::iterator> >
+    Entries;
+  size_t Size = 0;
+};
+
+vtkMemoryIndex& GetMemoryIndex()
+{
+  static vtkMemoryIndex index;
+  return index;
+}
+
+// Returns the name of the sidecar file for the entry, or an empty string if
+// sidecar files are not enabled. The name is a FNV-1a hash of the key, which,
+// unlike std::hash, is stable across builds. The key itself is stored in the
+// file to detect collisions.
+std::string GetSidecarFileName(const std::string& entryKey)
+{
+  const char* dir = vtksys::SystemTools::GetEnv("PV_TEMPORAL_INDEX_DIRECTORY");
+  if (!dir || !*dir || !vtksys::SystemTools::FileIsDirectory(dir))
+  {
+    return std::string();
+  }
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  for (unsigned char c : entryKey)
+  {
+    hash = (hash ^ c) * 1099511628211ull;
+  }
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.pvtindex", static_cast<unsigned long long>(hash));
+  return std::string(dir) + "/" + name;
+}
+
+const char SidecarMagic[] = "pvtindex2";
+
+// Header of the serialized information stored in the index. Increment
+// IndexVersion whenever CopyToStream changes, so that entries written by
+// other versions are ignored.
+const char IndexName[] = "vtkPVTemporalDataInformation";
+const int IndexVersion = 1;
+
+// Files modified less than this many seconds ago are not indexed. Some file
+// systems only record modification times to the second, so a file rewritten
+// within the same second would otherwise keep its key.
+const double MinimumFileAge = 2.0;
+
+bool ReadSidecar(const std::string& entryKey, std::vector<unsigned char>& data)
+{
+  const std::string fname = GetSidecarFileName(entryKey);
+  if (fname.empty())
+  {
+    return false;
+  }
+  std::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+  std::string magic;
+  size_t keyLength = 0, dataLength = 0;
+  if (!(file >> magic >> keyLength >> dataLength) || magic != SidecarMagic ||
+    keyLength != entryKey.size() || file.get() != '\n')
+  {
+    return false;
+  }
+  std::string key(keyLength, '\0');
+  data.resize(dataLength);
+  if (!file.read(&key[0], keyLength) || key != entryKey ||
+    !file.read(reinterpret_cast<char*>(data.data()), dataLength))
+  {
+    data.clear();
+    return false;
+  }
+  return true;
+}
+
+void WriteSidecar(const std::string& entryKey, const unsigned char* data, size_t length)
+{
+  const std::string fname = GetSidecarFileName(entryKey);
+  if (fname.empty())
+  {
+    return;
+  }
+  // Write to a temporary file first so that readers never see partial files.
+  const std::string tmpName = fname + ".tmp";
+  {
+    std::ofstream file(tmpName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    file << SidecarMagic << " " << entryKey.size() << " " << length << "\n";
+    file.write(entryKey.data(), entryKey.size());
+    file.write(reinterpret_cast<const char*>(data), length);
+    if (!file)
+    {
+      file.close();
+      vtksys::SystemTools::RemoveFile(tmpName);
+      return;
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tmpName.c_str(), fname.c_str()))
+  {
+    vtksys::SystemTools::RemoveFile(tmpName);
+  }
+}
+}
+
 vtkStandardNewMacro(vtkPVTemporalDataInformation);
+bool vtkPVTemporalDataInformation::UseIndex = true;
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::SetUseIndex(bool val)
+{
+  vtkPVTemporalDataInformation::UseIndex = val;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalDataInformation::GetUseIndex()
+{
+  return vtkPVTemporalDataInformation::UseIndex;
+}
+
 //----------------------------------------------------------------------------
 vtkPVTemporalDataInformation::vtkPVTemporalDataInformation()
 {
@@ -36,6 +210,7 @@ vtkPVTemporalDataInformation::vtkPVTemporalDataInformation()
   this->TimeRange[0] = VTK_DOUBLE_MAX;
   this->TimeRange[1] = -VTK_DOUBLE_MAX;
   this->PortNumber = 0;
+  this->IndexKey = nullptr;
 
   this->PointDataInformation = vtkPVDataSetAttributesInformation::New();
   this->CellDataInformation = vtkPVDataSetAttributesInformation::New();
@@ -70,6 +245,7 @@ vtkPVTemporalDataInformation::~vtkPVTemporalDataInformation()
   this->EdgeDataInformation = NULL;
   this->RowDataInformation->Delete();
   this->RowDataInformation = NULL;
+  this->SetIndexKey(nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -113,23 +289,147 @@ void vtkPVTemporalDataInformation::Initialize()
   this->RowDataInformation->Initialize();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::AddIndexFileName(const char* fname)
+{
+  if (fname && *fname)
+  {
+    this->IndexFileNames.push_back(fname);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::RemoveAllIndexFileNames()
+{
+  this->IndexFileNames.clear();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
-  str << 829993 << this->PortNumber;
+  str << 829993 << this->PortNumber << std::string(this->IndexKey ? this->IndexKey : "")
+      << static_cast<unsigned int>(this->IndexFileNames.size());
+  for (const auto& fname : this->IndexFileNames)
+  {
+    str << fname;
+  }
 }
 
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
   int magic_number;
-  str >> magic_number >> this->PortNumber;
+  std::string key;
+  unsigned int numberOfFiles;
+  str >> magic_number >> this->PortNumber >> key >> numberOfFiles;
   if (magic_number != 829993)
   {
     vtkErrorMacro("Magic number mismatch.");
+    return;
+  }
+  this->SetIndexKey(key.c_str());
+  this->IndexFileNames.resize(numberOfFiles);
+  for (auto& fname : this->IndexFileNames)
+  {
+    str >> fname;
   }
 }
 
+//----------------------------------------------------------------------------
+std::string vtkPVTemporalDataInformation::GetIndexEntryKey(vtkAlgorithmOutput* port)
+{
+  if (!vtkPVTemporalDataInformation::UseIndex || !this->IndexKey || !*this->IndexKey ||
+    this->IndexFileNames.empty())
+  {
+    return std::string();
+  }
+
+  std::ostringstream key;
+  key << this->IndexKey << "\n"
+      << port->GetProducer()->GetClassName() << ":" << port->GetIndex();
+
+  // Each process gathers information about its own piece.
+  if (vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController())
+  {
+    key << "\n" << controller->GetLocalProcessId() << "/" << controller->GetNumberOfProcesses();
+  }
+
+  const time_t now = time(nullptr);
+  for (const auto& fname : this->IndexFileNames)
+  {
+    vtksys::SystemTools::Stat_t status;
+    if (vtksys::SystemTools::Stat(fname.c_str(), &status) != 0 ||
+      difftime(now, status.st_mtime) < MinimumFileAge)
+    {
+      return std::string();
+    }
+    key << "\n" << fname << ":" << status.st_mtime;
+#if defined(__linux__)
+    key << "." << status.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+    key << "." << status.st_mtimespec.tv_nsec;
+#endif
+    key << ":" << status.st_size;
+  }
+  return key.str();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalDataInformation::LoadFromIndex(const std::string& entryKey)
+{
+  auto& index = GetMemoryIndex();
+  const std::vector<unsigned char>* entry = index.Find(entryKey);
+  if (!entry)
+  {
+    std::vector<unsigned char> data;
+    if (!ReadSidecar(entryKey, data))
+    {
+      return false;
+    }
+    index.Insert(entryKey, std::move(data));
+    entry = index.Find(entryKey);
+  }
+
+  vtkClientServerStream css;
+  const char* name = nullptr;
+  int version = 0;
+  vtkTypeUInt32 length = 0;
+  std::vector<unsigned char> info;
+  if (!css.SetData(entry->data(), entry->size()) || css.GetNumberOfMessages() != 1 ||
+    css.GetNumberOfArguments(0) != 3 || !css.GetArgument(0, 0, &name) || !name ||
+    strcmp(name, IndexName) != 0 || !css.GetArgument(0, 1, &version) ||
+    version != IndexVersion || !css.GetArgumentLength(0, 2, &length) || length == 0)
+  {
+    index.Erase(entryKey);
+    return false;
+  }
+  info.resize(length);
+  css.GetArgument(0, 2, info.data(), length);
+
+  vtkClientServerStream infoStream;
+  infoStream.SetData(info.data(), info.size());
+  this->CopyFromStream(&infoStream);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::StoreInIndex(const std::string& entryKey)
+{
+  vtkClientServerStream infoStream;
+  this->CopyToStream(&infoStream);
+  const unsigned char* data;
+  size_t length;
+  infoStream.GetData(&data, &length);
+
+  vtkClientServerStream css;
+  css << vtkClientServerStream::Reply << IndexName << IndexVersion
+      << vtkClientServerStream::InsertArray(data, static_cast<int>(length))
+      << vtkClientServerStream::End;
+  css.GetData(&data, &length);
+  GetMemoryIndex().Insert(entryKey, std::vector<unsigned char>(data, data + length));
+  WriteSidecar(entryKey, data, length);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
 {
@@ -147,6 +447,28 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
     return;
   }
 
+  // Use the index when the pipeline and the files it reads are unchanged.
+  // All processes must agree, since updating the pipeline may involve
+  // collective communication: the index is only used if every process finds
+  // its entry.
+  const std::string entryKey = this->GetIndexEntryKey(port);
+  int found = !entryKey.empty() && this->LoadFromIndex(entryKey) ? 1 : 0;
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    int foundEverywhere = found;
+    controller->AllReduce(&found, &foundEverywhere, 1, vtkCommunicator::MIN_OP);
+    if (found && !foundEverywhere)
+    {
+      this->Initialize();
+    }
+    found = foundEverywhere;
+  }
+  if (found)
+  {
+    return;
+  }
+
   port->GetProducer()->Update();
   vtkDataObject* dobj = port->GetProducer()->GetOutputDataObject(port->GetIndex());
 
@@ -211,6 +533,11 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
     dinfo->CopyFromObject(dobj);
     this->AddInformation(dinfo);
   }
+
+  if (!entryKey.empty())
+  {
+    this->StoreInIndex(entryKey);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -419,6 +746,8 @@ void vtkPVTemporalDataInformation::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "NumberOfTimeSteps: " << this->NumberOfTimeSteps << endl;
   os << indent << "TimeRange: " << this->TimeRange[0] << ", " << this->TimeRange[1] << endl;
+  os << indent << "IndexKey: " << (this->IndexKey ? this->IndexKey : "(none)") << endl;
+  os << indent << "IndexFileNames: " << this->IndexFileNames.size() << endl;
 
   vtkIndent i2 = indent.GetNextIndent();
   os << indent << "PointDataInformation " << endl;
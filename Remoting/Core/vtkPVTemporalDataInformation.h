@@ -20,6 +20,19 @@
  * and hence this is not directly a subclass of vtkPVDataInformation. It
  * internally uses vtkPVDataInformation to collect information about each
  * timestep.
+ *
+ * Gathering the information updates the pipeline once per timestep, which is
+ * expensive for long time series. When an index key is provided (see
+ * SetIndexKey), the gathered information is stored in an index and reused
+ * as long as the key and the files listed with AddIndexFileName are
+ * unchanged. The index is kept in memory for the lifetime of the process,
+ * dropping the least recently used entries beyond 16 MB, and, when the
+ * `PV_TEMPORAL_INDEX_DIRECTORY` environment variable names an existing
+ * directory, also in sidecar files in that directory so that it persists
+ * across sessions. In parallel, the index is only used when every process
+ * finds its entry. Files modified in the last two seconds are not indexed,
+ * since some file systems record modification times to the second. The
+ * index can be disabled with SetUseIndex.
 */
 
 #ifndef vtkPVTemporalDataInformation_h
@@ -28,6 +41,10 @@
 #include "vtkPVInformation.h"
 #include "vtkRemotingCoreModule.h" //needed for exports
 
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class vtkAlgorithmOutput;
 class vtkPVArrayInformation;
 class vtkPVDataSetAttributesInformation;
 
@@ -50,6 +67,40 @@ public:
   vtkSetMacro(PortNumber, int);
   //@}
 
+  //@{
+  /**
+   * Key identifying the state of the pipeline producing the port, typically
+   * built from the properties of the upstream proxies. When empty (default),
+   * the index is not used and the information is always gathered by updating
+   * the pipeline for each timestep. The key must change whenever the data
+   * produced by the pipeline may change, except for changes of the files
+   * added with AddIndexFileName: their modification time and size are added
+   * to the key when gathering the information.
+   */
+  vtkSetStringMacro(IndexKey);
+  vtkGetStringMacro(IndexKey);
+  //@}
+
+  //@{
+  /**
+   * Files read by the pipeline. They must be all the files the pipeline
+   * reads: files referenced by these files are not checked. If one of them
+   * cannot be found, the index is not used.
+   */
+  void AddIndexFileName(const char* fname);
+  void RemoveAllIndexFileNames();
+  //@}
+
+  //@{
+  /**
+   * Enable or disable the index for all instances. Default is true. Disable it
+   * when sources or filters produce data depending on state other than their
+   * properties and the files they read, e.g. scripts reading external state.
+   */
+  static void SetUseIndex(bool val);
+  static bool GetUseIndex();
+  //@}
+
   /**
    * Transfer information about a single object into this object.
    * This expects the \c object to be a vtkAlgorithmOutput.
@@ -149,8 +200,26 @@ protected:
   double TimeRange[2];
   int NumberOfTimeSteps;
   int PortNumber;
+  char* IndexKey;
+  std::vector<std::string> IndexFileNames;
+
+  static bool UseIndex;
 
 private:
+  /**
+   * Returns the key of the information gathered from \c port in the index,
+   * or an empty string if the index must not be used.
+   */
+  std::string GetIndexEntryKey(vtkAlgorithmOutput* port);
+
+  //@{
+  /**
+   * Looks up/stores the information in the index.
+   */
+  bool LoadFromIndex(const std::string& entryKey);
+  void StoreInIndex(const std::string& entryKey);
+  //@}
+
   vtkPVTemporalDataInformation(const vtkPVTemporalDataInformation&) = delete;
   void operator=(const vtkPVTemporalDataInformation&) = delete;
 };
@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestClientServerDispatchBenchmark.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Measures the throughput of vtkClientServerInterpreter::ProcessStream for
+// streams of Invoke messages, as sent when updating proxies. Methods are
+// picked to exercise dispatch on the object's class as well as on superclasses
+// further up the hierarchy. The test also verifies that every message is
+// dispatched successfully and that unknown methods are reported as errors.
+//
+// Use `--iterations=N` to change the number of streams processed.
+
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerInterpreterInitializer.h"
+#include "vtkClientServerStream.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkProcessModule.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <vtksys/CommandLineArguments.hxx>
+
+namespace
+{
+bool HasError(vtkClientServerInterpreter* interp)
+{
+  const vtkClientServerStream& result = interp->GetLastResult();
+  return result.GetNumberOfMessages() > 0 &&
+    result.GetCommand(0) == vtkClientServerStream::Error;
+}
+}
+
+int TestClientServerDispatchBenchmark(int argc, char* argv[])
+{
+  int iterations = 2000;
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  arg.StoreUnusedArguments(true);
+  arg.AddArgument("--iterations", vtksys::CommandLineArguments::EQUAL_ARGUMENT, &iterations,
+    "Number of streams to process.");
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  int status = EXIT_SUCCESS;
+  {
+    vtkClientServerInterpreter* interp =
+      vtkClientServerInterpreterInitializer::GetGlobalInterpreter();
+    const vtkClientServerID id = interp->GetNextAvailableId();
+
+    vtkClientServerStream create;
+    create << vtkClientServerStream::New << "vtkSphereSource" << id << vtkClientServerStream::End;
+    if (!interp->ProcessStream(create))
+    {
+      cerr << "Failed to create vtkSphereSource." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // Methods from vtkSphereSource, vtkAlgorithm and vtkObject.
+    vtkClientServerStream stream;
+    int numberOfMessages = 0;
+    for (int cc = 0; cc < 10; ++cc)
+    {
+      stream << vtkClientServerStream::Invoke << id << "SetRadius" << 0.5 + cc
+             << vtkClientServerStream::End;
+      stream << vtkClientServerStream::Invoke << id << "SetThetaResolution" << 8 + cc
+             << vtkClientServerStream::End;
+      stream << vtkClientServerStream::Invoke << id << "SetCenter" << 0.0 << 1.0 << cc * 1.0
+             << vtkClientServerStream::End;
+      stream << vtkClientServerStream::Invoke << id << "SetAbortExecute" << 0
+             << vtkClientServerStream::End;
+      stream << vtkClientServerStream::Invoke << id << "GetMTime" << vtkClientServerStream::End;
+      stream << vtkClientServerStream::Invoke << id << "Modified" << vtkClientServerStream::End;
+      numberOfMessages += 6;
+    }
+
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    for (int iter = 0; iter < iterations && status == EXIT_SUCCESS; ++iter)
+    {
+      if (!interp->ProcessStream(stream) || HasError(interp))
+      {
+        cerr << "Failed to process stream." << endl;
+        interp->GetLastResult().Print(cerr);
+        status = EXIT_FAILURE;
+      }
+    }
+    timer->StopTimer();
+
+    const double elapsed = timer->GetElapsedTime();
+    const double total = static_cast<double>(numberOfMessages) * iterations;
+    cout << "Processed " << total << " messages in " << elapsed << " s ("
+         << total / std::max(elapsed, 1e-9) << " messages/s)" << endl;
+
+    // Unknown methods must still be reported as errors.
+    vtkClientServerStream unknown;
+    unknown << vtkClientServerStream::Invoke << id << "NoSuchMethod"
+            << vtkClientServerStream::End;
+    interp->ProcessStream(unknown);
+    if (!HasError(interp))
+    {
+      cerr << "Unknown method was not reported as an error." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    vtkClientServerStream remove;
+    remove << vtkClientServerStream::Delete << id << vtkClientServerStream::End;
+    interp->ProcessStream(remove);
+  }
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,221 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCollectInformationBenchmark.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares vtkPVSessionCore::CollectInformation, which reduces information to
+// rank 0 using a binomial tree, with the linear gather it replaced, in which
+// rank 0 receives and merges the information of every rank in turn. Both are
+// run on all ranks, the time spent on rank 0 is reported, and the information
+// they produce must be identical.
+//
+// Use `--repeat=N` to change the number of times each approach is run.
+
+#include "vtkClientServerStream.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVSessionCore.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <string>
+#include <vector>
+#include <vtksys/CommandLineArguments.hxx>
+
+namespace
+{
+// Exposes CollectInformation, which vtkPVSessionCore calls from
+// GatherInformation once the satellites were asked to gather information.
+class vtkBenchmarkSessionCore : public vtkPVSessionCore
+{
+public:
+  static vtkBenchmarkSessionCore* New();
+  vtkTypeMacro(vtkBenchmarkSessionCore, vtkPVSessionCore);
+  using vtkPVSessionCore::CollectInformation;
+
+protected:
+  vtkBenchmarkSessionCore() = default;
+  ~vtkBenchmarkSessionCore() override = default;
+
+private:
+  vtkBenchmarkSessionCore(const vtkBenchmarkSessionCore&) = delete;
+  void operator=(const vtkBenchmarkSessionCore&) = delete;
+};
+vtkStandardNewMacro(vtkBenchmarkSessionCore);
+
+vtkSmartPointer<vtkPVDataInformation> CreateRankInformation(int rank)
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 15, 0, 15, 16 * rank, 16 * rank + 15);
+
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    vtkNew<vtkDoubleArray> array;
+    std::string name = "array_" + std::to_string(cc);
+    array->SetName(name.c_str());
+    array->SetNumberOfTuples(image->GetNumberOfPoints());
+    array->FillComponent(0, rank * 10.0 + cc);
+    array->SetTypedComponent(0, 0, -rank);
+    image->GetPointData()->AddArray(array);
+  }
+
+  auto info = vtkSmartPointer<vtkPVDataInformation>::New();
+  info->CopyFromObject(image);
+  return info;
+}
+
+// The approach used by CollectInformation before: information from all ranks
+// is gathered on rank 0, which merges it in rank order.
+void LinearGather(vtkMultiProcessController* controller, vtkPVInformation* info)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int nranks = controller->GetNumberOfProcesses();
+
+  vtkClientServerStream stream;
+  const unsigned char* data = nullptr;
+  size_t length = 0;
+  if (rank > 0)
+  {
+    info->CopyToStream(&stream);
+    stream.GetData(&data, &length);
+  }
+  vtkIdType localLength = static_cast<vtkIdType>(length);
+  std::vector<vtkIdType> lengths(nranks, 0);
+  controller->Gather(&localLength, lengths.data(), 1, 0);
+
+  std::vector<vtkIdType> offsets(nranks, 0);
+  for (int cc = 1; cc < nranks; ++cc)
+  {
+    offsets[cc] = offsets[cc - 1] + lengths[cc - 1];
+  }
+  std::vector<unsigned char> buffer(rank == 0 ? offsets[nranks - 1] + lengths[nranks - 1] : 0);
+  controller->GatherV(data, buffer.data(), localLength, lengths.data(), offsets.data(), 0);
+
+  if (rank == 0)
+  {
+    for (int cc = 1; cc < nranks; ++cc)
+    {
+      stream.SetData(buffer.data() + offsets[cc], lengths[cc]);
+      vtkSmartPointer<vtkPVInformation> tempInfo;
+      tempInfo.TakeReference(info->NewInstance());
+      tempInfo->CopyFromStream(&stream);
+      info->AddInformation(tempInfo);
+    }
+  }
+}
+
+std::vector<unsigned char> Serialize(vtkPVInformation* info)
+{
+  vtkClientServerStream stream;
+  info->CopyToStream(&stream);
+  const unsigned char* data;
+  size_t length;
+  stream.GetData(&data, &length);
+  return std::vector<unsigned char>(data, data + length);
+}
+
+bool Benchmark(vtkMultiProcessController* controller, vtkBenchmarkSessionCore* core, int repeat)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int nranks = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkTimerLog> timer;
+  double linearTime = 0.0;
+  double treeTime = 0.0;
+  bool success = true;
+  for (int iteration = 0; iteration < repeat; ++iteration)
+  {
+    auto linear = CreateRankInformation(rank);
+    controller->Barrier();
+    timer->StartTimer();
+    LinearGather(controller, linear);
+    timer->StopTimer();
+    linearTime += timer->GetElapsedTime();
+
+    auto tree = CreateRankInformation(rank);
+    controller->Barrier();
+    timer->StartTimer();
+    core->CollectInformation(tree);
+    timer->StopTimer();
+    treeTime += timer->GetElapsedTime();
+
+    // Keep going on failure, the other ranks are still running the loop.
+    if (rank == 0 && Serialize(linear) != Serialize(tree))
+    {
+      cerr << "ERROR: information mismatch with " << nranks << " ranks." << endl;
+      success = false;
+    }
+    if (rank == 0 && tree->GetNumberOfPoints() != nranks * 16 * 16 * 16)
+    {
+      cerr << "ERROR: incorrect number of points with " << nranks << " ranks." << endl;
+      success = false;
+    }
+  }
+
+  if (rank == 0)
+  {
+    cout << "ranks: " << nranks << " linear: " << linearTime / repeat
+         << "s tree: " << treeTime / repeat << "s" << endl;
+  }
+  return success;
+}
+}
+
+int TestCollectInformationBenchmark(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int repeat = 10;
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument(
+    "--repeat", argT::EQUAL_ARGUMENT, &repeat, "Number of runs of each approach (default: 10).");
+  arg.StoreUnusedArguments(true);
+  int success = arg.Parse() && repeat > 0 ? 1 : 0;
+  if (!success)
+  {
+    cerr << "Problem parsing arguments" << endl;
+  }
+
+  vtkBenchmarkSessionCore* core = vtkBenchmarkSessionCore::New();
+  if (success)
+  {
+    success = Benchmark(controller, core, repeat) ? 1 : 0;
+  }
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  // The session core on rank 0 breaks the RMI loop of the satellites when it
+  // is deleted.
+  if (controller->GetLocalProcessId() == 0)
+  {
+    core->Delete();
+  }
+  else
+  {
+    controller->ProcessRMIs();
+    core->Delete();
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  controller->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -42,6 +42,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -886,106 +887,70 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 }
 
 //----------------------------------------------------------------------------
-#define SafeDeleteArray(array_ptr)                                                                 \
-  {                                                                                                \
-    if (array_ptr != NULL)                                                                         \
-    {                                                                                              \
-      delete[] array_ptr;                                                                          \
-      array_ptr = NULL;                                                                            \
-    }                                                                                              \
-  }
-
 bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
 {
-  // Sanity checks
-  assert("pre: NULL PV information!" && (info != NULL));
-
-  // STEP 0: temporary variables
-  int rank = this->ParallelController->GetLocalProcessId();
-  int nranks = this->ParallelController->GetNumberOfProcesses();
-
+  const int rank = this->ParallelController->GetLocalProcessId();
+  const int nranks = this->ParallelController->GetNumberOfProcesses();
   if (nranks == 1)
   {
     /* short-circuit */
     return true;
   }
 
-  vtkIdType* rcvcounts = NULL;     /* significant only at rank 0 */
-  vtkIdType* offSet = NULL;        /* significant only at rank 0 */
-  int rbufsize = 0;                /* significant only at rank 0 */
-  unsigned char* rcvbuffer = NULL; /* significant only at rank 0 */
-
-  // STEP 1: Initialize data-structures at rank 0
-  if (rank == 0)
-  {
-    rcvcounts = new vtkIdType[nranks];
-    offSet = new vtkIdType[nranks];
-  } // END if rank == 0
-
-  // STEP 2: Serialize the vtkPVInformation object
+  // Information is reduced to rank 0 using a binomial tree. At each step,
+  // ranks with the `mask` bit set send their partial result to `rank - mask`
+  // and are done, while the others merge the partial result from
+  // `rank + mask`, if any. Partial results are merged in increasing rank
+  // order, hence the result on rank 0 is the same as adding information from
+  // all ranks in order, but rank 0 only does log(nranks) merges.
+  //
+  // `info` may be NULL on satellites that failed to gather information. In
+  // that case, an empty message is sent to avoid hanging the parent.
   vtkClientServerStream stream;
-  info->CopyToStream(&stream);
-
-  const unsigned char* data;
-  size_t length;
-
-  // Get pointer to the raw stream data. Note, this is a shallow copy, no
-  // need to delete the data.
-  stream.GetData(&data, &length);
-  vtkIdType local_length = static_cast<vtkIdType>(length);
-
-  // STEP 3: Get number of bytes that each process will send
-  this->ParallelController->Gather(&local_length, rcvcounts, 1, 0);
-
-  // STEP 4: Allocate temporary arrays at rank 0
-  if (rank == 0)
+  for (int mask = 1; mask < nranks; mask <<= 1)
   {
-    // STEP 4.1: Calculate rcvbuffer size & allocate rcvbuffer
-    rbufsize = rcvcounts[0];
-    for (int i = 1; i < nranks; ++i)
+    if ((rank & mask) != 0)
     {
-      rbufsize += rcvcounts[i];
-    }
-    rcvbuffer = new unsigned char[rbufsize];
+      const unsigned char* data = nullptr;
+      size_t length = 0;
+      if (info)
+      {
+        info->CopyToStream(&stream);
+        // Get pointer to the raw stream data. Note, this is a shallow copy, no
+        // need to delete the data.
+        stream.GetData(&data, &length);
+      }
 
-    // STEP 4.2: populate offset array
-    offSet[0] = 0;
-    for (int i = 1; i < nranks; ++i)
-    {
-      offSet[i] = offSet[i - 1] + rcvcounts[i - 1];
+      vtkIdType local_length = static_cast<vtkIdType>(length);
+      this->ParallelController->Send(&local_length, 1, rank - mask, ROOT_SATELLITE_INFO_TAG);
+      if (local_length > 0)
+      {
+        this->ParallelController->Send(data, local_length, rank - mask, ROOT_SATELLITE_INFO_TAG);
+      }
+      break;
     }
-  } // END if rank==0
-
-  // STEP 5: GatherV all data from satellites
-  this->ParallelController->GatherV(data, rcvbuffer, local_length, rcvcounts, offSet, 0);
 
-  // STEP 6: Deserialize data from other ranks at rank 0 and add them to
-  // the information object associated with rank 0.
-  if (rank == 0)
-  {
-    vtkClientServerStream rcvStream;
-    for (int i = 1; i < nranks; ++i)
+    const int source = rank + mask;
+    if (source < nranks)
     {
-      rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
-      vtkPVInformation* tempInfo = info->NewInstance();
-      tempInfo->CopyFromStream(&rcvStream);
-      info->AddInformation(tempInfo);
-      tempInfo->Delete();
-    } // END for all remote ranks
-  }   // END if rank == 0
-
-  // STEP 7: De-allocate temporary arrays at rank 0
-  SafeDeleteArray(rcvcounts);
-  SafeDeleteArray(offSet);
-  SafeDeleteArray(rcvbuffer);
-
-  // Sanity checks -- ensure we return all dynamically allocated memory
-  assert("post: rcvcounts should be NULL" && (rcvcounts == NULL));
-  assert("post: offSet should be NULL" && (offSet == NULL));
-  assert("post: rcvbuffer should be NULL" && (rcvbuffer == NULL));
-
-  // STEP 8: Barrier synchronization
-  this->ParallelController->Barrier();
+      vtkIdType remote_length = 0;
+      this->ParallelController->Receive(&remote_length, 1, source, ROOT_SATELLITE_INFO_TAG);
+      if (remote_length > 0)
+      {
+        std::vector<unsigned char> buffer(remote_length);
+        this->ParallelController->Receive(
+          buffer.data(), remote_length, source, ROOT_SATELLITE_INFO_TAG);
+        if (info)
+        {
+          stream.SetData(buffer.data(), buffer.size());
+          vtkSmartPointer<vtkPVInformation> tempInfo;
+          tempInfo.TakeReference(info->NewInstance());
+          tempInfo->CopyFromStream(&stream);
+          info->AddInformation(tempInfo);
+        }
+      }
+    }
+  }
   return true;
 }
 
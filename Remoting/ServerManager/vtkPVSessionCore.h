@@ -211,7 +211,8 @@ protected:
   bool GatherInformationInternal(vtkPVInformation* information, vtkTypeUInt32 globalid);
 
   /**
-   * Gather information across MPI satellites.
+   * Gather information across MPI satellites. Information is reduced to the
+   * root using a binomial tree, merging partial results on intermediate ranks.
    */
   bool CollectInformation(vtkPVInformation*);
 
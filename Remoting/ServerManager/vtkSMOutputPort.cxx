@@ -26,11 +26,140 @@
 #include "vtkPVXMLElement.h"
 #include "vtkProcessModule.h"
 #include "vtkSMCompoundSourceProxy.h"
+#include "vtkSMCoreUtilities.h"
+#include "vtkSMDoubleVectorProperty.h"
+#include "vtkSMInputProperty.h"
 #include "vtkSMMessage.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMPropertyIterator.h"
 #include "vtkSMSession.h"
+#include "vtkSmartPointer.h"
 #include "vtkTimerLog.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <cstring>
+#include <set>
 #include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Returns true if `fname` has the extension of a format read from that single
+// file, so that its modification time and size identify the data read.
+// Formats that reference other files, such as .pvd, .case, .pvtu or .xdmf,
+// are not indexed since changes to the referenced files would go unnoticed.
+bool IsSingleFileFormat(const std::string& fname)
+{
+  static const std::set<std::string> extensions = { ".vtk", ".vtp", ".vtu", ".vti", ".vts",
+    ".vtr", ".vtkhdf", ".hdf", ".csv", ".tsv", ".txt", ".stl", ".ply", ".obj", ".e", ".exo",
+    ".ex2", ".g", ".gen", ".cgns", ".h5part", ".png", ".jpg", ".jpeg", ".tif", ".tiff", ".bmp",
+    ".pnm" };
+  return extensions.count(
+           vtksys::SystemTools::LowerCase(vtksys::SystemTools::GetFilenameLastExtension(fname))) >
+    0;
+}
+
+// Appends the state of `proxy`, and of the proxies it depends upon, to `key`
+// and collects the files read by the pipeline in `files`. Returns false if the
+// data produced cannot be identified by this state, i.e. if a source in the
+// pipeline does not read files or if a proxy runs Python code, whose output
+// may depend on state other than its properties.
+bool AppendTemporalIndexKey(vtkSMProxy* proxy, unsigned int port, bool isPipelineProxy,
+  std::ostringstream& key, std::vector<std::string>& files, std::set<vtkSMProxy*>& visited)
+{
+  if (!proxy->GetXMLGroup() || !proxy->GetXMLName())
+  {
+    return false;
+  }
+  const char* vtkClassName = proxy->GetVTKClassName();
+  if (vtkClassName && strncmp(vtkClassName, "vtkPython", 9) == 0)
+  {
+    return false;
+  }
+  key << proxy->GetXMLGroup() << ":" << proxy->GetXMLName() << ":" << port << "{";
+  if (!visited.insert(proxy).second)
+  {
+    key << "}";
+    return true;
+  }
+
+  bool hasInputs = false;
+  vtkSmartPointer<vtkSMPropertyIterator> iter;
+  iter.TakeReference(proxy->NewPropertyIterator());
+  for (iter->Begin(); !iter->IsAtEnd(); iter->Next())
+  {
+    vtkSMProperty* prop = iter->GetProperty();
+    if (!prop || prop->GetInformationOnly())
+    {
+      continue;
+    }
+    key << iter->GetKey() << "=";
+    if (auto pp = vtkSMProxyProperty::SafeDownCast(prop))
+    {
+      auto ip = vtkSMInputProperty::SafeDownCast(prop);
+      for (unsigned int cc = 0; cc < pp->GetNumberOfProxies(); ++cc)
+      {
+        vtkSMProxy* dependency = pp->GetProxy(cc);
+        if (!dependency)
+        {
+          continue;
+        }
+        hasInputs = hasInputs || ip != nullptr;
+        if (!AppendTemporalIndexKey(dependency, ip ? ip->GetOutputPortForConnection(cc) : 0,
+              ip != nullptr, key, files, visited))
+        {
+          return false;
+        }
+      }
+    }
+    else if (vtkSMVectorProperty::SafeDownCast(prop))
+    {
+      vtkSMPropertyHelper helper(prop);
+      const bool isDouble = vtkSMDoubleVectorProperty::SafeDownCast(prop) != nullptr;
+      for (unsigned int cc = 0; cc < helper.GetNumberOfElements(); ++cc)
+      {
+        if (isDouble)
+        {
+          key << helper.GetAsDouble(cc) << ",";
+        }
+        else
+        {
+          key << helper.GetAsVariant(cc).ToString() << ",";
+        }
+      }
+    }
+    key << ";";
+  }
+  key << "}";
+
+  if (isPipelineProxy && !hasInputs)
+  {
+    const char* pname = vtkSMCoreUtilities::GetFileNameProperty(proxy);
+    if (!pname)
+    {
+      return false;
+    }
+    vtkSMPropertyHelper helper(proxy, pname);
+    const size_t numberOfFiles = files.size();
+    for (unsigned int cc = 0; cc < helper.GetNumberOfElements(); ++cc)
+    {
+      const char* fname = helper.GetAsString(cc);
+      if (fname && *fname)
+      {
+        if (!IsSingleFileFormat(fname))
+        {
+          return false;
+        }
+        files.push_back(fname);
+      }
+    }
+    return files.size() > numberOfFiles;
+  }
+  return true;
+}
+}
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSMOutputPort);
@@ -136,6 +265,25 @@ void vtkSMOutputPort::GatherTemporalDataInformation()
   this->SourceProxy->GetSession()->PrepareProgress();
   this->TemporalDataInformation->Initialize();
   this->TemporalDataInformation->SetPortNumber(this->PortIndex);
+
+  // Let the server reuse the information gathered for the same pipeline state
+  // and files instead of updating the pipeline for every timestep.
+  this->TemporalDataInformation->SetIndexKey(nullptr);
+  this->TemporalDataInformation->RemoveAllIndexFileNames();
+  std::ostringstream key;
+  key.precision(17);
+  std::vector<std::string> files;
+  std::set<vtkSMProxy*> visited;
+  if (!this->CompoundSourceProxy &&
+    AppendTemporalIndexKey(this->SourceProxy, this->PortIndex, true, key, files, visited))
+  {
+    this->TemporalDataInformation->SetIndexKey(key.str().c_str());
+    for (const auto& fname : files)
+    {
+      this->TemporalDataInformation->AddIndexFileName(fname.c_str());
+    }
+  }
+
   this->SourceProxy->GatherInformation(this->TemporalDataInformation);
 
   this->TemporalDataInformationValid = true;
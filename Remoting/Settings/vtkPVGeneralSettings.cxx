@@ -15,6 +15,7 @@
 #include "vtkPVGeneralSettings.h"
 
 #include "vtkObjectFactory.h"
+#include "vtkPVTemporalDataInformation.h"
 #include "vtkProcessModuleAutoMPI.h"
 #include "vtkSISourceProxy.h"
 #include "vtkSMArraySelectionDomain.h"
@@ -168,6 +169,25 @@ void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
     this->AnimationGeometryCacheLimit = val;
     this->Modified();
   }
+#if VTK_MODULE_ENABLE_ParaView_RemotingAnimation
+  vtkSMAnimationScene::SetGlobalGeometryCacheLimit(val);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetUseTemporalInformationIndex(bool val)
+{
+  if (vtkPVTemporalDataInformation::GetUseIndex() != val)
+  {
+    vtkPVTemporalDataInformation::SetUseIndex(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetUseTemporalInformationIndex()
+{
+  return vtkPVTemporalDataInformation::GetUseIndex();
 }
 
 //----------------------------------------------------------------------------
@@ -152,6 +152,16 @@ public:
   vtkGetMacro(AnimationGeometryCacheLimit, unsigned long);
   //@}
 
+  //@{
+  /**
+   * Set whether the data information gathered over time, e.g. to rescale
+   * color maps over all timesteps, is indexed and reused while the pipeline
+   * and the files it reads are unchanged. Default is true.
+   */
+  void SetUseTemporalInformationIndex(bool val);
+  bool GetUseTemporalInformationIndex();
+  //@}
+
   //@{
   /**
    * Set the precision of the animation time toolbar.
@@ -0,0 +1,147 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestIncrementalGeometryDelivery.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that, with incremental geometry delivery, representations waiting for
+// their geometry keep rendering the geometry delivered previously.
+
+#include "vtkDataObject.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVView.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+vtkIdType GetNumberOfDeliveredPoints(vtkSMProxy* view, vtkSMProxy* repr)
+{
+  auto pvview = vtkPVView::SafeDownCast(view->GetClientSideObject());
+  auto pvrepr =
+    vtkPVDataRepresentation::SafeDownCast(repr->GetSubProxy("SurfaceRepresentation")
+                                            ->GetClientSideObject());
+  vtkDataObject* data = pvview->GetDeliveryManager()->GetDeliveredPiece(pvrepr, false);
+  return data ? data->GetNumberOfElements(vtkDataObject::POINT) : 0;
+}
+}
+
+int TestIncrementalGeometryDelivery(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  int status = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+    vtkNew<vtkSMSession> session;
+    vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+    controller->InitializeSession(session.Get());
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    // deliver a single representation per render.
+    vtkSmartPointer<vtkSMRenderViewProxy> view;
+    view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+    controller->InitializeProxy(view);
+    vtkSMPropertyHelper(view, "IncrementalGeometryDelivery").Set(1);
+    vtkSMPropertyHelper(view, "IncrementalDeliveryTimeBudget").Set(0.0);
+    view->UpdateVTKObjects();
+    controller->RegisterViewProxy(view);
+
+    vtkSmartPointer<vtkSMSourceProxy> spheres[2];
+    vtkSMProxy* reprs[2];
+    for (int cc = 0; cc < 2; ++cc)
+    {
+      spheres[cc].TakeReference(
+        vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+      controller->InitializeProxy(spheres[cc]);
+      vtkSMPropertyHelper(spheres[cc], "Center").Set(0, 2.0 * cc);
+      spheres[cc]->UpdateVTKObjects();
+      controller->RegisterPipelineProxy(spheres[cc]);
+      reprs[cc] = controller->Show(spheres[cc], 0, view);
+    }
+
+    view->ResetCamera();
+    for (int cc = 0; cc < 10 && (cc == 0 || view->HasPendingDeliveries()); ++cc)
+    {
+      view->StillRender();
+    }
+
+    vtkIdType oldCounts[2];
+    for (int cc = 0; cc < 2; ++cc)
+    {
+      oldCounts[cc] = GetNumberOfDeliveredPoints(view, reprs[cc]);
+      if (oldCounts[cc] == 0)
+      {
+        cerr << "Geometry was not delivered for representation " << cc << "." << endl;
+        status = EXIT_FAILURE;
+      }
+      vtkSMPropertyHelper(spheres[cc], "ThetaResolution").Set(32);
+      spheres[cc]->UpdateVTKObjects();
+    }
+
+    // only one of the representations gets its new geometry, the other one
+    // must keep rendering its old geometry.
+    view->StillRender();
+    if (!view->HasPendingDeliveries())
+    {
+      cerr << "Expected a pending delivery." << endl;
+      status = EXIT_FAILURE;
+    }
+    int numberOfUpdated = 0;
+    for (int cc = 0; cc < 2; ++cc)
+    {
+      const vtkIdType count = GetNumberOfDeliveredPoints(view, reprs[cc]);
+      if (count != oldCounts[cc])
+      {
+        ++numberOfUpdated;
+      }
+      else if (count == 0)
+      {
+        cerr << "Queued representation " << cc << " lost its geometry." << endl;
+        status = EXIT_FAILURE;
+      }
+    }
+    if (numberOfUpdated != 1)
+    {
+      cerr << "Expected a single representation with new geometry, got " << numberOfUpdated
+           << "." << endl;
+      status = EXIT_FAILURE;
+    }
+
+    // the next render delivers the remaining geometry.
+    view->StillRender();
+    for (int cc = 0; cc < 2; ++cc)
+    {
+      if (view->HasPendingDeliveries() ||
+        GetNumberOfDeliveredPoints(view, reprs[cc]) == oldCounts[cc])
+      {
+        cerr << "Geometry was not updated for representation " << cc << "." << endl;
+        status = EXIT_FAILURE;
+      }
+    }
+
+    controller->UnRegisterProxy(spheres[0]);
+    controller->UnRegisterProxy(spheres[1]);
+    controller->UnRegisterProxy(view);
+    vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  }
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestRenderingCostModel.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the estimates used by vtkPVRenderView to pick the remote rendering
+// threshold when adaptive remote rendering is enabled, and in particular that
+// the model can move from either rendering mode to the other when it starts
+// with measurements of a single mode.
+
+#include "vtkPVRenderingCostModel.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << "ERROR: " << message << std::endl;
+  }
+  return condition;
+}
+
+// Starts with remote renders: small geometry must switch to local rendering,
+// large geometry must stay remote.
+bool TestStartRemote()
+{
+  const double imageSize = 6.0; // MB
+  vtkPVRenderingCostModel model;
+  if (!Check(!model.IsReady() && !model.NeedsRemoteProbe(), "empty model must not be ready"))
+  {
+    return false;
+  }
+  for (int cc = 0; cc < 10; ++cc)
+  {
+    model.AddRenderSample(/*remote=*/true, 0.0, 0.05);
+  }
+  model.AddUpdate();
+  if (!Check(model.IsReady() && !model.NeedsRemoteProbe(), "remote renders must be enough"))
+  {
+    return false;
+  }
+
+  // 10 renders per update of 0.05 s, and images delivered at 120 MB/s, at
+  // least: geometry up to ~48 MB could be cheaper to render locally.
+  const double threshold = model.GetThreshold(/*remote=*/true, imageSize);
+  if (!Check(threshold > 10.0, "small geometry must be tried locally") ||
+    !Check(threshold < 100.0, "large geometry must stay remote"))
+  {
+    std::cerr << "threshold: " << threshold << std::endl;
+    return false;
+  }
+
+  // The local probe measures the delivery and the local render. With a fast
+  // network and local renderer, the threshold grows past the geometry size.
+  model.AddDeliverySample(10.0, 0.01);
+  model.AddRenderSample(/*remote=*/false, 10.0, 0.01);
+  const double localThreshold = model.GetThreshold(/*remote=*/false, imageSize);
+  if (!Check(localThreshold > 10.0, "measured local rendering must be kept"))
+  {
+    std::cerr << "threshold: " << localThreshold << std::endl;
+    return false;
+  }
+
+  // With a slow network, e.g. a VPN, it falls below it.
+  vtkPVRenderingCostModel slow = model;
+  for (int cc = 0; cc < 20; ++cc)
+  {
+    slow.AddDeliverySample(10.0, 10.0);
+  }
+  const double slowThreshold = slow.GetThreshold(/*remote=*/false, imageSize);
+  return Check(slowThreshold < 10.0, "slow delivery must switch back to remote rendering");
+}
+
+// Starts with local renders: a remote probe is needed, after which large
+// geometry must switch to remote rendering and small geometry stay local.
+bool TestStartLocal()
+{
+  const double imageSize = 6.0; // MB
+  vtkPVRenderingCostModel model;
+  model.AddDeliverySample(200.0, 20.0); // 10 MB/s
+  for (int cc = 0; cc < 10; ++cc)
+  {
+    model.AddRenderSample(/*remote=*/false, 200.0, 0.5);
+  }
+  model.AddUpdate();
+  if (!Check(!model.IsReady() && model.NeedsRemoteProbe(), "local renders must ask for a probe"))
+  {
+    return false;
+  }
+
+  model.AddRenderSample(/*remote=*/true, 0.0, 0.05);
+  if (!Check(model.IsReady() && !model.NeedsRemoteProbe(), "the probe must be enough"))
+  {
+    return false;
+  }
+  const double threshold = model.GetThreshold(/*remote=*/false, imageSize);
+  return Check(threshold < 200.0, "large geometry must switch to remote rendering") &&
+    Check(threshold > 0.1, "small geometry must stay local");
+}
+}
+
+int TestRenderingCostModel(int, char*[])
+{
+  return TestStartRemote() && TestStartLocal() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
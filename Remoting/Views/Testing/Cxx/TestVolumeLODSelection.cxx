@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestVolumeLODSelection.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the choice of the pyramid level and of the visible bricks used by
+// vtkImageVolumeRepresentation when UseVolumeLOD is enabled.
+
+#include "vtkCamera.h"
+#include "vtkNew.h"
+#include "vtkPVVolumeLODSelection.h"
+#include "vtkPiecewiseFunction.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << "ERROR: " << message << std::endl;
+  }
+  return condition;
+}
+
+bool TestSelectLevel()
+{
+  const std::vector<int> sizes = { 256, 128, 64, 32, 16 };
+  return Check(vtkPVVolumeLODSelection::SelectLevel(sizes, 1000) == 0,
+           "the finest level must be used when none is large enough") &&
+    Check(vtkPVVolumeLODSelection::SelectLevel(sizes, 100) == 1,
+      "the coarsest level larger than the target must be used") &&
+    Check(vtkPVVolumeLODSelection::SelectLevel(sizes, 64) == 2,
+      "a level as large as the target must be used") &&
+    Check(vtkPVVolumeLODSelection::SelectLevel(sizes, 1) == 4,
+      "the coarsest level must be used for small targets") &&
+    Check(vtkPVVolumeLODSelection::SelectLevel(std::vector<int>(1, 8), 100) == 0,
+      "a single level must be used");
+}
+
+void GetCorners(double xmin, double ymin, double zmin, double size, double corners[8][3])
+{
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    corners[cc][0] = xmin + ((cc & 1) ? size : 0);
+    corners[cc][1] = ymin + ((cc & 2) ? size : 0);
+    corners[cc][2] = zmin + ((cc & 4) ? size : 0);
+  }
+}
+
+bool TestFrustum()
+{
+  vtkNew<vtkCamera> camera;
+  camera->SetPosition(0, 0, 10);
+  camera->SetFocalPoint(0, 0, 0);
+  camera->SetClippingRange(1, 100);
+  double planes[24];
+  camera->GetFrustumPlanes(1.0, planes);
+
+  double corners[8][3];
+  GetCorners(-1, -1, -1, 2, corners);
+  if (!Check(!vtkPVVolumeLODSelection::IsOutsideFrustum(corners, planes),
+        "a brick at the focal point must be visible"))
+  {
+    return false;
+  }
+  GetCorners(100, -1, -1, 2, corners);
+  if (!Check(vtkPVVolumeLODSelection::IsOutsideFrustum(corners, planes),
+        "a brick on the side must be culled"))
+  {
+    return false;
+  }
+  GetCorners(-1, -1, 20, 2, corners);
+  if (!Check(vtkPVVolumeLODSelection::IsOutsideFrustum(corners, planes),
+        "a brick behind the camera must be culled"))
+  {
+    return false;
+  }
+  // Crosses the side of the frustum.
+  GetCorners(-1, -1, -1, 100, corners);
+  return Check(!vtkPVVolumeLODSelection::IsOutsideFrustum(corners, planes),
+    "a brick crossing the frustum must be visible");
+}
+
+bool TestOpacity()
+{
+  vtkNew<vtkPiecewiseFunction> opacity;
+  opacity->AddPoint(0, 0);
+  opacity->AddPoint(10, 0);
+  opacity->AddPoint(11, 1);
+  opacity->AddPoint(12, 0);
+  opacity->AddPoint(100, 0);
+  opacity->AddPoint(110, 1);
+
+  const double transparent[2] = { 0, 9 };
+  const double spike[2] = { 5, 50 };
+  const double end[2] = { 105, 200 };
+  const double beyond[2] = { 200, 300 };
+  return Check(vtkPVVolumeLODSelection::IsTransparent(opacity, transparent),
+           "a brick mapped to zero opacity must be culled") &&
+    Check(!vtkPVVolumeLODSelection::IsTransparent(opacity, spike),
+      "a brick containing an opaque node must be visible") &&
+    Check(!vtkPVVolumeLODSelection::IsTransparent(opacity, end),
+      "a brick with an opaque end must be visible") &&
+    Check(!vtkPVVolumeLODSelection::IsTransparent(opacity, beyond),
+      "a brick past the last opaque node must be visible");
+}
+}
+
+int TestVolumeLODSelection(int, char*[])
+{
+  return TestSelectLevel() && TestFrustum() && TestOpacity() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
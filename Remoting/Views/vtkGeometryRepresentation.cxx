@@ -148,6 +148,8 @@ vtkGeometryRepresentation::vtkGeometryRepresentation()
   this->MultiBlockMaker = vtkGeometryRepresentationMultiBlockMaker::New();
   this->Decimator = vtkGeometryRepresentation_detail::DecimationFilterType::New();
   this->LODOutlineFilter = vtkPVGeometryFilter::New();
+  this->LODPyramid = new vtkGeometryRepresentation_detail::LODPyramidBuilder();
+  this->LastLODNumberOfCells = 0;
 
   // connect progress bar
   this->GeometryFilter->AddObserver(vtkCommand::ProgressEvent, this,
@@ -211,6 +213,7 @@ vtkGeometryRepresentation::~vtkGeometryRepresentation()
   this->MultiBlockMaker->Delete();
   this->Decimator->Delete();
   this->LODOutlineFilter->Delete();
+  delete this->LODPyramid;
   this->Mapper->Delete();
   this->LODMapper->Delete();
   this->Actor->Delete();
@@ -300,6 +303,19 @@ int vtkGeometryRepresentation::ProcessViewRequest(
     // rendering nodes as and when needed.
     vtkPVView::SetPiece(inInfo, this, this->MultiBlockMaker->GetOutputDataObject(0));
 
+    // Start building the levels of detail in the background if the view is
+    // going to need them, so that the next interactive render does not have
+    // to wait for the decimation. Views that never rendered with LOD, e.g.
+    // in batch mode or animation playback, do not pay for it.
+    auto view = vtkPVRenderView::SafeDownCast(this->GetView());
+    auto data = vtkPVView::GetPiece(inInfo, this);
+    if (view && data && view->GetHasRenderedWithLOD() && !this->SuppressLOD &&
+      !view->GetUseOutlineForLODRendering() &&
+      view->GetLODRenderingThreshold() <= data->GetActualMemorySize() / 1024.0)
+    {
+      this->LODPyramid->Start(this->GetCacheKey(), data, view->GetLODResolution());
+    }
+
     if (this->UseDataPartitions == true)
     {
       // We want to use this representation's data bounds to redistribute all other data in the
@@ -347,20 +363,31 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       }
       else
       {
-        if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+        const double factor = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+          ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+          : 0.5;
+        const double cacheKey = this->GetCacheKey();
+        auto levels = this->LODPyramid->GetLevels(cacheKey, data, factor);
+        if (levels)
+        {
+          // Use the levels built in the background.
+          const int level = this->SelectLODLevel(inInfo, cacheKey);
+          this->LastLODNumberOfCells = this->LODPyramid->GetNumberOfCells(cacheKey, level);
+          vtkPVView::SetPieceLOD(inInfo, this, (*levels)[level]);
+        }
+        else
         {
           // We handle this number differently depending on decimator
           // implementation.
-          const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
           this->Decimator->SetLODFactor(factor);
-        }
+          this->Decimator->SetInputDataObject(data);
+          this->Decimator->Update();
+          this->LastLODNumberOfCells = 0;
 
-        this->Decimator->SetInputDataObject(data);
-        this->Decimator->Update();
-
-        // Pass along the LOD geometry to the view so that it can deliver it to
-        // the rendering node as and when needed.
-        vtkPVView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
+          // Pass along the LOD geometry to the view so that it can deliver it to
+          // the rendering node as and when needed.
+          vtkPVView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
+        }
       }
     }
   }
@@ -400,6 +427,35 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkGeometryRepresentation::SelectLODLevel(vtkInformation* inInfo, double cacheKey)
+{
+  if (!inInfo->Has(vtkPVRenderView::LOD_RENDER_TIME_BUDGET()) ||
+    !inInfo->Has(vtkPVRenderView::LAST_LOD_RENDER_TIME()) || this->LastLODNumberOfCells <= 0)
+  {
+    return 0;
+  }
+
+  // Assume the render time is proportional to the number of cells rendered
+  // and pick the finest level that fits in the budget.
+  const double budget = inInfo->Get(vtkPVRenderView::LOD_RENDER_TIME_BUDGET());
+  const double lastTime = inInfo->Get(vtkPVRenderView::LAST_LOD_RENDER_TIME());
+  if (lastTime <= 0)
+  {
+    return 0;
+  }
+  const double timePerCell = lastTime / this->LastLODNumberOfCells;
+  const int lastLevel = vtkGeometryRepresentation_detail::LODPyramidBuilder::NumberOfLevels - 1;
+  for (int level = 0; level < lastLevel; ++level)
+  {
+    if (timePerCell * this->LODPyramid->GetNumberOfCells(cacheKey, level) <= budget)
+    {
+      return level;
+    }
+  }
+  return lastLevel;
+}
+
 //----------------------------------------------------------------------------
 int vtkGeometryRepresentation::RequestUpdateExtent(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
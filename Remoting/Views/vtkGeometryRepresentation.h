@@ -49,6 +49,7 @@ namespace vtkGeometryRepresentation_detail
 // This is defined to either vtkQuadricClustering or vtkmLevelOfDetail in the
 // implementation file:
 class DecimationFilterType;
+class LODPyramidBuilder;
 }
 
 class VTKREMOTINGVIEWS_EXPORT vtkGeometryRepresentation : public vtkPVDataRepresentation
@@ -402,10 +403,19 @@ protected:
    */
   virtual bool NeedsOrderedCompositing();
 
+  /**
+   * Returns the level of detail to render, among the levels built by
+   * LODPyramid, given the render time budget in the REQUEST_UPDATE_LOD()
+   * request, if any.
+   */
+  int SelectLODLevel(vtkInformation* inInfo, double cacheKey);
+
   vtkAlgorithm* GeometryFilter;
   vtkAlgorithm* MultiBlockMaker;
   vtkGeometryRepresentation_detail::DecimationFilterType* Decimator;
   vtkPVGeometryFilter* LODOutlineFilter;
+  vtkGeometryRepresentation_detail::LODPyramidBuilder* LODPyramid;
+  vtkIdType LastLODNumberOfCells;
 
   vtkMapper* Mapper;
   vtkMapper* LODMapper;
@@ -140,5 +140,252 @@ protected:
 vtkStandardNewMacro(DecimationFilterType)
 }
 #endif // VTKM_ENABLE_TBB
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkWeakPointer.h"
+
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace vtkGeometryRepresentation_detail
+{
+/**
+ * Builds decimated levels of detail of the representation geometry on a
+ * worker thread. The levels are built right after the full resolution data
+ * is updated so that they are ready, or almost ready, when the view asks for
+ * LOD geometry. Level 0 uses the view's LOD resolution, each following level
+ * halves the resolution. Levels are kept per cache key, as long as the data
+ * they were built from is alive.
+ *
+ * The worker decimates a deep copy of the data, so that the data can be
+ * modified, or used by the main thread, while the levels are being built.
+ * Starting a new build does not wait for the previous one: its result is
+ * dropped once it completes. While a dropped build is still running, no new
+ * build is started, which bounds the number of workers to two.
+ */
+class LODPyramidBuilder
+{
+public:
+  static const int NumberOfLevels = 3;
+
+  ~LODPyramidBuilder()
+  {
+    this->Wait();
+    for (auto& job : this->Dropped)
+    {
+      job->Worker.join();
+    }
+  }
+
+  /**
+   * Starts building the levels for `data`, unless they are already built or
+   * being built, or too many dropped builds are still running.
+   */
+  void Start(double cacheKey, vtkDataObject* data, double factor)
+  {
+    this->Prune();
+    if (this->Pending && this->Pending->IsBuiltFrom(cacheKey, data, factor))
+    {
+      return;
+    }
+
+    auto iter = this->Pyramids.find(cacheKey);
+    if (iter != this->Pyramids.end() && iter->second.IsBuiltFrom(data, factor))
+    {
+      return;
+    }
+
+    if (this->Pending)
+    {
+      if (!this->Pending->Done)
+      {
+        if (!this->Dropped.empty())
+        {
+          // Decimation is slower than updates, e.g. during animation playback:
+          // do not start yet another build.
+          return;
+        }
+        this->Dropped.push_back(std::move(this->Pending));
+      }
+      this->Wait();
+    }
+
+    std::unique_ptr<Job> job(new Job);
+    job->Key = cacheKey;
+    job->Result.Source = data;
+    job->Result.SourceTime = data->GetMTime();
+    job->Result.Factor = factor;
+
+    // Filters are created and connected here, so that the worker only
+    // executes the pipeline. Each level decimates the previous one.
+    for (int level = 0; level < NumberOfLevels; ++level)
+    {
+      vtkSmartPointer<DecimationFilterType> filter = vtkSmartPointer<DecimationFilterType>::New();
+      filter->SetLODFactor(factor / (1 << level));
+      if (level == 0)
+      {
+        vtkSmartPointer<vtkDataObject> copy;
+        copy.TakeReference(data->NewInstance());
+        copy->DeepCopy(data);
+        filter->SetInputDataObject(copy);
+      }
+      else
+      {
+        filter->SetInputConnection(job->Filters.back()->GetOutputPort());
+      }
+      job->Filters.push_back(filter);
+    }
+
+    Job* jobPtr = job.get();
+    job->Worker = std::thread([jobPtr]() {
+      jobPtr->Filters.back()->Update();
+      jobPtr->Done = true;
+    });
+    this->Pending = std::move(job);
+  }
+
+  /**
+   * Returns the levels built for `data`, waiting for the worker if it is
+   * building them, or nullptr if no levels were built for `data` and
+   * `factor`.
+   */
+  const std::vector<vtkSmartPointer<vtkDataObject> >* GetLevels(
+    double cacheKey, vtkDataObject* data, double factor)
+  {
+    if (this->Pending &&
+      (this->Pending->Done || this->Pending->IsBuiltFrom(cacheKey, data, factor)))
+    {
+      this->Wait();
+    }
+    auto iter = this->Pyramids.find(cacheKey);
+    if (iter == this->Pyramids.end() || !iter->second.IsBuiltFrom(data, factor) ||
+      iter->second.Levels.empty())
+    {
+      return nullptr;
+    }
+    return &iter->second.Levels;
+  }
+
+  /**
+   * Returns the number of cells of a level returned by GetLevels.
+   */
+  vtkIdType GetNumberOfCells(double cacheKey, int level) const
+  {
+    auto iter = this->Pyramids.find(cacheKey);
+    return iter != this->Pyramids.end() &&
+        level < static_cast<int>(iter->second.NumberOfCells.size())
+      ? iter->second.NumberOfCells[level]
+      : 0;
+  }
+
+  /**
+   * Waits for the pending build, if any, and collects the levels it built.
+   */
+  void Wait()
+  {
+    if (!this->Pending)
+    {
+      return;
+    }
+    this->Pending->Worker.join();
+
+    Pyramid& pyramid = this->Pyramids[this->Pending->Key];
+    pyramid = this->Pending->Result;
+    for (auto& filter : this->Pending->Filters)
+    {
+      vtkDataObject* output = filter->GetOutputDataObject(0);
+      pyramid.Levels.push_back(output);
+      pyramid.NumberOfCells.push_back(LODPyramidBuilder::CountCells(output));
+    }
+    this->Pending.reset();
+  }
+
+private:
+  struct Pyramid
+  {
+    vtkWeakPointer<vtkDataObject> Source;
+    vtkMTimeType SourceTime = 0;
+    double Factor = 0.0;
+    std::vector<vtkSmartPointer<vtkDataObject> > Levels;
+    std::vector<vtkIdType> NumberOfCells;
+
+    bool IsBuiltFrom(vtkDataObject* data, double factor) const
+    {
+      return data != nullptr && this->Source.GetPointer() == data &&
+        this->SourceTime == data->GetMTime() && this->Factor == factor;
+    }
+  };
+
+  struct Job
+  {
+    double Key = 0.0;
+    Pyramid Result;
+    std::vector<vtkSmartPointer<DecimationFilterType> > Filters;
+    std::atomic<bool> Done{ false };
+    std::thread Worker;
+
+    bool IsBuiltFrom(double cacheKey, vtkDataObject* data, double factor) const
+    {
+      return this->Key == cacheKey && this->Result.IsBuiltFrom(data, factor);
+    }
+  };
+
+  // Drops the levels built from data that no longer exists, and the dropped
+  // builds that completed.
+  void Prune()
+  {
+    for (auto iter = this->Pyramids.begin(); iter != this->Pyramids.end();)
+    {
+      iter = iter->second.Source.GetPointer() == nullptr ? this->Pyramids.erase(iter)
+                                                         : std::next(iter);
+    }
+    for (auto iter = this->Dropped.begin(); iter != this->Dropped.end();)
+    {
+      if ((*iter)->Done)
+      {
+        (*iter)->Worker.join();
+        iter = this->Dropped.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+  static vtkIdType CountCells(vtkDataObject* data)
+  {
+    if (auto ds = vtkDataSet::SafeDownCast(data))
+    {
+      return ds->GetNumberOfCells();
+    }
+    vtkIdType count = 0;
+    if (auto composite = vtkCompositeDataSet::SafeDownCast(data))
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(composite->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        if (auto leaf = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+        {
+          count += leaf->GetNumberOfCells();
+        }
+      }
+    }
+    return count;
+  }
+
+  std::map<double, Pyramid> Pyramids;
+  std::unique_ptr<Job> Pending;
+  std::vector<std::unique_ptr<Job> > Dropped;
+};
+}
 #endif // __VTK_WRAP__
 // VTK-HeaderTest-Exclude: vtkGeometryRepresentationInternal.h
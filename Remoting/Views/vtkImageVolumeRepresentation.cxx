@@ -15,33 +15,51 @@
 #include "vtkImageVolumeRepresentation.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkCamera.h"
 #include "vtkCellData.h"
 #include "vtkColorTransferFunction.h"
 #include "vtkCommand.h"
 #include "vtkContourValues.h"
+#include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMatrix4x4.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockVolumeMapper.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineSource.h"
+#include "vtkPVBrickVolumeMapper.h"
 #include "vtkPVLODVolume.h"
 #include "vtkPVRenderView.h"
+#include "vtkPVVolumeLODSelection.h"
 #include "vtkPartitionedDataSet.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkPointData.h"
 #include "vtkPolyDataMapper.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSmartVolumeMapper.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
+#include "vtkTimeStamp.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkVolumeProperty.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iterator>
 #include <map>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -101,13 +119,446 @@ void vtkGetNonGhostExtent(int* resultExtent, vtkImageData* dataSet)
     resultExtent[5] = std::min(validCellExtent[5] + 1, resultExtent[5]);
   }
 }
+
+//----------------------------------------------------------------------------
+// Samples `input` at every other point using a [1/4, 1/2, 1/4] filter along
+// each axis. Indices past the boundaries are clamped, so the weights always
+// add up to one. Stops early, leaving the output incomplete, when `cancel` is
+// set.
+template <typename T>
+void vtkDownsample(const T* input, const int inDims[3], T* output, const int outDims[3],
+  int numComps, const std::atomic<bool>& cancel)
+{
+  static const double weights[3] = { 0.25, 0.5, 0.25 };
+  vtkSMPTools::For(0, outDims[2], [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double> sum(numComps);
+    for (vtkIdType k = begin; k < end && !cancel; ++k)
+    {
+      for (int j = 0; j < outDims[1]; ++j)
+      {
+        for (int i = 0; i < outDims[0]; ++i)
+        {
+          std::fill(sum.begin(), sum.end(), 0.0);
+          for (int dk = 0; dk < 3; ++dk)
+          {
+            const vtkIdType kk =
+              std::min(std::max(2 * static_cast<int>(k) + dk - 1, 0), inDims[2] - 1);
+            for (int dj = 0; dj < 3; ++dj)
+            {
+              const vtkIdType jj = std::min(std::max(2 * j + dj - 1, 0), inDims[1] - 1);
+              for (int di = 0; di < 3; ++di)
+              {
+                const vtkIdType ii = std::min(std::max(2 * i + di - 1, 0), inDims[0] - 1);
+                const double w = weights[dk] * weights[dj] * weights[di];
+                const T* src = input + numComps * (ii + inDims[0] * (jj + inDims[1] * kk));
+                for (int c = 0; c < numComps; ++c)
+                {
+                  sum[c] += w * static_cast<double>(src[c]);
+                }
+              }
+            }
+          }
+          T* dst = output + numComps * (i + outDims[0] * (j + outDims[1] * k));
+          for (int c = 0; c < numComps; ++c)
+          {
+            dst[c] = static_cast<T>(std::is_integral<T>::value ? std::floor(sum[c] + 0.5) : sum[c]);
+          }
+        }
+      }
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+// Returns an image with half the resolution of `input` with a single point
+// array downsampled from `array`.
+vtkSmartPointer<vtkImageData> vtkDownsample(
+  vtkImageData* input, vtkDataArray* array, const std::atomic<bool>& cancel)
+{
+  int inDims[3], outDims[3], ext[6];
+  double origin[3], spacing[3];
+  input->GetDimensions(inDims);
+  input->GetExtent(ext);
+  input->GetSpacing(spacing);
+  input->TransformIndexToPhysicalPoint(ext[0], ext[2], ext[4], origin);
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    outDims[cc] = (inDims[cc] - 1) / 2 + 1;
+    spacing[cc] *= 2;
+  }
+
+  auto output = vtkSmartPointer<vtkImageData>::New();
+  output->SetDimensions(outDims);
+  output->SetOrigin(origin);
+  output->SetSpacing(spacing);
+  output->SetDirectionMatrix(input->GetDirectionMatrix());
+
+  vtkSmartPointer<vtkDataArray> outArray;
+  outArray.TakeReference(array->NewInstance());
+  outArray->SetName(array->GetName());
+  outArray->SetNumberOfComponents(array->GetNumberOfComponents());
+  outArray->SetNumberOfTuples(output->GetNumberOfPoints());
+  switch (array->GetDataType())
+  {
+    vtkTemplateMacro(vtkDownsample(static_cast<const VTK_TT*>(array->GetVoidPointer(0)), inDims,
+      static_cast<VTK_TT*>(outArray->GetVoidPointer(0)), outDims,
+      array->GetNumberOfComponents(), cancel));
+  }
+  output->GetPointData()->SetScalars(outArray);
+  return output;
 }
 
+//----------------------------------------------------------------------------
+template <typename T>
+void vtkComputeBrickRange(const T* values, const int dims[3], const int extent[6], double range[2])
+{
+  range[0] = VTK_DOUBLE_MAX;
+  range[1] = VTK_DOUBLE_MIN;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      const T* row = values + dims[0] * (j + static_cast<vtkIdType>(dims[1]) * k);
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        const double value = static_cast<double>(row[i]);
+        range[0] = std::min(range[0], value);
+        range[1] = std::max(range[1], value);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Returns the point array of `image` selected by `info` if a pyramid can be
+// built for it, nullptr otherwise.
+vtkDataArray* vtkGetVolumeLODArray(vtkImageData* image, vtkInformation* info)
+{
+  if (!image || !info || !info->Has(vtkDataObject::FIELD_NAME()) ||
+    (info->Has(vtkDataObject::FIELD_ASSOCIATION()) &&
+      info->Get(vtkDataObject::FIELD_ASSOCIATION()) != vtkDataObject::FIELD_ASSOCIATION_POINTS))
+  {
+    return nullptr;
+  }
+  vtkDataArray* array = image->GetPointData()->GetArray(info->Get(vtkDataObject::FIELD_NAME()));
+  return array && array->HasStandardMemoryLayout() ? array : nullptr;
+}
+}
+
+class vtkImageVolumeRepresentation::vtkInternals
+{
+public:
+  struct vtkBrick
+  {
+    int Extent[6];
+    // Range of the scalars, infinite when the array has several components.
+    double Range[2];
+    // Created when the brick is first rendered.
+    vtkSmartPointer<vtkImageData> Data;
+  };
+
+  struct vtkLevel
+  {
+    vtkSmartPointer<vtkImageData> Image;
+    std::vector<vtkBrick> Bricks;
+  };
+
+  struct vtkPyramid
+  {
+    // The pyramid is keyed on the array and the geometry of the image rather
+    // than on the image MTime, since the delivery manager modifies the image
+    // each time a cached time step is shown again.
+    vtkWeakPointer<vtkDataArray> Array;
+    vtkMTimeType ArrayMTime = 0;
+    int Extent[6] = { 0, -1, 0, -1, 0, -1 };
+    double Origin[3] = { 0, 0, 0 };
+    double Spacing[3] = { 1, 1, 1 };
+    int BrickSize = 0;
+    // Levels[0] has half the resolution of the image.
+    std::vector<vtkLevel> Levels;
+    vtkTimeStamp BuildTime;
+
+    void SetSource(vtkImageData* image, vtkDataArray* array, int brickSize)
+    {
+      this->Array = array;
+      this->ArrayMTime = array->GetMTime();
+      image->GetExtent(this->Extent);
+      image->GetOrigin(this->Origin);
+      image->GetSpacing(this->Spacing);
+      this->BrickSize = brickSize;
+    }
+
+    bool IsBuiltFrom(vtkImageData* image, vtkDataArray* array, int brickSize) const
+    {
+      return this->Array.GetPointer() == array && this->ArrayMTime == array->GetMTime() &&
+        this->BrickSize == brickSize &&
+        std::equal(this->Extent, this->Extent + 6, image->GetExtent()) &&
+        std::equal(this->Origin, this->Origin + 3, image->GetOrigin()) &&
+        std::equal(this->Spacing, this->Spacing + 3, image->GetSpacing());
+    }
+  };
+
+  // Pyramids for each cache key i.e. time step.
+  std::map<double, vtkPyramid> Pyramids;
+
+  // Level whose bricks are set on LODVolumeMapper, and when they were set.
+  const vtkLevel* LODLevel = nullptr;
+  vtkTimeStamp LODTime;
+
+  ~vtkInternals() { this->Cancel(); }
+
+  /**
+   * Starts building the pyramid for `array` on a worker thread, unless it is
+   * already built or being built. If another pyramid is being built, it is
+   * cancelled.
+   */
+  void StartPyramid(double cacheKey, vtkImageData* image, vtkDataArray* array, int brickSize)
+  {
+    if (this->Worker.joinable())
+    {
+      if (this->PendingKey == cacheKey && this->Pending.IsBuiltFrom(image, array, brickSize))
+      {
+        return;
+      }
+      if (this->WorkerDone)
+      {
+        this->Wait();
+      }
+      else
+      {
+        this->Cancel();
+      }
+    }
+
+    for (auto iter = this->Pyramids.begin(); iter != this->Pyramids.end();)
+    {
+      iter = iter->second.Array == nullptr ? this->Pyramids.erase(iter) : std::next(iter);
+    }
+    auto iter = this->Pyramids.find(cacheKey);
+    if (iter != this->Pyramids.end() && iter->second.IsBuiltFrom(image, array, brickSize))
+    {
+      return;
+    }
+
+    this->PendingKey = cacheKey;
+    this->Pending = vtkPyramid();
+    this->Pending.SetSource(image, array, brickSize);
+
+    // The worker uses its own image with only the array, which also keeps the
+    // array alive until the pyramid is built.
+    auto source = vtkSmartPointer<vtkImageData>::New();
+    source->CopyStructure(image);
+    source->GetPointData()->SetScalars(array);
+    this->WorkerDone = false;
+    this->Worker = std::thread([this, source, brickSize]() {
+      this->PendingLevels = vtkInternals::BuildLevels(source, brickSize, this->CancelBuild);
+      this->WorkerDone = true;
+    });
+  }
+
+  /**
+   * Returns the pyramid built for `array`, or nullptr if it is not ready yet,
+   * in which case it is started in the background if no other pyramid is
+   * being built. Never waits for the worker.
+   */
+  vtkPyramid* GetPyramid(double cacheKey, vtkImageData* image, vtkDataArray* array, int brickSize)
+  {
+    if (this->Worker.joinable() && this->WorkerDone)
+    {
+      this->Wait();
+    }
+    auto iter = this->Pyramids.find(cacheKey);
+    if (iter != this->Pyramids.end() && iter->second.IsBuiltFrom(image, array, brickSize))
+    {
+      return iter->second.Levels.empty() ? nullptr : &iter->second;
+    }
+    if (!this->Worker.joinable())
+    {
+      this->StartPyramid(cacheKey, image, array, brickSize);
+    }
+    return nullptr;
+  }
+
+  /**
+   * Waits for the worker, if any, and collects the pyramid it built.
+   */
+  void Wait()
+  {
+    if (!this->Worker.joinable())
+    {
+      return;
+    }
+    this->Worker.join();
+    vtkPyramid& pyramid = this->Pyramids[this->PendingKey];
+    pyramid = this->Pending;
+    pyramid.Levels = std::move(this->PendingLevels);
+    pyramid.BuildTime.Modified();
+    this->PendingLevels.clear();
+  }
+
+  /**
+   * Stops the worker, if any, and drops the pyramid it was building.
+   */
+  void Cancel()
+  {
+    if (!this->Worker.joinable())
+    {
+      return;
+    }
+    this->CancelBuild = true;
+    this->Worker.join();
+    this->CancelBuild = false;
+    this->PendingLevels.clear();
+  }
+
+  static vtkImageData* GetBrickData(vtkLevel& level, vtkBrick& brick)
+  {
+    if (brick.Data == nullptr)
+    {
+      vtkImageData* image = level.Image;
+      vtkDataArray* array = image->GetPointData()->GetScalars();
+      int dims[3];
+      image->GetDimensions(dims);
+
+      auto data = vtkSmartPointer<vtkImageData>::New();
+      data->SetExtent(brick.Extent);
+      data->SetOrigin(image->GetOrigin());
+      data->SetSpacing(image->GetSpacing());
+      data->SetDirectionMatrix(image->GetDirectionMatrix());
+
+      vtkSmartPointer<vtkDataArray> values;
+      values.TakeReference(array->NewInstance());
+      values->SetName(array->GetName());
+      values->SetNumberOfComponents(array->GetNumberOfComponents());
+      values->SetNumberOfTuples(data->GetNumberOfPoints());
+
+      const size_t tupleSize =
+        static_cast<size_t>(array->GetNumberOfComponents()) * array->GetDataTypeSize();
+      const size_t rowSize = tupleSize * (brick.Extent[1] - brick.Extent[0] + 1);
+      const char* src = static_cast<const char*>(array->GetVoidPointer(0));
+      char* dst = static_cast<char*>(values->GetVoidPointer(0));
+      for (int k = brick.Extent[4]; k <= brick.Extent[5]; ++k)
+      {
+        for (int j = brick.Extent[2]; j <= brick.Extent[3]; ++j)
+        {
+          const vtkIdType offset =
+            brick.Extent[0] + dims[0] * (j + static_cast<vtkIdType>(dims[1]) * k);
+          memcpy(dst, src + offset * tupleSize, rowSize);
+          dst += rowSize;
+        }
+      }
+      data->GetPointData()->SetScalars(values);
+      brick.Data = data;
+    }
+    return brick.Data;
+  }
+
+private:
+  // Levels are added until the largest dimension is at most this.
+  static const int MinimumLevelSize = 16;
+
+  // Pyramid being built by Worker. The worker only writes PendingLevels.
+  double PendingKey = 0.0;
+  vtkPyramid Pending;
+  std::vector<vtkLevel> PendingLevels;
+  std::thread Worker;
+  std::atomic<bool> WorkerDone{ false };
+  // Set to stop the worker, checked while downsampling.
+  std::atomic<bool> CancelBuild{ false };
+
+  // Returns no levels when cancelled.
+  static std::vector<vtkLevel> BuildLevels(
+    vtkImageData* image, int brickSize, const std::atomic<bool>& cancel)
+  {
+    std::vector<vtkLevel> levels;
+    vtkImageData* current = image;
+    vtkDataArray* currentArray = image->GetPointData()->GetScalars();
+    int dims[3];
+    current->GetDimensions(dims);
+    while (*std::max_element(dims, dims + 3) > vtkInternals::MinimumLevelSize)
+    {
+      vtkLevel level;
+      level.Image = vtkDownsample(current, currentArray, cancel);
+      if (cancel)
+      {
+        return std::vector<vtkLevel>();
+      }
+      vtkInternals::BuildBricks(level, brickSize);
+      levels.push_back(level);
+
+      current = level.Image;
+      currentArray = current->GetPointData()->GetScalars();
+      current->GetDimensions(dims);
+    }
+    return levels;
+  }
+
+  static void BuildBricks(vtkLevel& level, int brickSize)
+  {
+    int dims[3];
+    level.Image->GetDimensions(dims);
+
+    // Bricks share their boundary points so that no cell is left out.
+    std::vector<int> starts[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      for (int start = 0;; start += brickSize - 1)
+      {
+        starts[axis].push_back(start);
+        if (start + brickSize - 1 >= dims[axis] - 1)
+        {
+          break;
+        }
+      }
+    }
+
+    for (int k : starts[2])
+    {
+      for (int j : starts[1])
+      {
+        for (int i : starts[0])
+        {
+          vtkBrick brick;
+          brick.Extent[0] = i;
+          brick.Extent[1] = std::min(i + brickSize - 1, dims[0] - 1);
+          brick.Extent[2] = j;
+          brick.Extent[3] = std::min(j + brickSize - 1, dims[1] - 1);
+          brick.Extent[4] = k;
+          brick.Extent[5] = std::min(k + brickSize - 1, dims[2] - 1);
+          brick.Range[0] = VTK_DOUBLE_MIN;
+          brick.Range[1] = VTK_DOUBLE_MAX;
+          level.Bricks.push_back(brick);
+        }
+      }
+    }
+
+    vtkDataArray* array = level.Image->GetPointData()->GetScalars();
+    if (array->GetNumberOfComponents() != 1)
+    {
+      return;
+    }
+    vtkSMPTools::For(0, static_cast<vtkIdType>(level.Bricks.size()),
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          vtkBrick& brick = level.Bricks[cc];
+          switch (array->GetDataType())
+          {
+            vtkTemplateMacro(vtkComputeBrickRange(static_cast<const VTK_TT*>(
+                                                    array->GetVoidPointer(0)),
+              dims, brick.Extent, brick.Range));
+          }
+        }
+      });
+  }
+};
+
 vtkStandardNewMacro(vtkImageVolumeRepresentation);
 //----------------------------------------------------------------------------
 vtkImageVolumeRepresentation::vtkImageVolumeRepresentation()
 {
   this->VolumeMapper = vtkMultiBlockVolumeMapper::New();
+  this->LODVolumeMapper = vtkPVBrickVolumeMapper::New();
   this->Property = vtkVolumeProperty::New();
 
   this->Actor = vtkPVLODVolume::New();
@@ -126,16 +577,22 @@ vtkImageVolumeRepresentation::vtkImageVolumeRepresentation()
 
   this->MapScalars = true;
   this->MultiComponentsMapping = false;
+
+  this->UseVolumeLOD = false;
+  this->VolumeLODBrickSize = 64;
+  this->Internals = new vtkImageVolumeRepresentation::vtkInternals();
 }
 
 //----------------------------------------------------------------------------
 vtkImageVolumeRepresentation::~vtkImageVolumeRepresentation()
 {
   this->VolumeMapper->Delete();
+  this->LODVolumeMapper->Delete();
   this->Property->Delete();
   this->Actor->Delete();
   this->OutlineSource->Delete();
   this->OutlineMapper->Delete();
+  delete this->Internals;
 }
 
 //----------------------------------------------------------------------------
@@ -186,6 +643,25 @@ int vtkImageVolumeRepresentation::ProcessViewRequest(
     this->VolumeMapper->SetInputConnection(volumeProducer);
     this->UpdateMapperParameters();
 
+    // Interactive renders may use the pyramid instead of the full volume. The
+    // pyramid is built in the background, starting with the first render, and
+    // the full volume is rendered until it is ready.
+    const bool useLOD =
+      inInfo->Has(vtkPVRenderView::USE_LOD()) && inInfo->Get(vtkPVRenderView::USE_LOD()) == 1;
+    if (this->UseVolumeLOD && useLOD && this->UpdateVolumeLOD(inInfo))
+    {
+      this->Actor->SetMapper(this->LODVolumeMapper);
+    }
+    else if (this->UseVolumeLOD && !useLOD)
+    {
+      vtkImageData* image =
+        vtkImageData::SafeDownCast(vtkPVRenderView::GetDeliveredPiece(inInfo, this, 0));
+      if (vtkDataArray* array = vtkGetVolumeLODArray(image, this->GetInputArrayInformation(0)))
+      {
+        this->Internals->GetPyramid(this->GetCacheKey(), image, array, this->VolumeLODBrickSize);
+      }
+    }
+
     vtkAlgorithmOutput* outlineProducer = vtkPVRenderView::GetPieceProducer(inInfo, this, 1);
     this->OutlineMapper->SetInputConnection(outlineProducer);
   }
@@ -319,6 +795,10 @@ void vtkImageVolumeRepresentation::UpdateMapperParameters()
       break;
   }
 
+  // The pyramid only has the selected point array.
+  this->LODVolumeMapper->SelectScalarArray(colorArrayName);
+  this->LODVolumeMapper->SetScalarMode(VTK_SCALAR_MODE_USE_POINT_FIELD_DATA);
+
   this->Actor->SetMapper(this->VolumeMapper);
   // this is necessary since volume mappers don't like empty arrays.
   this->Actor->SetVisibility(colorArrayName != NULL && colorArrayName[0] != 0);
@@ -331,6 +811,7 @@ void vtkImageVolumeRepresentation::UpdateMapperParameters()
       planes[i] = this->CroppingOrigin[i / 2] + this->WholeExtent[i] * this->CroppingScale[i / 2];
     }
     this->VolumeMapper->SetCroppingRegionPlanes(planes);
+    this->LODVolumeMapper->SetCroppingRegionPlanes(planes);
   }
 
   if (this->Property)
@@ -373,7 +854,128 @@ void vtkImageVolumeRepresentation::UpdateMapperParameters()
       mbMapper->SetVectorMode(mode);
       mbMapper->SetVectorComponent(comp);
     }
+    this->LODVolumeMapper->SetVectorMode(mode);
+    this->LODVolumeMapper->SetVectorComponent(comp);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkImageVolumeRepresentation::UpdateVolumeLOD(vtkInformation* inInfo)
+{
+  vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(inInfo->Get(vtkPVView::VIEW()));
+  vtkImageData* image =
+    vtkImageData::SafeDownCast(vtkPVRenderView::GetDeliveredPiece(inInfo, this, 0));
+  vtkDataArray* array = vtkGetVolumeLODArray(image, this->GetInputArrayInformation(0));
+  if (!view || !array)
+  {
+    return false;
+  }
+
+  auto& internals = *this->Internals;
+  auto pyramid =
+    internals.GetPyramid(this->GetCacheKey(), image, array, this->VolumeLODBrickSize);
+  if (!pyramid)
+  {
+    return false;
+  }
+
+  vtkRenderer* renderer = view->GetRenderer();
+  vtkMatrix4x4* matrix = this->Actor->GetMatrix();
+  auto getCorners = [matrix](vtkImageData* data, const int extent[6], double corners[8][3]) {
+    for (int cc = 0; cc < 8; ++cc)
+    {
+      double point[4] = { 0, 0, 0, 1 };
+      data->TransformIndexToPhysicalPoint(extent[(cc & 1) ? 1 : 0], extent[(cc & 2) ? 3 : 2],
+        extent[(cc & 4) ? 5 : 4], point);
+      matrix->MultiplyPoint(point, point);
+      std::copy(point, point + 3, corners[cc]);
+    }
+  };
+
+  // Pick the coarsest level with about as many voxels as pixels covered by the
+  // volume along its largest axis.
+  int extent[6];
+  double corners[8][3];
+  image->GetExtent(extent);
+  getCorners(image, extent, corners);
+  double displayBounds[4] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    renderer->SetWorldPoint(corners[cc][0], corners[cc][1], corners[cc][2], 1.0);
+    renderer->WorldToDisplay();
+    const double* display = renderer->GetDisplayPoint();
+    displayBounds[0] = std::min(displayBounds[0], display[0]);
+    displayBounds[1] = std::max(displayBounds[1], display[0]);
+    displayBounds[2] = std::min(displayBounds[2], display[1]);
+    displayBounds[3] = std::max(displayBounds[3], display[1]);
+  }
+  const int* size = renderer->GetSize();
+  const double footprint =
+    std::max(std::min(displayBounds[1] - displayBounds[0], static_cast<double>(size[0])),
+      std::min(displayBounds[3] - displayBounds[2], static_cast<double>(size[1])));
+  const double target = footprint * view->GetLODResolution();
+
+  std::vector<int> levelSizes;
+  for (const auto& pyramidLevel : pyramid->Levels)
+  {
+    int dims[3];
+    pyramidLevel.Image->GetDimensions(dims);
+    levelSizes.push_back(*std::max_element(dims, dims + 3));
+  }
+  auto& level = pyramid->Levels[vtkPVVolumeLODSelection::SelectLevel(levelSizes, target)];
+
+  // The mapper keeps the bricks of the level and their mappers, so that only
+  // their visibility changes with the camera and the transfer function.
+  if (internals.LODLevel != &level || internals.LODTime < pyramid->BuildTime)
+  {
+    // Only keep the brick images of the level being rendered.
+    for (auto& otherLevel : pyramid->Levels)
+    {
+      if (&otherLevel != &level)
+      {
+        for (auto& brick : otherLevel.Bricks)
+        {
+          brick.Data = nullptr;
+        }
+      }
+    }
+    this->LODVolumeMapper->SetNumberOfBricks(static_cast<int>(level.Bricks.size()));
+    internals.LODLevel = &level;
+    internals.LODTime.Modified();
+  }
+
+  // Hide bricks outside of the view frustum and, when compositing a single
+  // component, bricks that are fully transparent.
+  double planes[24];
+  renderer->GetActiveCamera()->GetFrustumPlanes(renderer->GetTiledAspectRatio(), planes);
+  vtkPiecewiseFunction* opacity = nullptr;
+  if (this->LODVolumeMapper->GetBlendMode() == vtkVolumeMapper::COMPOSITE_BLEND &&
+    this->Property->GetIndependentComponents() && array->GetNumberOfComponents() == 1)
+  {
+    opacity = this->Property->GetScalarOpacity(0);
+  }
+
+  bool anyVisible = false;
+  for (int cc = 0; cc < static_cast<int>(level.Bricks.size()); ++cc)
+  {
+    auto& brick = level.Bricks[cc];
+    getCorners(level.Image, brick.Extent, corners);
+    const bool visible = !vtkPVVolumeLODSelection::IsOutsideFrustum(corners, planes) &&
+      !(opacity && vtkPVVolumeLODSelection::IsTransparent(opacity, brick.Range));
+    if (visible && this->LODVolumeMapper->GetBrick(cc) == nullptr)
+    {
+      this->LODVolumeMapper->SetBrick(cc, vtkInternals::GetBrickData(level, brick));
+    }
+    this->LODVolumeMapper->SetBrickVisibility(cc, visible);
+    anyVisible = anyVisible || visible;
+  }
+
+  if (!anyVisible)
+  {
+    // nothing to render.
+    this->Actor->SetVisibility(0);
   }
+  return true;
 }
 
 //----------------------------------------------------------------------------
@@ -384,6 +986,8 @@ void vtkImageVolumeRepresentation::PrintSelf(ostream& os, vtkIndent indent)
      << ", " << this->CroppingOrigin[2] << endl;
   os << indent << "Cropping Scale: " << this->CroppingScale[0] << ", " << this->CroppingScale[1]
      << ", " << this->CroppingScale[2] << endl;
+  os << indent << "UseVolumeLOD: " << this->UseVolumeLOD << endl;
+  os << indent << "VolumeLODBrickSize: " << this->VolumeLODBrickSize << endl;
 }
 
 //***************************************************************************
@@ -514,6 +1118,7 @@ void vtkImageVolumeRepresentation::SetRequestedRenderMode(int mode)
   {
     mbMapper->SetRequestedRenderMode(mode);
   }
+  this->LODVolumeMapper->SetRequestedRenderMode(mode);
   this->Modified();
 }
 
@@ -521,12 +1126,14 @@ void vtkImageVolumeRepresentation::SetRequestedRenderMode(int mode)
 void vtkImageVolumeRepresentation::SetBlendMode(int blend)
 {
   this->VolumeMapper->SetBlendMode(static_cast<vtkVolumeMapper::BlendModes>(blend));
+  this->LODVolumeMapper->SetBlendMode(static_cast<vtkVolumeMapper::BlendModes>(blend));
 }
 
 //----------------------------------------------------------------------------
 void vtkImageVolumeRepresentation::SetCropping(int crop)
 {
   this->VolumeMapper->SetCropping(crop != 0);
+  this->LODVolumeMapper->SetCropping(crop != 0);
 }
 
 //----------------------------------------------------------------------------
@@ -30,6 +30,9 @@
  *    vtkImageData will be silently skipped.
  *
  * 2. In distributed mode, bounds on each rank as assumed to be non-overlapping.
+ *
+ * When UseVolumeLOD is enabled, interactive renders use a multi-resolution
+ * pyramid of bricks built from the volume on each rank, see SetUseVolumeLOD().
  */
 
 #ifndef vtkImageVolumeRepresentation_h
@@ -48,6 +51,7 @@ class vtkImplicitFunction;
 class vtkOutlineSource;
 class vtkPiecewiseFunction;
 class vtkPolyDataMapper;
+class vtkPVBrickVolumeMapper;
 class vtkPVLODVolume;
 class vtkVolumeMapper;
 class vtkVolumeProperty;
@@ -127,6 +131,38 @@ public:
   vtkGetVector3Macro(CroppingScale, double);
   //@}
 
+  //@{
+  /**
+   * When set, interactive renders use a pyramid of bricks built from the
+   * volume instead of the full resolution volume. Each level of the pyramid
+   * halves the resolution and is split in bricks, for which the scalar range
+   * is computed. The level rendered is the coarsest level with about as many
+   * voxels as pixels covered by the volume, scaled by
+   * vtkPVRenderView::GetLODResolution(). Only bricks in the view frustum are
+   * rendered and, when compositing a single component, bricks whose scalar
+   * range maps to zero opacity are skipped. The bricks of the level are
+   * kept by a vtkPVBrickVolumeMapper, so that skipping bricks does not
+   * upload the others again.
+   *
+   * The pyramid is built on a worker thread, starting with the first render
+   * after the data or the selected array changes, and is kept for each cached
+   * time step. Interactive renders use the full resolution volume until it is
+   * ready. Only point data arrays of vtkImageData inputs are supported.
+   * Default is false.
+   */
+  vtkSetMacro(UseVolumeLOD, bool);
+  vtkGetMacro(UseVolumeLOD, bool);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of points along each axis of the bricks of the
+   * pyramid used when UseVolumeLOD is set. Default is 64.
+   */
+  vtkSetClampMacro(VolumeLODBrickSize, int, 8, 1024);
+  vtkGetMacro(VolumeLODBrickSize, int);
+  //@}
+
   /**
    * Provides access to the actor used by this representation.
    */
@@ -162,6 +198,14 @@ protected:
    */
   virtual void UpdateMapperParameters();
 
+  /**
+   * Selects the level of the pyramid and its visible bricks for the
+   * interactive render request `inInfo` and passes them to LODVolumeMapper.
+   * Returns false if the pyramid cannot be used for the delivered data or is
+   * not built yet.
+   */
+  bool UpdateVolumeLOD(vtkInformation* inInfo);
+
   /**
    * Used in ConvertSelection to locate the rendered prop.
    */
@@ -169,6 +213,7 @@ protected:
 
   vtkSmartPointer<vtkDataObject> Cache;
   vtkVolumeMapper* VolumeMapper;
+  vtkPVBrickVolumeMapper* LODVolumeMapper;
   vtkVolumeProperty* Property;
   vtkPVLODVolume* Actor;
 
@@ -185,9 +230,15 @@ protected:
   double CroppingOrigin[3] = { 0, 0, 0 };
   double CroppingScale[3] = { 1, 1, 1 };
 
+  bool UseVolumeLOD;
+  int VolumeLODBrickSize;
+
 private:
   vtkImageVolumeRepresentation(const vtkImageVolumeRepresentation&) = delete;
   void operator=(const vtkImageVolumeRepresentation&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif
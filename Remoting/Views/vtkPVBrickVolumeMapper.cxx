@@ -0,0 +1,237 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVBrickVolumeMapper.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVBrickVolumeMapper.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkBoundingBox.h"
+#include "vtkCamera.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkObjectFactory.h"
+#include "vtkRenderer.h"
+#include "vtkSmartPointer.h"
+#include "vtkSmartVolumeMapper.h"
+#include "vtkVolume.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+class vtkPVBrickVolumeMapper::vtkInternals
+{
+public:
+  struct vtkBrick
+  {
+    vtkSmartPointer<vtkImageData> Data;
+    vtkSmartPointer<vtkSmartVolumeMapper> Mapper;
+    bool Visible = false;
+  };
+  std::vector<vtkBrick> Bricks;
+
+  vtkBrick* GetBrick(int index)
+  {
+    return index >= 0 && index < static_cast<int>(this->Bricks.size()) ? &this->Bricks[index]
+                                                                       : nullptr;
+  }
+};
+
+vtkStandardNewMacro(vtkPVBrickVolumeMapper);
+//----------------------------------------------------------------------------
+vtkPVBrickVolumeMapper::vtkPVBrickVolumeMapper()
+{
+  this->RequestedRenderMode = vtkSmartVolumeMapper::DefaultRenderMode;
+  this->VectorMode = vtkSmartVolumeMapper::DISABLED;
+  this->VectorComponent = 0;
+  this->Internals = new vtkPVBrickVolumeMapper::vtkInternals();
+}
+
+//----------------------------------------------------------------------------
+vtkPVBrickVolumeMapper::~vtkPVBrickVolumeMapper()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBrickVolumeMapper::SetNumberOfBricks(int count)
+{
+  this->Internals->Bricks.clear();
+  this->Internals->Bricks.resize(std::max(count, 0));
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkPVBrickVolumeMapper::GetNumberOfBricks()
+{
+  return static_cast<int>(this->Internals->Bricks.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBrickVolumeMapper::SetBrick(int index, vtkImageData* brick)
+{
+  auto item = this->Internals->GetBrick(index);
+  if (item == nullptr || item->Data == brick)
+  {
+    return;
+  }
+  item->Data = brick;
+  item->Mapper = nullptr;
+  if (brick)
+  {
+    item->Mapper = vtkSmartPointer<vtkSmartVolumeMapper>::New();
+    item->Mapper->SetInputData(brick);
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkImageData* vtkPVBrickVolumeMapper::GetBrick(int index)
+{
+  auto item = this->Internals->GetBrick(index);
+  return item ? item->Data.GetPointer() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBrickVolumeMapper::SetBrickVisibility(int index, bool visible)
+{
+  auto item = this->Internals->GetBrick(index);
+  if (item != nullptr && item->Visible != visible)
+  {
+    item->Visible = visible;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVBrickVolumeMapper::GetBrickVisibility(int index)
+{
+  auto item = this->Internals->GetBrick(index);
+  return item ? item->Visible : false;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBrickVolumeMapper::Render(vtkRenderer* ren, vtkVolume* vol)
+{
+  // Sort the visible bricks by the distance of their center to the camera.
+  double position[3];
+  ren->GetActiveCamera()->GetPosition(position);
+  vtkMatrix4x4* matrix = vol->GetMatrix();
+  std::vector<std::pair<double, vtkSmartVolumeMapper*> > mappers;
+  for (const auto& brick : this->Internals->Bricks)
+  {
+    if (!brick.Visible || brick.Mapper == nullptr)
+    {
+      continue;
+    }
+    double bounds[6];
+    brick.Data->GetBounds(bounds);
+    double center[4] = { (bounds[0] + bounds[1]) / 2, (bounds[2] + bounds[3]) / 2,
+      (bounds[4] + bounds[5]) / 2, 1.0 };
+    matrix->MultiplyPoint(center, center);
+    mappers.push_back(std::make_pair(
+      vtkMath::Distance2BetweenPoints(center, position), brick.Mapper.GetPointer()));
+  }
+  std::sort(mappers.begin(), mappers.end(),
+    [](const std::pair<double, vtkSmartVolumeMapper*>& a,
+      const std::pair<double, vtkSmartVolumeMapper*>& b) { return a.first > b.first; });
+
+  for (const auto& item : mappers)
+  {
+    this->ApplyParameters(item.second);
+    item.second->Render(ren, vol);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBrickVolumeMapper::ApplyParameters(vtkSmartVolumeMapper* mapper)
+{
+  mapper->SetBlendMode(this->BlendMode);
+  mapper->SetCropping(this->Cropping);
+  mapper->SetCroppingRegionPlanes(this->CroppingRegionPlanes);
+  mapper->SetCroppingRegionFlags(this->CroppingRegionFlags);
+  mapper->SetScalarMode(this->ScalarMode);
+  if (this->ArrayAccessMode == VTK_GET_ARRAY_BY_NAME)
+  {
+    mapper->SelectScalarArray(this->ArrayName);
+  }
+  else
+  {
+    mapper->SelectScalarArray(this->ArrayId);
+  }
+  mapper->SetRequestedRenderMode(this->RequestedRenderMode);
+  mapper->SetVectorMode(this->VectorMode);
+  mapper->SetVectorComponent(this->VectorComponent);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBrickVolumeMapper::ReleaseGraphicsResources(vtkWindow* window)
+{
+  for (const auto& brick : this->Internals->Bricks)
+  {
+    if (brick.Mapper)
+    {
+      brick.Mapper->ReleaseGraphicsResources(window);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+double* vtkPVBrickVolumeMapper::GetBounds()
+{
+  vtkBoundingBox bbox;
+  for (const auto& brick : this->Internals->Bricks)
+  {
+    if (brick.Data)
+    {
+      bbox.AddBounds(brick.Data->GetBounds());
+    }
+  }
+  if (bbox.IsValid())
+  {
+    bbox.GetBounds(this->Bounds);
+  }
+  else
+  {
+    vtkMath::UninitializeBounds(this->Bounds);
+  }
+  return this->Bounds;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVBrickVolumeMapper::FillInputPortInformation(int port, vtkInformation* info)
+{
+  if (!this->Superclass::FillInputPortInformation(port, info))
+  {
+    return 0;
+  }
+  info->Set(vtkAlgorithm::INPUT_IS_OPTIONAL(), 1);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBrickVolumeMapper::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  const auto& bricks = this->Internals->Bricks;
+  os << indent << "NumberOfBricks: " << bricks.size() << endl;
+  os << indent << "NumberOfVisibleBricks: "
+     << std::count_if(bricks.begin(), bricks.end(),
+          [](const vtkInternals::vtkBrick& brick) { return brick.Visible; })
+     << endl;
+  os << indent << "RequestedRenderMode: " << this->RequestedRenderMode << endl;
+  os << indent << "VectorMode: " << this->VectorMode << endl;
+  os << indent << "VectorComponent: " << this->VectorComponent << endl;
+}
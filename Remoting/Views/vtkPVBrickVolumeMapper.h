@@ -0,0 +1,124 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVBrickVolumeMapper.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVBrickVolumeMapper
+ * @brief   volume mapper for a set of bricks that can be shown or hidden.
+ *
+ * vtkPVBrickVolumeMapper renders bricks of a volume, each with its own
+ * vtkSmartVolumeMapper, sorted back to front as vtkMultiBlockVolumeMapper does.
+ * Unlike vtkMultiBlockVolumeMapper, which recreates all of its mappers when
+ * its input is modified, bricks are shown or hidden without recreating the
+ * mappers of the other bricks, and so without uploading them again.
+ *
+ * The mapper has no input: bricks are set using SetBrick(). It is used by
+ * vtkImageVolumeRepresentation to render the bricks of a level of its volume
+ * pyramid that are visible.
+ *
+ * @sa
+ * vtkMultiBlockVolumeMapper
+ */
+
+#ifndef vtkPVBrickVolumeMapper_h
+#define vtkPVBrickVolumeMapper_h
+
+#include "vtkRemotingViewsModule.h" // needed for exports
+#include "vtkVolumeMapper.h"
+
+class vtkImageData;
+class vtkSmartVolumeMapper;
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVBrickVolumeMapper : public vtkVolumeMapper
+{
+public:
+  static vtkPVBrickVolumeMapper* New();
+  vtkTypeMacro(vtkPVBrickVolumeMapper, vtkVolumeMapper);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Get/Set the number of bricks. Setting it removes all bricks.
+   */
+  void SetNumberOfBricks(int count);
+  int GetNumberOfBricks();
+  //@}
+
+  //@{
+  /**
+   * Get/Set the image of a brick. The mapper of the brick is recreated when
+   * its image changes.
+   */
+  void SetBrick(int index, vtkImageData* brick);
+  vtkImageData* GetBrick(int index);
+  //@}
+
+  //@{
+  /**
+   * Get/Set whether a brick is rendered. Bricks are hidden by default.
+   */
+  void SetBrickVisibility(int index, bool visible);
+  bool GetBrickVisibility(int index);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the render mode, vector mode and vector component of the
+   * vtkSmartVolumeMapper of each brick.
+   */
+  vtkSetMacro(RequestedRenderMode, int);
+  vtkGetMacro(RequestedRenderMode, int);
+  vtkSetMacro(VectorMode, int);
+  vtkGetMacro(VectorMode, int);
+  vtkSetMacro(VectorComponent, int);
+  vtkGetMacro(VectorComponent, int);
+  //@}
+
+  /**
+   * Renders the visible bricks, back to front.
+   */
+  void Render(vtkRenderer* ren, vtkVolume* vol) override;
+
+  void ReleaseGraphicsResources(vtkWindow*) override;
+
+  /**
+   * Returns the bounds of all bricks, visible or not, so that the bounds of
+   * the volume do not change when bricks are shown or hidden.
+   */
+  double* GetBounds() override;
+  using vtkVolumeMapper::GetBounds;
+
+protected:
+  vtkPVBrickVolumeMapper();
+  ~vtkPVBrickVolumeMapper() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  /**
+   * Passes the parameters of this mapper on to the mapper of a brick.
+   */
+  void ApplyParameters(vtkSmartVolumeMapper* mapper);
+
+  int RequestedRenderMode;
+  int VectorMode;
+  int VectorComponent;
+
+private:
+  vtkPVBrickVolumeMapper(const vtkPVBrickVolumeMapper&) = delete;
+  void operator=(const vtkPVBrickVolumeMapper&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -25,6 +25,8 @@
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
+
 //*****************************************************************************
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
@@ -115,7 +117,7 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
     {
       vtkLogF(
         TRACE, "SetDataObject %s (key=%g) : %p", repr->GetLogName().c_str(), cacheKey, (void*)data);
-      item->SetDataObject(data, this->Internals, cacheKey);
+      item->SetDataObject(data, this->Internals, cacheKey, this->GetKeepDeliveredData());
       if (trueSize > 0)
       {
         item->SetActualMemorySize(trueSize, cacheKey);
@@ -152,6 +154,15 @@ bool vtkPVDataDeliveryManager::HasPiece(vtkPVDataRepresentation* repr, bool low_
     this->Internals->GetItem(repr, low_res, port, /*create_if_needed=*/false);
   const auto cacheKey = this->GetCacheKey(repr);
   const bool val = item ? (item->GetDataObject(cacheKey) != nullptr) : false;
+  if (val)
+  {
+    item->Touch(cacheKey);
+    this->Internals->CacheHits += low_res ? 0 : 1;
+  }
+  else
+  {
+    this->Internals->CacheMisses += low_res ? 0 : 1;
+  }
 
   vtkLogF(TRACE, "HasPiece %s (key=%g) : %d", repr->GetLogName().c_str(), cacheKey, val);
   return val;
@@ -297,8 +308,88 @@ void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
   this->Internals->ClearCache(repr);
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkPVDataDeliveryManager::GetCacheSize()
+{
+  return this->Internals->GetCacheSize();
+}
+
+//----------------------------------------------------------------------------
+int vtkPVDataDeliveryManager::GetNumberOfCacheEntriesToEvict(unsigned long limit)
+{
+  unsigned long size = this->Internals->GetCacheSize();
+  if (size <= limit)
+  {
+    return 0;
+  }
+
+  int count = 0;
+  for (const auto& entry : this->Internals->GetEvictionCandidates(this))
+  {
+    if (size <= limit)
+    {
+      break;
+    }
+    size -= std::min(size, entry.ActualMemorySize);
+    ++count;
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::EvictCacheEntries(int count)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+
+  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "evict %d cache entries", count);
+  for (const auto& entry : this->Internals->GetEvictionCandidates(this))
+  {
+    if (count-- <= 0)
+    {
+      break;
+    }
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "evict key=%g (%lu KiB)", entry.CacheKey,
+      entry.ActualMemorySize);
+    entry.Item->Evict(entry.CacheKey);
+    ++this->Internals->CacheEvictions;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheHits() const
+{
+  return this->Internals->CacheHits;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheMisses() const
+{
+  return this->Internals->CacheMisses;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheEvictions() const
+{
+  return this->Internals->CacheEvictions;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::ResetCacheStatistics()
+{
+  this->Internals->CacheHits = 0;
+  this->Internals->CacheMisses = 0;
+  this->Internals->CacheEvictions = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheSize: " << this->Internals->GetCacheSize() << endl;
+  os << indent << "CacheHits: " << this->Internals->CacheHits << endl;
+  os << indent << "CacheMisses: " << this->Internals->CacheMisses << endl;
+  os << indent << "CacheEvictions: " << this->Internals->CacheEvictions << endl;
 }
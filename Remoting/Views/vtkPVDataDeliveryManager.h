@@ -107,6 +107,42 @@ public:
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  /**
+   * Returns the total memory size, in kibibytes, for all data objects
+   * currently held by the manager, including those for cache keys other
+   * than the current one.
+   */
+  unsigned long GetCacheSize();
+
+  /**
+   * Returns the number of cache entries that need to be evicted, in least
+   * recently used order, for the cache size to be within the limit
+   * (in kibibytes). Data for the current cache key of any representation is
+   * never considered for eviction.
+   */
+  int GetNumberOfCacheEntriesToEvict(unsigned long limit);
+
+  /**
+   * Evicts up to `count` cached entries in least recently used order.
+   * vtkPVView calls this method on all processes with the same count,
+   * generally obtained by reducing `GetNumberOfCacheEntriesToEvict` across
+   * all processes. This ensures all processes agree on which cache keys are
+   * still available.
+   */
+  void EvictCacheEntries(int count);
+
+  //@{
+  /**
+   * Cache statistics. A hit is recorded when a representation skips an update
+   * since data for the cache key is available, a miss when it is not.
+   * `ResetCacheStatistics` resets all counters.
+   */
+  vtkTypeUInt64 GetCacheHits() const;
+  vtkTypeUInt64 GetCacheMisses() const;
+  vtkTypeUInt64 GetCacheEvictions() const;
+  void ResetCacheStatistics();
+  //@}
+
   //@{
   /**
    * Provides access to the producer port for the geometry of a registered
@@ -169,6 +205,17 @@ public:
     return 0;
   }
 
+  /**
+   * When new data is set using `SetPiece`, the data delivered previously is
+   * generally discarded so that obsolete data is never rendered. Views that
+   * deliver data over several renders may override this method to return true
+   * instead, in which case the previously delivered data keeps being rendered
+   * until `MoveData` delivers the new data.
+   *
+   * Default implementation simply returns false.
+   */
+  virtual bool GetKeepDeliveredData() const { return false; }
+
 protected:
   vtkPVDataDeliveryManager();
   ~vtkPVDataDeliveryManager() override;
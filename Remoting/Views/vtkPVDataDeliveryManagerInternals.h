@@ -27,12 +27,14 @@
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <numeric>
 #include <queue>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 class vtkPVDataDeliveryManager::vtkInternals
 {
@@ -74,12 +76,17 @@ public:
     vtkMTimeType TimeStamp{ 0 };
     vtkMTimeType ActualMemorySize{ 0 };
 
+    // Used to pick least-recently-used entries when the cache exceeds its
+    // size limit.
+    vtkMTimeType LastAccessTime{ 0 };
+
     // Arbitrary meta-data container.
     vtkSmartPointer<vtkInformation> Information;
   };
 
   class vtkItem
   {
+    friend class vtkInternals;
     vtkNew<vtkPVTrivialProducer> Producer;
 
     // Store of data generated by the representation for rendering.
@@ -89,12 +96,16 @@ public:
 
     vtkMTimeType TimeStamp{ 0 };
 
+    // When true, the producer keeps its output until new data is delivered.
+    bool KeepDelivered{ false };
+
   public:
     vtkItem() {}
 
     void ClearCache() { this->Data.clear(); }
 
-    void SetDataObject(vtkDataObject* data, vtkInternals* helper, double cacheKey)
+    void SetDataObject(
+      vtkDataObject* data, vtkInternals* helper, double cacheKey, bool keepDelivered = false)
     {
       auto& store = this->Data[cacheKey];
       if (data)
@@ -107,26 +118,77 @@ public:
         store.DataObject = nullptr;
       }
 
-      store.DeliveredDataObjects.clear();
       store.ActualMemorySize = data ? data->GetActualMemorySize() : 0;
-      // This method gets called when data is entirely changed. That means that any
-      // data we may have delivered or redistributed would also be obsolete.
-      // Hence we reset the `Producer` as well. This avoids #2160.
-
-      // explanation for using a clone: typically, the Producer is connected by the
-      // representation to a rendering pipeline e.g. the mapper. As that could be the
-      // case, we need to ensure the producer's input is cleaned too. Setting simply nullptr
-      // could confuse the mapper and hence we setup a data object of the same type as the data.
-      // we could simply set the data too, but that can lead to other confusion as the mapper should
-      // never directly see the representation's data.
-      this->Producer->SetOutput(helper->GetEmptyDataObject(data));
+      this->KeepDelivered = keepDelivered && data != nullptr;
+      if (!this->KeepDelivered)
+      {
+        // This method gets called when data is entirely changed. That means that any
+        // data we may have delivered or redistributed would also be obsolete.
+        // Hence we reset the `Producer` as well. This avoids #2160.
+        // When keepDelivered is true, the obsolete data is rendered until the
+        // new data is delivered, which replaces it in SetDeliveredDataObject.
+
+        // explanation for using a clone: typically, the Producer is connected by the
+        // representation to a rendering pipeline e.g. the mapper. As that could be the
+        // case, we need to ensure the producer's input is cleaned too. Setting simply nullptr
+        // could confuse the mapper and hence we setup a data object of the same type as the
+        // data. we could simply set the data too, but that can lead to other confusion as the
+        // mapper should never directly see the representation's data.
+        store.DeliveredDataObjects.clear();
+        this->Producer->SetOutput(helper->GetEmptyDataObject(data));
+      }
 
       vtkTimeStamp ts;
       ts.Modified();
       store.TimeStamp = ts;
+      store.LastAccessTime = ts;
       this->TimeStamp = ts;
     }
 
+    /**
+     * Marks the entry for the cacheKey as recently used. This is used for LRU
+     * eviction of cached entries.
+     */
+    void Touch(double cacheKey)
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter != this->Data.end())
+      {
+        vtkTimeStamp ts;
+        ts.Modified();
+        iter->second.LastAccessTime = ts;
+      }
+    }
+
+    /**
+     * Removes the entry for the cacheKey. Returns the memory size for the
+     * removed entry.
+     */
+    unsigned long Evict(double cacheKey)
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter == this->Data.end())
+      {
+        return 0;
+      }
+      const unsigned long size = iter->second.ActualMemorySize;
+      this->Data.erase(iter);
+      return size;
+    }
+
+    /**
+     * Returns the total memory size for all entries in the cache.
+     */
+    unsigned long GetCacheSize() const
+    {
+      unsigned long size = 0;
+      for (const auto& pair : this->Data)
+      {
+        size += pair.second.ActualMemorySize;
+      }
+      return size;
+    }
+
     void SetActualMemorySize(unsigned long size, double cacheKey)
     {
       auto& store = this->Data[cacheKey];
@@ -162,6 +224,12 @@ public:
     {
       vtkDataObject* prev = this->Producer->GetOutputDataObject(0);
       vtkDataObject* cur = this->GetDeliveredDataObject(dataKey, cacheKey);
+      if (cur == nullptr && this->KeepDelivered)
+      {
+        // data for this cache key hasn't been delivered yet, keep rendering the
+        // data delivered previously.
+        return this->Producer.GetPointer();
+      }
       this->Producer->SetOutput(cur);
       if (cur != prev && cur != nullptr)
       {
@@ -205,6 +273,17 @@ public:
     }
   };
 
+  /**
+   * A reference to a cached entry that may be evicted.
+   */
+  struct vtkCacheEntry
+  {
+    vtkMTimeType LastAccessTime;
+    unsigned long ActualMemorySize;
+    vtkItem* Item;
+    double CacheKey;
+  };
+
   // First is repr unique id, second is the input port.
   typedef std::pair<unsigned int, int> ReprPortType;
   typedef std::map<ReprPortType, std::pair<vtkItem, vtkItem> > ItemsMapType;
@@ -292,8 +371,64 @@ public:
     }
   }
 
+  /**
+   * Returns the total memory size for all cached data, including the data for
+   * the current cache keys.
+   */
+  unsigned long GetCacheSize() const
+  {
+    unsigned long size = 0;
+    for (const auto& ipair : this->ItemsMap)
+    {
+      size += ipair.second.first.GetCacheSize() + ipair.second.second.GetCacheSize();
+    }
+    return size;
+  }
+
+  /**
+   * Returns the cached entries that may be evicted, sorted with the least
+   * recently used entry first. Entries for the cache key currently in use by
+   * the representation are never evicted.
+   */
+  std::vector<vtkCacheEntry> GetEvictionCandidates(vtkPVDataDeliveryManager* dmgr)
+  {
+    std::vector<vtkCacheEntry> candidates;
+    for (auto& ipair : this->ItemsMap)
+    {
+      auto riter = this->RepresentationsMap.find(ipair.first.first);
+      if (riter == this->RepresentationsMap.end() || riter->second == nullptr)
+      {
+        continue;
+      }
+
+      const double activeKey = dmgr->GetCacheKey(riter->second);
+      for (vtkItem* item : { &ipair.second.first, &ipair.second.second })
+      {
+        for (const auto& dpair : item->Data)
+        {
+          if (dpair.first != activeKey && dpair.second.DataObject != nullptr)
+          {
+            candidates.push_back(vtkCacheEntry{ dpair.second.LastAccessTime,
+              static_cast<unsigned long>(dpair.second.ActualMemorySize), item, dpair.first });
+          }
+        }
+      }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+      [](const vtkCacheEntry& a, const vtkCacheEntry& b) {
+        return a.LastAccessTime < b.LastAccessTime;
+      });
+    return candidates;
+  }
+
   ItemsMapType ItemsMap;
   RepresentationsMapType RepresentationsMap;
+
+  // Cache statistics.
+  vtkTypeUInt64 CacheHits{ 0 };
+  vtkTypeUInt64 CacheMisses{ 0 };
+  vtkTypeUInt64 CacheEvictions{ 0 };
 };
 
 #endif // __WRAP__
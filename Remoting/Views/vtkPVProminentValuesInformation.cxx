@@ -16,11 +16,13 @@
 
 #include "vtkAbstractArray.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkClientServerStream.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkExecutive.h"
@@ -34,12 +36,19 @@
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <vector>
@@ -49,6 +58,296 @@
 namespace
 {
 typedef std::map<int, std::set<std::vector<vtkVariant> > > vtkInternalDistinctValuesBase;
+
+//----------------------------------------------------------------------------
+// Open addressing hash set of fixed size tuples of a numeric type, using linear
+// probing. Keys are stored contiguously to avoid per-tuple allocations.
+template <typename ValueT>
+class vtkDistinctTupleSet
+{
+  static_assert(sizeof(ValueT) <= sizeof(std::uint64_t), "Unsupported value type.");
+
+public:
+  explicit vtkDistinctTupleSet(int tupleSize)
+    : TupleSize(tupleSize)
+    , Size(0)
+  {
+    this->Scratch.resize(tupleSize);
+    this->Allocate(16);
+  }
+
+  /**
+   * Inserts the tuple, returns true if it was not already in the set.
+   */
+  bool Insert(const ValueT* tuple)
+  {
+    // Canonicalize values comparing equal but having different bits (-0.0).
+    ValueT* key = this->Scratch.data();
+    for (int cc = 0; cc < this->TupleSize; ++cc)
+    {
+      key[cc] = tuple[cc] == ValueT(0) ? ValueT(0) : tuple[cc];
+    }
+
+    if (2 * (this->Size + 1) > this->Used.size())
+    {
+      this->Rehash(2 * this->Used.size());
+    }
+    return this->InsertCanonical(key);
+  }
+
+  size_t GetSize() const { return this->Size; }
+
+  /**
+   * Releases all keys.
+   */
+  void Clear()
+  {
+    this->Size = 0;
+    this->Allocate(16);
+  }
+
+  template <typename FunctorT>
+  void ForEach(FunctorT&& functor) const
+  {
+    for (size_t slot = 0; slot < this->Used.size(); ++slot)
+    {
+      if (this->Used[slot])
+      {
+        functor(&this->Keys[slot * this->TupleSize]);
+      }
+    }
+  }
+
+private:
+  std::uint64_t Hash(const ValueT* key) const
+  {
+    std::uint64_t hash = 0x9e3779b97f4a7c15ull;
+    for (int cc = 0; cc < this->TupleSize; ++cc)
+    {
+      std::uint64_t bits = 0;
+      memcpy(&bits, key + cc, sizeof(ValueT));
+      hash ^= bits + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+    // splitmix64 finalizer, so that small integers spread over all slots.
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31);
+  }
+
+  bool InsertCanonical(const ValueT* key)
+  {
+    const size_t mask = this->Used.size() - 1;
+    const size_t keySize = this->TupleSize * sizeof(ValueT);
+    for (size_t slot = static_cast<size_t>(this->Hash(key)) & mask;; slot = (slot + 1) & mask)
+    {
+      ValueT* slotKey = &this->Keys[slot * this->TupleSize];
+      if (!this->Used[slot])
+      {
+        memcpy(slotKey, key, keySize);
+        this->Used[slot] = 1;
+        ++this->Size;
+        return true;
+      }
+      if (memcmp(slotKey, key, keySize) == 0)
+      {
+        return false;
+      }
+    }
+  }
+
+  void Allocate(size_t capacity)
+  {
+    this->Keys.assign(capacity * this->TupleSize, ValueT(0));
+    this->Used.assign(capacity, 0);
+  }
+
+  void Rehash(size_t capacity)
+  {
+    std::vector<ValueT> keys;
+    std::vector<unsigned char> used;
+    keys.swap(this->Keys);
+    used.swap(this->Used);
+    this->Allocate(capacity);
+    this->Size = 0;
+    for (size_t slot = 0; slot < used.size(); ++slot)
+    {
+      if (used[slot])
+      {
+        this->InsertCanonical(&keys[slot * this->TupleSize]);
+      }
+    }
+  }
+
+  int TupleSize;
+  size_t Size;
+  std::vector<ValueT> Keys;
+  std::vector<unsigned char> Used;
+  std::vector<ValueT> Scratch;
+};
+
+//----------------------------------------------------------------------------
+// Collects the distinct values of each component of an array, and the distinct
+// tuples when the array has more than one component. Sets are indexed by
+// `component - FirstComponent`. A set is given up on as soon as it holds more
+// than `MaxNumberOfValues` values, and the traversal stops once all sets are
+// given up on.
+template <typename ArrayT>
+class vtkDistinctValuesFunctor
+{
+public:
+  using ValueT = typename vtkDataArrayAccessor<ArrayT>::APIType;
+  using SetT = vtkDistinctTupleSet<ValueT>;
+
+  vtkDistinctValuesFunctor(ArrayT* array, size_t maxNumberOfValues)
+    : Array(array)
+    , NumberOfComponents(array->GetNumberOfComponents())
+    , FirstComponent(array->GetNumberOfComponents() > 1 ? -1 : 0)
+    , MaxNumberOfValues(maxNumberOfValues)
+    , NumberOfOverflowedSets(0)
+  {
+    this->NumberOfSets = this->NumberOfComponents - this->FirstComponent;
+    this->Overflowed.reset(new std::atomic<bool>[this->NumberOfSets]);
+    for (int set = 0; set < this->NumberOfSets; ++set)
+    {
+      this->Overflowed[set] = false;
+    }
+  }
+
+  void Initialize()
+  {
+    std::vector<SetT>& sets = this->LocalSets.Local();
+    for (int set = 0; set < this->NumberOfSets; ++set)
+    {
+      sets.emplace_back(this->GetTupleSize(set));
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(this->Array);
+    std::vector<SetT>& sets = this->LocalSets.Local();
+    std::vector<ValueT> tuple(this->NumberOfComponents);
+    for (vtkIdType tidx = begin; tidx < end; ++tidx)
+    {
+      if (this->NumberOfOverflowedSets.load(std::memory_order_relaxed) == this->NumberOfSets)
+      {
+        return;
+      }
+      for (int cc = 0; cc < this->NumberOfComponents; ++cc)
+      {
+        tuple[cc] = accessor.Get(tidx, cc);
+      }
+      for (int set = 0; set < this->NumberOfSets; ++set)
+      {
+        if (!this->Overflowed[set].load(std::memory_order_relaxed) &&
+          sets[set].Insert(this->GetKey(tuple.data(), set)) &&
+          sets[set].GetSize() > this->MaxNumberOfValues)
+        {
+          this->SetOverflowed(set);
+          sets[set].Clear();
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (int set = 0; set < this->NumberOfSets; ++set)
+    {
+      this->Sets.emplace_back(this->GetTupleSize(set));
+    }
+    for (auto iter = this->LocalSets.begin(); iter != this->LocalSets.end(); ++iter)
+    {
+      std::vector<SetT>& sets = *iter;
+      for (int set = 0; set < this->NumberOfSets; ++set)
+      {
+        SetT& result = this->Sets[set];
+        sets[set].ForEach([&](const ValueT* key) {
+          if (!this->Overflowed[set] && result.Insert(key) &&
+            result.GetSize() > this->MaxNumberOfValues)
+          {
+            this->SetOverflowed(set);
+          }
+        });
+        sets[set].Clear();
+      }
+    }
+  }
+
+  /**
+   * Converts the distinct values to variants, one entry per component. The
+   * entry of a component with too many distinct values is left empty. Returns
+   * whether distinct values were found for the last component.
+   */
+  bool CopyTo(vtkInternalDistinctValuesBase& distinctValues) const
+  {
+    bool valid = false;
+    for (int set = 0; set < this->NumberOfSets; ++set)
+    {
+      auto& values = distinctValues[set + this->FirstComponent];
+      valid = !this->Overflowed[set] && this->Sets[set].GetSize() > 0;
+      if (!valid)
+      {
+        continue;
+      }
+      const int tupleSize = this->GetTupleSize(set);
+      std::vector<vtkVariant> tuple(tupleSize);
+      this->Sets[set].ForEach([&](const ValueT* key) {
+        for (int cc = 0; cc < tupleSize; ++cc)
+        {
+          tuple[cc] = vtkVariant(key[cc]);
+        }
+        values.insert(tuple);
+      });
+    }
+    return valid;
+  }
+
+private:
+  int GetTupleSize(int set) const
+  {
+    return set + this->FirstComponent < 0 ? this->NumberOfComponents : 1;
+  }
+
+  const ValueT* GetKey(const ValueT* tuple, int set) const
+  {
+    const int component = set + this->FirstComponent;
+    return component < 0 ? tuple : tuple + component;
+  }
+
+  void SetOverflowed(int set)
+  {
+    if (!this->Overflowed[set].exchange(true))
+    {
+      ++this->NumberOfOverflowedSets;
+    }
+  }
+
+  ArrayT* Array;
+  int NumberOfComponents;
+  int FirstComponent;
+  int NumberOfSets;
+  size_t MaxNumberOfValues;
+  std::unique_ptr<std::atomic<bool>[]> Overflowed;
+  std::atomic<int> NumberOfOverflowedSets;
+  vtkSMPThreadLocal<std::vector<SetT> > LocalSets;
+  std::vector<SetT> Sets;
+};
+
+struct vtkDistinctValuesWorker
+{
+  vtkInternalDistinctValuesBase* DistinctValues;
+  size_t MaxNumberOfValues;
+  bool Valid;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    vtkDistinctValuesFunctor<ArrayT> functor(array, this->MaxNumberOfValues);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+    this->Valid = functor.CopyTo(*this->DistinctValues);
+  }
+};
 }
 
 class vtkPVProminentValuesInformation::vtkInternalDistinctValues
@@ -331,6 +630,24 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
     this->DistinctValues = new vtkInternalDistinctValues;
   }
   int nc = this->GetNumberOfComponents();
+
+  // Numeric arrays are processed directly, in parallel, using hash sets of
+  // typed values.
+  vtkDataArray* dataArray = vtkDataArray::FastDownCast(array);
+  if (dataArray && nc > 0 && dataArray->GetNumberOfComponents() == nc)
+  {
+    vtkDistinctValuesWorker worker;
+    worker.DistinctValues = this->DistinctValues;
+    worker.MaxNumberOfValues = this->Force ? std::numeric_limits<size_t>::max()
+                                           : static_cast<size_t>(array->GetMaxDiscreteValues());
+    worker.Valid = false;
+    if (vtkArrayDispatch::Dispatch::Execute(dataArray, worker))
+    {
+      this->Valid = worker.Valid;
+      return;
+    }
+  }
+
   vtkNew<vtkVariantArray> cvalues;
   std::vector<vtkVariant> tuple;
   // bool tooManyValues;
@@ -589,7 +906,13 @@ void vtkPVProminentValuesInformation::AddDistinctValues(vtkPVProminentValuesInfo
     return;
   }
 
-  for (int i = 0; i <= this->NumberOfComponents; ++i)
+  // Values from other blocks and ranks are merged as vtkVariant tuples, as
+  // sent by CopyToStream, and not with the typed hash sets used to scan the
+  // arrays. This is cheap as long as there are at most MAX_DISCRETE_VALUES
+  // values per component, but when Force is set, large sets of values are
+  // streamed and merged value by value.
+  // Also merge the distinct tuples, stored as component -1.
+  for (int i = (this->NumberOfComponents > 1 ? -1 : 0); i < this->NumberOfComponents; ++i)
   {
     vtkInternalDistinctValues::iterator bit = info->DistinctValues->find(i);
     vtkInternalDistinctValues::mapped_type::iterator
@@ -65,6 +65,7 @@
 #include "vtkPVMaterialLibrary.h"
 #include "vtkPVOptions.h"
 #include "vtkPVRenderViewDataDeliveryManager.h"
+#include "vtkPVRenderingCostModel.h"
 #include "vtkPVServerInformation.h"
 #include "vtkPVSession.h"
 #include "vtkPVStreamingMacros.h"
@@ -143,6 +144,7 @@ public:
   int OSPRayCount;
   vtkNew<vtkFloatArray> ArrayHolder;
   vtkNew<vtkWindowToImageFilter> ZGrabber;
+  vtkPVRenderingCostModel CostModel;
 
   void RegisterSelectionProp(int id, vtkProp*, vtkPVDataRepresentation* rep)
   {
@@ -311,6 +313,8 @@ vtkStandardNewMacro(vtkPVRenderView);
 vtkInformationKeyMacro(vtkPVRenderView, USE_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, USE_OUTLINE_FOR_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, LOD_RESOLUTION, Double);
+vtkInformationKeyMacro(vtkPVRenderView, LOD_RENDER_TIME_BUDGET, Double);
+vtkInformationKeyMacro(vtkPVRenderView, LAST_LOD_RENDER_TIME, Double);
 vtkInformationKeyMacro(vtkPVRenderView, NEED_ORDERED_COMPOSITING, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, RENDER_EMPTY_IMAGES, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, REQUEST_STREAMING_UPDATE, Request);
@@ -348,6 +352,7 @@ vtkPVRenderView::vtkPVRenderView()
   this->StillRenderProcesses = vtkPVSession::NONE;
   this->InteractiveRenderProcesses = vtkPVSession::NONE;
   this->UsedLODForLastRender = false;
+  this->HasRenderedWithLOD = false;
   this->UseLODForInteractiveRender = false;
   this->UseDistributedRenderingForRender = false;
   this->UseDistributedRenderingForLODRender = false;
@@ -356,8 +361,16 @@ vtkPVRenderView::vtkPVRenderView()
   this->StillRenderImageReductionFactor = 1;
   this->InteractiveRenderImageReductionFactor = 2;
   this->RemoteRenderingThreshold = 0;
+  this->EffectiveRemoteRenderingThreshold = 0;
+  this->GeometrySize = 0;
+  this->LODGeometrySize = 0;
+  this->UseAdaptiveRemoteRendering = false;
+  this->UseIncrementalDelivery = false;
+  this->IncrementalDeliveryTimeBudget = 0.1;
   this->LODRenderingThreshold = 0;
   this->LODResolution = 0.5;
+  this->LODRenderTimeBudget = 0.0;
+  this->LastLODRenderTime = 0.0;
   this->UseOutlineForLODRendering = false;
   this->UseLightKit = false;
   this->Interactor = 0;
@@ -1288,6 +1301,9 @@ void vtkPVRenderView::Update()
   vtkTypeUInt64 gsize;
   this->AllReduce(lsize, gsize, vtkCommunicator::SUM_OP);
   const double geometry_size = gsize / 1024;
+  this->GeometrySize = geometry_size;
+  this->Internals->CostModel.AddUpdate();
+  this->UpdateEffectiveRemoteRenderingThreshold(/*using_lod=*/false);
 
   // cout << "Full Geometry size: " << geometry_size << endl;
   // Update decisions about lod-rendering and remote-rendering.
@@ -1343,6 +1359,11 @@ void vtkPVRenderView::UpdateLOD()
   {
     this->RequestInformation->Set(USE_OUTLINE_FOR_LOD(), 1);
   }
+  if (this->LODRenderTimeBudget > 0)
+  {
+    this->RequestInformation->Set(LOD_RENDER_TIME_BUDGET(), this->LODRenderTimeBudget);
+    this->RequestInformation->Set(LAST_LOD_RENDER_TIME(), this->LastLODRenderTime);
+  }
 
   // reset flags that representations set in REQUEST_UPDATE_LOD() pass.
   this->DistributedRenderingRequiredLOD = false;
@@ -1355,6 +1376,8 @@ void vtkPVRenderView::UpdateLOD()
   vtkTypeUInt64 gsize;
   this->AllReduce(lsize, gsize, vtkCommunicator::SUM_OP);
   const double geometry_size = gsize / 1024;
+  this->LODGeometrySize = geometry_size;
+  this->UpdateEffectiveRemoteRenderingThreshold(/*using_lod=*/true);
   // cout << "LOD Geometry size: " << geometry_size << endl;
 
   this->UseDistributedRenderingForLODRender =
@@ -1474,6 +1497,7 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   if (use_lod_rendering)
   {
     this->RequestInformation->Set(USE_LOD(), 1);
+    this->HasRenderedWithLOD = true;
   }
 
   // cout << "Using remote rendering: " << use_distributed_rendering << endl;
@@ -1602,6 +1626,18 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   if (!this->MakingSelection)
   {
     this->Timer->StopTimer();
+    if (use_lod_rendering)
+    {
+      this->LastLODRenderTime = this->Timer->GetElapsedTime();
+    }
+    if (this->UseAdaptiveRemoteRendering && !in_tile_display_mode && !in_cave_mode &&
+      vtkProcessModule::GetProcessType() == vtkProcessModule::PROCESS_CLIENT)
+    {
+      // On the client, remote renders include the image delivery.
+      this->Internals->CostModel.AddRenderSample(use_distributed_rendering,
+        use_lod_rendering ? this->LODGeometrySize : this->GeometrySize,
+        this->Timer->GetElapsedTime());
+    }
   }
 
   if (!this->MakingSelection)
@@ -1628,7 +1664,28 @@ void vtkPVRenderView::Deliver(int use_lod, unsigned int size, unsigned int* repr
   // remote-rendering related ivars from the client.
   this->SynchronizeForCollaboration();
 
+  const bool measure = this->UseAdaptiveRemoteRendering &&
+    vtkProcessModule::GetProcessType() == vtkProcessModule::PROCESS_CLIENT;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+
   this->Superclass::Deliver(use_lod, size, representation_ids);
+
+  timer->StopTimer();
+  if (measure)
+  {
+    auto dm = this->GetDeliveryManager();
+    vtkTypeUInt64 deliveredSize = 0;
+    for (unsigned int cc = 0; cc + 1 < size; cc += 2)
+    {
+      auto repr = dm->GetRepresentation(representation_ids[cc]);
+      auto piece = repr
+        ? dm->GetDeliveredPiece(repr, use_lod != 0, static_cast<int>(representation_ids[cc + 1]))
+        : nullptr;
+      deliveredSize += piece ? piece->GetActualMemorySize() : 0;
+    }
+    this->Internals->CostModel.AddDeliverySample(deliveredSize / 1024.0, timer->GetElapsedTime());
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -1979,7 +2036,7 @@ bool vtkPVRenderView::ShouldUseDistributedRendering(double geometry_size, bool u
       throw true;
     }
 
-    throw(this->RemoteRenderingThreshold <= geometry_size);
+    throw(this->EffectiveRemoteRenderingThreshold <= geometry_size);
   }
   catch (bool val)
   {
@@ -2012,6 +2069,53 @@ bool vtkPVRenderView::ShouldUseDistributedRendering(double geometry_size, bool u
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderView::UpdateEffectiveRemoteRenderingThreshold(bool using_lod)
+{
+  this->EffectiveRemoteRenderingThreshold = this->RemoteRenderingThreshold;
+  if (!this->UseAdaptiveRemoteRendering)
+  {
+    return;
+  }
+
+  // Only the client has the measurements. Other processes contribute 0, and
+  // the client 0 when it cannot estimate the threshold yet, so that all
+  // processes make the same decision. Until a remote render has been
+  // measured, the threshold is set to 0 once local renders have been, so
+  // that the next render is remote and can be measured.
+  const auto& model = this->Internals->CostModel;
+  vtkTypeUInt64 local = 0;
+  if (vtkProcessModule::GetProcessType() == vtkProcessModule::PROCESS_CLIENT)
+  {
+    if (model.IsReady())
+    {
+      const bool remote = using_lod ? this->UseDistributedRenderingForLODRender
+                                    : this->UseDistributedRenderingForRender;
+      // images are delivered as RGB.
+      const double imageSize = 3.0 * this->Size[0] * this->Size[1] / (1024.0 * 1024.0);
+      const double threshold = model.GetThreshold(remote, imageSize);
+      local = static_cast<vtkTypeUInt64>(threshold * 1024) + 1;
+    }
+    else if (model.NeedsRemoteProbe())
+    {
+      local = 1;
+    }
+  }
+  vtkTypeUInt64 global = 0;
+  this->AllReduce(local, global, vtkCommunicator::MAX_OP);
+  if (global > 0)
+  {
+    this->EffectiveRemoteRenderingThreshold = (global - 1) / 1024.0;
+  }
+
+  vtkTimerLog::FormatAndMarkEvent("Adaptive remote rendering threshold (lod: %d): %g MB "
+                                  "(delivery: %g MB/s, local render: %g s/MB, remote render: %g s)",
+    using_lod ? 1 : 0, this->EffectiveRemoteRenderingThreshold, model.DeliveryBandwidth,
+    model.LocalRenderRate, model.RemoteRenderTime);
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "adaptive remote rendering threshold=%g MB (lod=%d)",
+    this->EffectiveRemoteRenderingThreshold, using_lod ? 1 : 0);
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVRenderView::ShouldUseLODRendering(double geometry_size)
 {
@@ -238,6 +238,52 @@ public:
   vtkGetMacro(RemoteRenderingThreshold, double);
   //@}
 
+  //@{
+  /**
+   * When set to true, the remote rendering threshold is derived from the
+   * geometry delivery bandwidth and the local and remote render times
+   * measured on the client, instead of using RemoteRenderingThreshold.
+   * RemoteRenderingThreshold is used until the first render is measured. If
+   * that render is local, the next update renders remotely once to measure
+   * remote renders. If it is remote, local rendering is tried once when the
+   * geometry is small enough that it could be cheaper, assuming free local
+   * renders and a delivery bandwidth estimated from the delivered images.
+   * The threshold picked is reported in the timer log.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(UseAdaptiveRemoteRendering, bool);
+  vtkGetMacro(UseAdaptiveRemoteRendering, bool);
+  //@}
+
+  /**
+   * Returns the remote rendering threshold, in megabytes, used for the last
+   * Update() or UpdateLOD().
+   */
+  vtkGetMacro(EffectiveRemoteRenderingThreshold, double);
+
+  //@{
+  /**
+   * When set to true, geometry is delivered incrementally: each render only
+   * delivers the geometry of as many representations as fit in
+   * IncrementalDeliveryTimeBudget (at least one) and representations whose
+   * geometry is still pending keep rendering the geometry delivered
+   * previously. Further renders deliver the remaining geometry. Images
+   * captured with vtkSMViewProxy::CaptureImage always wait for all geometry.
+   * This is only used on the client, by vtkSMDataDeliveryManagerProxy.
+   */
+  vtkSetMacro(UseIncrementalDelivery, bool);
+  vtkGetMacro(UseIncrementalDelivery, bool);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the time, in seconds, spent delivering geometry before a render
+   * when UseIncrementalDelivery is true. Default is 0.1.
+   */
+  vtkSetClampMacro(IncrementalDeliveryTimeBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(IncrementalDeliveryTimeBudget, double);
+  //@}
+
   //@{
   /**
    * Get/Set the data-size in megabytes above which LOD rendering should be
@@ -270,6 +316,19 @@ public:
   vtkGetMacro(UseOutlineForLODRendering, bool);
   //@}
 
+  //@{
+  /**
+   * Get/Set the time, in seconds, an interactive render using LOD should take.
+   * Representations that keep several levels of detail use it, together with
+   * the time taken by the last LOD render, to pick the level to render. 0
+   * (default) disables this and the level corresponding to LODResolution is
+   * always used.
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(LODRenderTimeBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(LODRenderTimeBudget, double);
+  //@}
+
   /**
    * Passes the compressor configuration to the client-server synchronizer, if
    * any. This affects the image compression used to relay images back to the
@@ -317,6 +376,16 @@ public:
    */
   static vtkInformationIntegerKey* USE_OUTLINE_FOR_LOD();
 
+  //@{
+  /**
+   * Indicate the LOD render time budget and the time taken by the last render
+   * using LOD, in seconds, in REQUEST_UPDATE_LOD() pass. Only set when
+   * LODRenderTimeBudget is not 0.
+   */
+  static vtkInformationDoubleKey* LOD_RENDER_TIME_BUDGET();
+  static vtkInformationDoubleKey* LAST_LOD_RENDER_TIME();
+  //@}
+
   /**
    * Representation can publish this key in their REQUEST_INFORMATION()
    * pass to indicate that the representation needs to disable
@@ -427,6 +496,15 @@ public:
   vtkGetMacro(UsedLODForLastRender, bool);
   //@}
 
+  //@{
+  /**
+   * Returns true once the view has rendered using LOD, i.e. after the first
+   * interactive render of data above LODRenderingThreshold. Representations
+   * use it to only prepare levels of detail in views that render them.
+   */
+  vtkGetMacro(HasRenderedWithLOD, bool);
+  //@}
+
   /**
    * Invalidates cached selection. Called explicitly when view proxy thinks the
    * cache may have become obsolete.
@@ -1026,6 +1104,14 @@ protected:
    */
   bool ShouldUseDistributedRendering(double geometry_size, bool using_lod);
 
+  /**
+   * Updates EffectiveRemoteRenderingThreshold. When UseAdaptiveRemoteRendering
+   * is true, the client estimates the threshold and shares it with all
+   * processes, hence this must be called on all processes. \c using_lod
+   * has the same meaning as in ShouldUseDistributedRendering.
+   */
+  void UpdateEffectiveRemoteRenderingThreshold(bool using_lod);
+
   /**
    * Returns true if LOD rendering should be used based on the geometry size.
    */
@@ -1155,7 +1241,13 @@ protected:
 
   // In mega-bytes.
   double RemoteRenderingThreshold;
+  double EffectiveRemoteRenderingThreshold;
   double LODRenderingThreshold;
+  double GeometrySize;
+  double LODGeometrySize;
+  bool UseAdaptiveRemoteRendering;
+  bool UseIncrementalDelivery;
+  double IncrementalDeliveryTimeBudget;
   vtkBoundingBox GeometryBounds;
 
   bool UseInteractiveRenderingForScreenshots;
@@ -1166,9 +1258,12 @@ protected:
   vtkNew<vtkFXAAOptions> FXAAOptions;
 
   double LODResolution;
+  double LODRenderTimeBudget;
+  double LastLODRenderTime;
   bool UseLightKit;
 
   bool UsedLODForLastRender;
+  bool HasRenderedWithLOD;
   bool UseLODForInteractiveRender;
   bool UseOutlineForLODRendering;
   bool UseDistributedRenderingForRender;
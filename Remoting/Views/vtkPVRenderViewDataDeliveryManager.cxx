@@ -15,6 +15,7 @@
 #include "vtkPVRenderViewDataDeliveryManager.h"
 #include "vtkPVDataDeliveryManagerInternals.h"
 
+#include "vtkCommunicator.h"
 #include "vtkDIYKdTreeUtilities.h"
 #include "vtkExtentTranslator.h"
 #include "vtkInformation.h"
@@ -294,7 +295,7 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
     {
       auto repr = this->GetRepresentation(iter->first.first);
       const auto cacheKey = this->GetCacheKey(repr);
-      vtkInternals::vtkItem& item = iter->second.first;
+      vtkInternals::vtkItem& item = low_res ? iter->second.second : iter->second.first;
       auto info = item.GetPieceInformation(cacheKey);
       const int mode = this->GetViewDataDistributionMode(low_res);
       if (this->Internals->IsRepresentationVisible(iter->first.first))
@@ -302,8 +303,21 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
         const int config = vtkPVRVDMKeys::GetOrderedCompositingConfiguration(info);
         if ((config & vtkPVRenderView::USE_DATA_FOR_LOAD_BALANCING) != 0)
         {
-          token_stream << ";a" << iter->first.first << "=" << item.GetTimeStamp(cacheKey);
-          data_for_loadbalacing.push_back(item.GetDeliveredDataObject(mode, cacheKey));
+          // Use the geometry signature, when available, so that changes
+          // affecting attributes alone don't require new cuts.
+          auto data = item.GetDeliveredDataObject(mode, cacheKey);
+          const vtkTypeUInt64 signature =
+            this->GetRedistributor(iter->first, low_res)->GetGeometrySignature(data);
+          token_stream << ";a" << iter->first.first << "=";
+          if (signature != 0)
+          {
+            token_stream << "g" << signature;
+          }
+          else
+          {
+            token_stream << item.GetTimeStamp(cacheKey);
+          }
+          data_for_loadbalacing.push_back(data);
         }
         else if ((config & vtkPVRenderView::USE_BOUNDS_FOR_REDISTRIBUTION) != 0)
         {
@@ -325,7 +339,16 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
       }
     }
 
-    if (this->LastCutsGeneratorToken != token_stream.str())
+    // Geometry signatures are local, so all ranks must agree on regenerating
+    // the cuts.
+    int tokenChanged = this->LastCutsGeneratorToken != token_stream.str() ? 1 : 0;
+    if (controller && num_ranks > 1)
+    {
+      int anyTokenChanged = 0;
+      controller->AllReduce(&tokenChanged, &anyTokenChanged, 1, vtkCommunicator::MAX_OP);
+      tokenChanged = anyTokenChanged;
+    }
+    if (tokenChanged)
     {
       if (use_explicit_bounds)
       {
@@ -410,17 +433,24 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
       {
         item.SetDeliveredDataObject(REDISTRIBUTED_DATA_KEY, cacheKey, nullptr);
         vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "redistribute: %s", debugName.c_str());
-        vtkNew<vtkOrderedCompositeDistributor> redistributor;
-        redistributor->SetController(vtkMultiProcessController::GetGlobalController());
+        auto redistributor = this->GetRedistributor(iter->first, low_res);
         redistributor->SetInputData(deliveredDataObject);
         redistributor->SetCuts(this->Cuts);
         redistributor->SetBoundaryMode(info->Has(vtkPVRVDMKeys::REDISTRIBUTION_MODE())
             ? info->Get(vtkPVRVDMKeys::REDISTRIBUTION_MODE())
             : vtkOrderedCompositeDistributor::SPLIT_BOUNDARY_CELLS);
         redistributor->Update();
+        if (redistributor->GetRedistributionPlanReused())
+        {
+          vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "only attributes were redistributed");
+        }
         // TODO: give representation a change to "cleanup" redistributed data
-        item.SetDeliveredDataObject(
-          REDISTRIBUTED_DATA_KEY, cacheKey, redistributor->GetOutputDataObject(0));
+        // The output is copied since the distributor is reused.
+        vtkSmartPointer<vtkDataObject> output;
+        output.TakeReference(redistributor->GetOutputDataObject(0)->NewInstance());
+        output->ShallowCopy(redistributor->GetOutputDataObject(0));
+        redistributor->SetInputData(nullptr);
+        item.SetDeliveredDataObject(REDISTRIBUTED_DATA_KEY, cacheKey, output);
         anything_moved = true;
       }
     }
@@ -430,6 +460,33 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
   {
     vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "no redistribution was done.");
   }
+
+  // Release distributors for representations that are gone.
+  for (auto riter = this->Redistributors.begin(); riter != this->Redistributors.end();)
+  {
+    if (this->Internals->ItemsMap.find(riter->first.first) == this->Internals->ItemsMap.end())
+    {
+      riter = this->Redistributors.erase(riter);
+    }
+    else
+    {
+      ++riter;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkOrderedCompositeDistributor* vtkPVRenderViewDataDeliveryManager::GetRedistributor(
+  const std::pair<unsigned int, int>& key, bool low_res)
+{
+  auto& redistributor = this->Redistributors[RedistributorKeyType(key, low_res)];
+  if (redistributor == nullptr)
+  {
+    redistributor = vtkSmartPointer<vtkOrderedCompositeDistributor>::New();
+    redistributor->SetController(vtkMultiProcessController::GetGlobalController());
+    redistributor->SetUseRedistributionPlan(true);
+  }
+  return redistributor;
 }
 
 //----------------------------------------------------------------------------
@@ -583,6 +640,13 @@ int vtkPVRenderViewDataDeliveryManager::GetDeliveredDataKey(bool low_res) const
                                                    : this->GetViewDataDistributionMode(low_res);
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVRenderViewDataDeliveryManager::GetKeepDeliveredData() const
+{
+  auto view = vtkPVRenderView::SafeDownCast(this->GetView());
+  return view != nullptr && view->GetUseIncrementalDelivery();
+}
+
 //----------------------------------------------------------------------------
 int vtkPVRenderViewDataDeliveryManager::GetMoveMode(vtkInformation* info, int viewMode) const
 {
@@ -35,9 +35,12 @@ class vtkDataObject;
 class vtkExtentTranslator;
 class vtkInformation;
 class vtkMatrix4x4;
+class vtkOrderedCompositeDistributor;
 class vtkPVDataRepresentation;
 class vtkPVView;
 
+#include <map>     // for std::map
+#include <utility> // for std::pair
 #include <vector>
 
 class VTKREMOTINGVIEWS_EXPORT vtkPVRenderViewDataDeliveryManager : public vtkPVDataDeliveryManager
@@ -161,6 +164,12 @@ public:
 
   int GetDeliveredDataKey(bool low_res) const override;
 
+  /**
+   * Returns true when the view uses incremental delivery, see
+   * vtkPVRenderView::SetUseIncrementalDelivery().
+   */
+  bool GetKeepDeliveredData() const override;
+
   //@{
   /**
    * Provides access to the "cuts" built by this class when doing ordered
@@ -188,6 +197,13 @@ protected:
   std::string LastCutsGeneratorToken;
   bool UseRedistributedDataAsDeliveredData = false;
 
+  // Distributors for each representation port and resolution. They are kept
+  // so that their redistribution plan can be reused when only attributes change.
+  typedef std::pair<std::pair<unsigned int, int>, bool> RedistributorKeyType;
+  std::map<RedistributorKeyType, vtkSmartPointer<vtkOrderedCompositeDistributor> > Redistributors;
+  vtkOrderedCompositeDistributor* GetRedistributor(
+    const std::pair<unsigned int, int>& key, bool low_res);
+
 private:
   vtkPVRenderViewDataDeliveryManager(const vtkPVRenderViewDataDeliveryManager&) = delete;
   void operator=(const vtkPVRenderViewDataDeliveryManager&) = delete;
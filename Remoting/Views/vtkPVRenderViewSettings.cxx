@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPVRenderViewSettings.h"
 
+#include "vtkMPIMoveData.h"
 #include "vtkMapper.h"
 #include "vtkObjectFactory.h"
 
@@ -111,6 +112,22 @@ void vtkPVRenderViewSettings::SetZShift(double val)
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetUseLZ4DataCompression(bool val)
+{
+  if (vtkMPIMoveData::GetUseLZ4Compression() != val)
+  {
+    vtkMPIMoveData::SetUseLZ4Compression(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVRenderViewSettings::GetUseLZ4DataCompression()
+{
+  return vtkMPIMoveData::GetUseLZ4Compression();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderViewSettings::PrintSelf(ostream& os, vtkIndent indent)
 {
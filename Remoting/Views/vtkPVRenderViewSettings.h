@@ -102,6 +102,15 @@ public:
   vtkGetMacro(DisableIceT, bool);
   //@}
 
+  //@{
+  /**
+   * When set, datasets moved between processes as raw array buffers are
+   * compressed using LZ4 (see vtkMPIMoveData::SetUseLZ4Compression).
+   */
+  void SetUseLZ4DataCompression(bool);
+  bool GetUseLZ4DataCompression();
+  //@}
+
 protected:
   vtkPVRenderViewSettings();
   ~vtkPVRenderViewSettings() override;
@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVRenderingCostModel.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkPVRenderingCostModel
+ *
+ * Running estimates, measured on the client, of the cost of delivering
+ * geometry to the client and of rendering it locally or remotely. They are
+ * used by vtkPVRenderView to pick the remote rendering threshold when
+ * adaptive remote rendering is enabled.
+ */
+
+#ifndef vtkPVRenderingCostModel_h
+#define vtkPVRenderingCostModel_h
+#ifndef __VTK_WRAP__
+
+#include <algorithm> // for std::max
+
+class vtkPVRenderingCostModel
+{
+public:
+  // Bandwidth, in MB/s, of geometry delivery to the client.
+  double DeliveryBandwidth = 0.0;
+  // Time, in seconds per MB of geometry, to render locally.
+  double LocalRenderRate = 0.0;
+  // Time, in seconds, of a remote render including image delivery.
+  double RemoteRenderTime = 0.0;
+  // Number of renders between updates.
+  double RendersPerUpdate = 1.0;
+  int RendersSinceUpdate = 0;
+
+  void AddDeliverySample(double size, double seconds)
+  {
+    // Small deliveries are dominated by latency.
+    if (size >= 1.0 && seconds > 0)
+    {
+      Accumulate(this->DeliveryBandwidth, size / seconds);
+    }
+  }
+
+  void AddRenderSample(bool remote, double size, double seconds)
+  {
+    if (remote)
+    {
+      Accumulate(this->RemoteRenderTime, seconds);
+    }
+    else if (size >= 1.0)
+    {
+      Accumulate(this->LocalRenderRate, seconds / size);
+    }
+    ++this->RendersSinceUpdate;
+  }
+
+  void AddUpdate()
+  {
+    if (this->RendersSinceUpdate > 0)
+    {
+      Accumulate(this->RendersPerUpdate, this->RendersSinceUpdate);
+    }
+    this->RendersSinceUpdate = 0;
+  }
+
+  // A threshold can be estimated once a remote render has been measured.
+  bool IsReady() const { return this->RemoteRenderTime > 0; }
+
+  // When only local renders have been measured, a remote render is needed to
+  // estimate the threshold. Remote renders are cheap to try, unlike local
+  // renders which require delivering all the geometry to the client.
+  bool NeedsRemoteProbe() const { return this->RemoteRenderTime <= 0 && this->LocalRenderRate > 0; }
+
+  // Returns the geometry size, in MB, above which rendering remotely is
+  // cheaper than delivering the geometry once and rendering it locally for
+  // the expected number of renders. The threshold is moved away from the
+  // current mode so that the decision does not flip on small changes.
+  //
+  // Until geometry has been delivered, the delivery bandwidth is estimated
+  // from the images, of `imageSize` MB, delivered by remote renders. This
+  // underestimates it, since remote renders also include rendering.
+  //
+  // Until a local render has been measured, local rendering is assumed to be
+  // free. The threshold is then the largest geometry that could be worth
+  // rendering locally: below it, the next render is local, which measures the
+  // local render rate, and the delivery bandwidth, at the cost of at most one
+  // update's worth of remote renders. Above it, rendering remotely is cheaper
+  // whatever the local render rate.
+  double GetThreshold(bool remote, double imageSize) const
+  {
+    const double bandwidth = this->DeliveryBandwidth > 0
+      ? this->DeliveryBandwidth
+      : std::max(imageSize, 1e-3) / this->RemoteRenderTime;
+    const double localRate = std::max(this->LocalRenderRate, 0.0);
+    const double renders = std::max(this->RendersPerUpdate, 1.0);
+    const double threshold =
+      renders * this->RemoteRenderTime / (1.0 / bandwidth + renders * localRate);
+    return remote ? threshold * 0.8 : threshold * 1.25;
+  }
+
+private:
+  static void Accumulate(double& estimate, double sample)
+  {
+    estimate = estimate > 0 ? 0.75 * estimate + 0.25 * sample : sample;
+  }
+};
+
+#endif // __VTK_WRAP__
+#endif
+// VTK-HeaderTest-Exclude: vtkPVRenderingCostModel.h
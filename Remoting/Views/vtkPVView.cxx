@@ -212,6 +212,7 @@ vtkPVView::vtkPVView(bool create_render_window)
   this->ViewTime = 0.0;
   this->CacheKey = 0.0;
   this->UseCache = false;
+  this->CacheSizeLimit = 0;
 
   this->RequestInformation = vtkInformation::New();
   this->ReplyInformationVector = vtkInformationVector::New();
@@ -428,6 +429,13 @@ void vtkPVView::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ViewTime: " << this->ViewTime << endl;
   os << indent << "CacheKey: " << this->CacheKey << endl;
   os << indent << "UseCache: " << this->UseCache << endl;
+  os << indent << "CacheSizeLimit: " << this->CacheSizeLimit << endl;
+  if (this->DeliveryManager)
+  {
+    os << indent << "CacheHits: " << this->DeliveryManager->GetCacheHits() << endl;
+    os << indent << "CacheMisses: " << this->DeliveryManager->GetCacheMisses() << endl;
+    os << indent << "CacheEvictions: " << this->DeliveryManager->GetCacheEvictions() << endl;
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -478,9 +486,36 @@ void vtkPVView::Update()
     this->SynchronizeRepresentationTemporalPipelineStates();
   }
 
+  this->EnforceCacheSizeLimit();
   this->UpdateTimeStamp.Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVView::EnforceCacheSizeLimit()
+{
+  if (!this->UseCache || this->CacheSizeLimit == 0)
+  {
+    return;
+  }
+
+  // Cache sizes differ across ranks, but all ranks see the same sequence of
+  // cache accesses. Evicting the same number of least recently used entries
+  // everywhere ensures that all ranks agree on which cache keys are
+  // available, and hence which representations need to update.
+  const vtkTypeUInt64 local = this->DeliveryManager
+    ? static_cast<vtkTypeUInt64>(
+        this->DeliveryManager->GetNumberOfCacheEntriesToEvict(this->CacheSizeLimit))
+    : 0;
+  vtkTypeUInt64 global = 0;
+  this->AllReduce(local, global, vtkCommunicator::MAX_OP);
+  if (global > 0 && this->DeliveryManager)
+  {
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: cache exceeds limit (%lu KiB)",
+      this->GetLogName().c_str(), this->CacheSizeLimit);
+    this->DeliveryManager->EvictCacheEntries(static_cast<int>(global));
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVView::SynchronizeRepresentationTemporalPipelineStates()
 {
@@ -120,6 +120,17 @@ public:
   vtkGetMacro(UseCache, bool);
   //@}
 
+  //@{
+  /**
+   * Get/Set the memory limit, in kibibytes, for the data cached by this view
+   * on any rank when caching is enabled. When the limit is exceeded, least
+   * recently used cache entries are evicted. 0 (default) implies no limit.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(CacheSizeLimit, unsigned long);
+  vtkGetMacro(CacheSizeLimit, unsigned long);
+  //@}
+
   //@{
   /**
    * These methods are used to setup the view for capturing screen shots.
@@ -362,6 +373,7 @@ protected:
   double ViewTime;
   double CacheKey;
   bool UseCache;
+  unsigned long CacheSizeLimit;
 
   int Size[2];
   int Position[2];
@@ -384,6 +396,12 @@ private:
    */
   void SynchronizeRepresentationTemporalPipelineStates();
 
+  /**
+   * Evicts cached data, consistently on all processes, so that the cache
+   * does not exceed CacheSizeLimit on any rank.
+   */
+  void EnforceCacheSizeLimit();
+
   vtkRenderWindow* RenderWindow;
   bool ViewTimeValid;
   static bool EnableStreaming;
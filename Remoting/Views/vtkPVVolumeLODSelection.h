@@ -0,0 +1,91 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVVolumeLODSelection.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkPVVolumeLODSelection
+ *
+ * Helpers used by vtkImageVolumeRepresentation to choose the level of its
+ * volume pyramid to render and the bricks of that level that are visible.
+ */
+
+#ifndef vtkPVVolumeLODSelection_h
+#define vtkPVVolumeLODSelection_h
+#ifndef __VTK_WRAP__
+
+#include "vtkPiecewiseFunction.h"
+
+#include <algorithm> // for std::all_of
+#include <vector>    // for std::vector
+
+class vtkPVVolumeLODSelection
+{
+public:
+  // Returns the index of the coarsest level whose largest dimension is at
+  // least `targetSize`. `levelSizes` are the largest dimensions of the
+  // levels, from the finest to the coarsest. Returns 0 if no level is large
+  // enough.
+  static int SelectLevel(const std::vector<int>& levelSizes, double targetSize)
+  {
+    int level = 0;
+    for (int cc = 1; cc < static_cast<int>(levelSizes.size()); ++cc)
+    {
+      if (levelSizes[cc] < targetSize)
+      {
+        break;
+      }
+      level = cc;
+    }
+    return level;
+  }
+
+  // Returns true if all `corners` of a brick are on the outer side of one of
+  // the frustum `planes`, as returned by vtkCamera::GetFrustumPlanes().
+  static bool IsOutsideFrustum(const double corners[8][3], const double planes[24])
+  {
+    for (int plane = 0; plane < 6; ++plane)
+    {
+      const double* p = planes + 4 * plane;
+      if (std::all_of(corners, corners + 8, [p](const double* corner) {
+            return p[0] * corner[0] + p[1] * corner[1] + p[2] * corner[2] + p[3] < 0;
+          }))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns true if `opacity` maps all values in `range` to zero.
+  static bool IsTransparent(vtkPiecewiseFunction* opacity, const double range[2])
+  {
+    if (opacity->GetValue(range[0]) > 0 || opacity->GetValue(range[1]) > 0)
+    {
+      return false;
+    }
+    double node[4];
+    for (int cc = 0; cc < opacity->GetSize(); ++cc)
+    {
+      opacity->GetNodeValue(cc, node);
+      if (node[0] >= range[0] && node[0] <= range[1] && node[1] > 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+#endif // __VTK_WRAP__
+#endif
+// VTK-HeaderTest-Exclude: vtkPVVolumeLODSelection.h
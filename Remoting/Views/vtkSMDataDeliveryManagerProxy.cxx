@@ -16,17 +16,21 @@
 
 #include "vtkCamera.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommand.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataRepresentation.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
 #include "vtkPVStreamingPiecesInformation.h"
 #include "vtkRenderer.h"
 #include "vtkSMSession.h"
 #include "vtkSMViewProxy.h"
+#include "vtkTimerLog.h"
 
 #include <cassert>
+#include <set>
 
 vtkStandardNewMacro(vtkSMDataDeliveryManagerProxy);
 //----------------------------------------------------------------------------
@@ -50,6 +54,12 @@ void vtkSMDataDeliveryManagerProxy::SetViewProxy(vtkSMViewProxy* viewproxy)
   }
 }
 
+//----------------------------------------------------------------------------
+vtkSMViewProxy* vtkSMDataDeliveryManagerProxy::GetViewProxy() const
+{
+  return this->ViewProxy;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMDataDeliveryManagerProxy::Deliver(bool interactive)
 {
@@ -69,30 +79,109 @@ void vtkSMDataDeliveryManagerProxy::Deliver(bool interactive)
   // note: this will create new vtkTimeStamp, if needed.
   vtkTimeStamp& timeStamp =
     use_lod ? this->DeliveryTimestampsLOD[dataKey] : this->DeliveryTimestamps[dataKey];
+  vtkDeliveryQueue& queue =
+    use_lod ? this->DeliveryQueuesLOD[dataKey] : this->DeliveryQueues[dataKey];
+  this->ActiveDeliveryQueue = &queue;
 
-  if (timeStamp > update_ts)
+  if (timeStamp <= update_ts)
+  {
+    // Get a list of representations for which we need to delivery data. This
+    // replaces any geometry still pending since those representations will be
+    // listed again.
+    queue = vtkDeliveryQueue();
+    view->GetDeliveryManager()->NeedsDelivery(timeStamp, queue.Keys, use_lod);
+    timeStamp.Modified();
+  }
+
+  if (queue.IsDone())
   {
     // we have delivered the data since the last update on this view for the
     // chosen data delivery mode. No delivery needs to be done at this time.
     return;
   }
 
-  // Get a list of representations for which we need to delivery data.
-  std::vector<unsigned int> keys_to_deliver;
-  if (!view->GetDeliveryManager()->NeedsDelivery(timeStamp, keys_to_deliver, use_lod))
+  const bool incremental = !this->SuspendIncrementalDelivery && renderview &&
+    renderview->GetUseIncrementalDelivery();
+  if (!incremental)
   {
-    timeStamp.Modified();
+    this->DeliverKeys(use_lod, queue.Keys.size() / 2 - queue.NumberOfDeliveredKeys);
     return;
   }
 
+  // Deliver one representation at a time until the budget is spent. The
+  // previously delivered geometry is rendered for the others.
+  const double budget = renderview->GetIncrementalDeliveryTimeBudget();
+  const double start = vtkTimerLog::GetUniversalTime();
+  do
+  {
+    this->DeliverKeys(use_lod, 1);
+  } while (!queue.IsDone() && vtkTimerLog::GetUniversalTime() - start < budget);
+  vtkVLogIfF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), !queue.IsDone(),
+    "incremental delivery: %d representation(s) pending",
+    static_cast<int>(queue.Keys.size() / 2 - queue.NumberOfDeliveredKeys));
+}
+
+//----------------------------------------------------------------------------
+void vtkSMDataDeliveryManagerProxy::DeliverKeys(bool use_lod, size_t count)
+{
+  vtkDeliveryQueue& queue = *this->ActiveDeliveryQueue;
+  const unsigned int* keys = &queue.Keys[2 * queue.NumberOfDeliveredKeys];
+
   vtkClientServerStream stream;
   stream << vtkClientServerStream::Invoke << VTKOBJECT(this->ViewProxy) << "Deliver"
-         << static_cast<int>(use_lod) << static_cast<unsigned int>(keys_to_deliver.size())
-         << vtkClientServerStream::InsertArray(
-              &keys_to_deliver[0], static_cast<int>(keys_to_deliver.size()))
+         << static_cast<int>(use_lod) << static_cast<unsigned int>(2 * count)
+         << vtkClientServerStream::InsertArray(keys, static_cast<int>(2 * count))
          << vtkClientServerStream::End;
   this->ViewProxy->GetSession()->ExecuteStream(this->ViewProxy->GetLocation(), stream, false);
-  timeStamp.Modified();
+  queue.NumberOfDeliveredKeys += count;
+
+  double progress = static_cast<double>(2 * queue.NumberOfDeliveredKeys) / queue.Keys.size();
+  this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMDataDeliveryManagerProxy::HasPendingDeliveries()
+{
+  return this->ActiveDeliveryQueue != nullptr && !this->ActiveDeliveryQueue->IsDone();
+}
+
+//----------------------------------------------------------------------------
+double vtkSMDataDeliveryManagerProxy::GetDeliveryProgress(vtkSMProxy* repr)
+{
+  if (repr == nullptr || !this->HasPendingDeliveries())
+  {
+    return 1.0;
+  }
+
+  // Geometry is delivered for the representations of the proxy and of its
+  // subproxies, e.g. for vtkSMRepresentationProxy subclasses.
+  std::set<unsigned int> ids;
+  std::vector<vtkSMProxy*> proxies(1, repr);
+  while (!proxies.empty())
+  {
+    vtkSMProxy* proxy = proxies.back();
+    proxies.pop_back();
+    if (auto pvrepr = vtkPVDataRepresentation::SafeDownCast(proxy->GetClientSideObject()))
+    {
+      ids.insert(pvrepr->GetUniqueIdentifier());
+    }
+    for (unsigned int cc = 0, max = proxy->GetNumberOfSubProxies(); cc < max; ++cc)
+    {
+      proxies.push_back(proxy->GetSubProxy(cc));
+    }
+  }
+
+  const vtkDeliveryQueue& queue = *this->ActiveDeliveryQueue;
+  size_t total = 0, delivered = 0;
+  for (size_t cc = 0; cc < queue.Keys.size(); cc += 2)
+  {
+    if (ids.find(queue.Keys[cc]) != ids.end())
+    {
+      ++total;
+      delivered += (cc / 2 < queue.NumberOfDeliveredKeys) ? 1 : 0;
+    }
+  }
+  return total > 0 ? static_cast<double>(delivered) / total : 1.0;
 }
 
 //----------------------------------------------------------------------------
@@ -25,6 +25,12 @@
  * Update-Deliver-Render calls ensures makes it possible to extend the framework
  * for streaming, in future.
  *
+ * When incremental delivery is enabled on the view, Deliver() delivers the
+ * geometry of one representation at a time, until the time budget is spent.
+ * Each representation's geometry is swapped in once completely delivered.
+ * vtkCommand::ProgressEvent is fired, with the fraction of scheduled geometry
+ * delivered as call data (double*), after each representation is delivered.
+ *
  * The streaming components of this class are experimental and will be changed.
  */
 
@@ -35,7 +41,8 @@
 #include "vtkSMProxy.h"
 #include "vtkWeakPointer.h" // needed for iVars
 
-#include <map> // for std::map
+#include <map>    // for std::map
+#include <vector> // for std::vector
 
 class vtkSMViewProxy;
 class VTKREMOTINGVIEWS_EXPORT vtkSMDataDeliveryManagerProxy : public vtkSMProxy
@@ -45,10 +52,13 @@ public:
   vtkTypeMacro(vtkSMDataDeliveryManagerProxy, vtkSMProxy);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
   /**
    * Get/Set the view proxy for whom we are delivering the data.
    */
   void SetViewProxy(vtkSMViewProxy*);
+  vtkSMViewProxy* GetViewProxy() const;
+  //@}
 
   /**
    * Called to request delivery of the geometry. This checks the client-side
@@ -57,6 +67,33 @@ public:
    */
   void Deliver(bool interactive);
 
+  /**
+   * Returns true if the last call to Deliver() left some geometry to be
+   * delivered. This only happens when vtkPVRenderView::UseIncrementalDelivery
+   * is enabled, in which case Deliver() stops delivering once the
+   * vtkPVRenderView::IncrementalDeliveryTimeBudget is spent. Until then,
+   * representations keep rendering the geometry delivered previously.
+   * Subsequent calls to Deliver() deliver the remaining geometry.
+   */
+  bool HasPendingDeliveries();
+
+  /**
+   * Returns the fraction of the geometry scheduled for delivery by Deliver()
+   * that was delivered, for the representation `repr` and its subproxies.
+   * Returns 1.0 when no geometry is pending for `repr`.
+   */
+  double GetDeliveryProgress(vtkSMProxy* repr);
+
+  //@{
+  /**
+   * When set, Deliver() delivers all pending geometry, irrespective of
+   * vtkPVRenderView::UseIncrementalDelivery. This is used when capturing
+   * images and making selections, which must include all geometry.
+   */
+  vtkSetMacro(SuspendIncrementalDelivery, bool);
+  vtkGetMacro(SuspendIncrementalDelivery, bool);
+  //@}
+
   /**
    * EXPERIMEMTAL: Delivery when streaming is enabled.
    * Returns true when some new data was streamed. When this returns false, it
@@ -68,10 +105,28 @@ protected:
   vtkSMDataDeliveryManagerProxy();
   ~vtkSMDataDeliveryManagerProxy() override;
 
+  /**
+   * Delivers the next `count` representation keys of the active queue.
+   */
+  void DeliverKeys(bool use_lod, size_t count);
+
   vtkWeakPointer<vtkSMViewProxy> ViewProxy;
   std::map<int, vtkTimeStamp> DeliveryTimestamps;
   std::map<int, vtkTimeStamp> DeliveryTimestampsLOD;
 
+  // Representation keys (pairs of representation id and port) scheduled for
+  // delivery by Deliver() and how many of those pairs were delivered.
+  struct vtkDeliveryQueue
+  {
+    std::vector<unsigned int> Keys;
+    size_t NumberOfDeliveredKeys = 0;
+    bool IsDone() const { return 2 * this->NumberOfDeliveredKeys >= this->Keys.size(); }
+  };
+  std::map<int, vtkDeliveryQueue> DeliveryQueues;
+  std::map<int, vtkDeliveryQueue> DeliveryQueuesLOD;
+  vtkDeliveryQueue* ActiveDeliveryQueue = nullptr;
+  bool SuspendIncrementalDelivery = false;
+
 private:
   vtkSMDataDeliveryManagerProxy(const vtkSMDataDeliveryManagerProxy&) = delete;
   void operator=(const vtkSMDataDeliveryManagerProxy&) = delete;
@@ -829,6 +829,15 @@ bool vtkSMRenderViewProxy::SelectInternal(const vtkClientServerStream& csstream,
 
   this->IsSelectionCached = true;
 
+  // selections must include all geometry, even with incremental delivery.
+  vtkSMDataDeliveryManagerProxy* deliveryManager = this->GetDeliveryManager();
+  const bool suspendIncrementalDelivery =
+    deliveryManager ? deliveryManager->GetSuspendIncrementalDelivery() : false;
+  if (deliveryManager)
+  {
+    deliveryManager->SetSuspendIncrementalDelivery(true);
+  }
+
   // Call PreRender since Select making will cause multiple renders on the
   // render window. Calling PreRender ensures that the view is ready to render.
   vtkTypeUInt32 render_location = this->PreRender(/*interactive=*/false);
@@ -836,6 +845,11 @@ bool vtkSMRenderViewProxy::SelectInternal(const vtkClientServerStream& csstream,
   bool retVal = this->FetchLastSelection(
     multiple_selections, selectedRepresentations, selectionSources, modifier, selectBlocks);
   this->PostRender(false);
+
+  if (deliveryManager)
+  {
+    deliveryManager->SetSuspendIncrementalDelivery(suspendIncrementalDelivery);
+  }
   return retVal;
 }
 
@@ -703,6 +703,14 @@ vtkImageData* vtkSMViewProxy::CaptureWindowInternal(int magX, int magY)
   int swapBuffers = renWin->GetSwapBuffers();
   renWin->SwapBuffersOff();
 
+  // captured images must include all geometry, even with incremental delivery.
+  const bool suspendIncrementalDelivery =
+    this->DeliveryManager ? this->DeliveryManager->GetSuspendIncrementalDelivery() : false;
+  if (this->DeliveryManager)
+  {
+    this->DeliveryManager->SetSuspendIncrementalDelivery(true);
+  }
+
   // this is needed to ensure that view gets setup correctly before go ahead to
   // capture the image.
   this->RenderForImageCapture();
@@ -721,6 +729,10 @@ vtkImageData* vtkSMViewProxy::CaptureWindowInternal(int magX, int magY)
   w2i->Update();
 
   renWin->SetSwapBuffers(swapBuffers);
+  if (this->DeliveryManager)
+  {
+    this->DeliveryManager->SetSuspendIncrementalDelivery(suspendIncrementalDelivery);
+  }
 
   vtkImageData* capture = vtkImageData::New();
   capture->ShallowCopy(w2i->GetOutput());
@@ -831,6 +843,12 @@ void vtkSMViewProxy::RepresentationVisibilityChanged(vtkSMProxy*, bool)
 {
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMViewProxy::HasPendingDeliveries()
+{
+  return this->DeliveryManager ? this->DeliveryManager->HasPendingDeliveries() : false;
+}
+
 //----------------------------------------------------------------------------
 bool vtkSMViewProxy::GetLocalProcessSupportsInteraction()
 {
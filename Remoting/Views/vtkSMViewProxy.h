@@ -77,6 +77,14 @@ public:
    */
   virtual void InteractiveRender();
 
+  /**
+   * Returns true if the last render left some geometry to be delivered, which
+   * happens when incremental geometry delivery is enabled on the view (see
+   * vtkSMDataDeliveryManagerProxy::HasPendingDeliveries). Another render is
+   * needed to deliver it.
+   */
+  bool HasPendingDeliveries();
+
   /**
    * Called vtkPVView::Update on the server-side.
    */
@@ -542,6 +542,112 @@ void outputFunction(FILE* fp, ClassInfo* data)
 #endif
 }
 
+//--------------------------------------------------------------------------nix
+/*
+ * hashMethodName computes the FNV-1a hash of a method name. This must match
+ * vtkClientServerInterpreter::HashMethodName, which hashes the invoked method
+ * at run time.
+ *
+ * @param name the method name
+ *
+ * @return the hash of the method name
+ */
+static unsigned int hashMethodName(const char* name)
+{
+  unsigned int hash = 2166136261u;
+  for (; *name; ++name)
+  {
+    hash = (hash ^ (unsigned char)(*name)) * 16777619u;
+  }
+  return hash;
+}
+
+//--------------------------------------------------------------------------nix
+/*
+ * This structure associates a function with the hash of its name, so that
+ * functions can be sorted and grouped by hash.
+ *
+ */
+typedef struct _DispatchEntry
+{
+  unsigned int Hash;
+  int Index;
+} DispatchEntry;
+
+//--------------------------------------------------------------------------nix
+/*
+ * dispatchEntryCmp compares two DispatchEntry by hash and then by their
+ * original position, so that overloads keep their declaration order.
+ */
+static int dispatchEntryCmp(const void* entry1, const void* entry2)
+{
+  const DispatchEntry* a = (const DispatchEntry*)entry1;
+  const DispatchEntry* b = (const DispatchEntry*)entry2;
+  if (a->Hash != b->Hash)
+  {
+    return a->Hash < b->Hash ? -1 : 1;
+  }
+  return a->Index - b->Index;
+}
+
+//--------------------------------------------------------------------------nix
+/*
+ * outputFunctionDispatch writes the code handling all the functions of the
+ * class. Rather than comparing the requested method against every function
+ * name in turn, the generated code switches on the hash of the method name so
+ * that only the functions with a matching hash (in practice, the overloads of
+ * the requested method) are compared. The hash is computed once by the
+ * interpreter and reused at every superclass level.
+ *
+ * @param fp the output file
+ * @param data the class being wrapped
+ */
+void outputFunctionDispatch(FILE* fp, ClassInfo* data)
+{
+  DispatchEntry* entries;
+  int numberOfEntries = 0;
+  int i;
+
+  entries = (DispatchEntry*)malloc(sizeof(DispatchEntry) * (data->NumberOfFunctions + 1));
+  for (i = 0; i < data->NumberOfFunctions; i++)
+  {
+    FunctionInfo* func = data->Functions[i];
+    if (!notWrappable(func) && managableArguments(func) && strcmp(data->Name, func->Name) &&
+      strcmp(data->Name, func->Name + 1))
+    {
+      entries[numberOfEntries].Hash = hashMethodName(func->Name);
+      entries[numberOfEntries].Index = i;
+      numberOfEntries++;
+    }
+  }
+
+  if (numberOfEntries > 0)
+  {
+    qsort(entries, numberOfEntries, sizeof(DispatchEntry), dispatchEntryCmp);
+
+    fprintf(fp, "  switch (arlu->GetMethodHash(method))\n"
+                "  {\n");
+    for (i = 0; i < numberOfEntries; i++)
+    {
+      if (i == 0 || entries[i].Hash != entries[i - 1].Hash)
+      {
+        fprintf(fp, "  case %uu:\n", entries[i].Hash);
+      }
+      currentFunction = data->Functions[entries[i].Index];
+      outputFunction(fp, data);
+      if (i + 1 == numberOfEntries || entries[i + 1].Hash != entries[i].Hash)
+      {
+        fprintf(fp, "    break;\n");
+      }
+    }
+    fprintf(fp, "  default:\n"
+                "    break;\n"
+                "  }\n");
+  }
+
+  free(entries);
+}
+
 //--------------------------------------------------------------------------nix
 /*
  * This structure is used internally to sort+collect individual functions.
@@ -1415,11 +1521,7 @@ int main(int argc, char* argv[])
   /*fprintf(fp,"  vtkClientServerStream resultStream;\n");*/
 
   /* insert function handling code here */
-  for (i = 0; i < data->NumberOfFunctions; i++)
-  {
-    currentFunction = data->Functions[i];
-    outputFunction(fp, data);
-  }
+  outputFunctionDispatch(fp, data);
 
   /* try superclasses */
   for (i = 0; i < data->NumberOfSuperClasses; i++)
@@ -18,6 +18,12 @@
  *
  *     store an object in a container with its CGNS path key
  *
+ * The cache can be bounded in size. The size of an entry is the value
+ * returned by its `GetActualMemorySize()` (in kibibytes) when it is inserted.
+ * When inserting an entry would exceed the limit, the least recently used
+ * entries are evicted first. Entries larger than the limit are not cached.
+ *
+ * Hits, misses and evictions are counted to help choosing the limit.
  *
  * @par Thanks:
  * Thanks to Mickael Philit
@@ -27,16 +33,16 @@
 #define vtkCGNSCache_h
 
 #include "vtkSmartPointer.h"
+#include "vtkType.h"
 
 #include <iterator>
-#include <sstream>
+#include <list>
+#include <ostream>
 #include <string>
 #include <unordered_map>
 
 namespace CGNSRead
 {
-// No priority and no size limit right now
-
 template <typename CacheDataType>
 class vtkCGNSCache
 {
@@ -49,71 +55,177 @@ public:
 
   void ClearCache();
 
-  void SetCacheSizeLimit(int size);
-  int GetCacheSizeLimit();
+  //@{
+  /**
+   * Maximum total size of the cached entries, in kibibytes. A negative value
+   * means no limit (default).
+   */
+  void SetCacheSizeLimit(vtkIdType size);
+  vtkIdType GetCacheSizeLimit() const;
+  //@}
+
+  //@{
+  /**
+   * Current total size of the cached entries, in kibibytes, and number of
+   * cached entries.
+   */
+  vtkIdType GetCacheSize() const { return this->CacheSize; }
+  size_t GetNumberOfEntries() const { return this->CacheData.size(); }
+  //@}
+
+  //@{
+  /**
+   * Statistics accumulated since construction or the last ResetStatistics().
+   */
+  vtkIdType GetNumberOfHits() const { return this->NumberOfHits; }
+  vtkIdType GetNumberOfMisses() const { return this->NumberOfMisses; }
+  vtkIdType GetNumberOfEvictions() const { return this->NumberOfEvictions; }
+  void ResetStatistics();
+  void PrintStatistics(std::ostream& os) const;
+  //@}
 
 private:
   vtkCGNSCache(const vtkCGNSCache&) = delete;
   void operator=(const vtkCGNSCache&) = delete;
 
-  typedef std::unordered_map<std::string, vtkSmartPointer<CacheDataType> > CacheMapper;
+  struct CacheEntry
+  {
+    std::string Key;
+    vtkSmartPointer<CacheDataType> Data;
+    vtkIdType Size;
+  };
+
+  // Most recently used entries first.
+  typedef std::list<CacheEntry> CacheList;
+  typedef std::unordered_map<std::string, typename CacheList::iterator> CacheMapper;
+  CacheList Entries;
   CacheMapper CacheData;
 
-  typename CacheMapper::iterator LastCacheAccess;
+  void Erase(typename CacheList::iterator iter);
+  void MakeRoom(vtkIdType size);
 
-  int cacheSizeLimit;
+  vtkIdType CacheSizeLimit;
+  vtkIdType CacheSize;
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+  vtkIdType NumberOfEvictions;
 };
 
 template <typename CacheDataType>
 vtkCGNSCache<CacheDataType>::vtkCGNSCache()
-  : CacheData()
+  : Entries()
+  , CacheData()
+  , CacheSizeLimit(-1)
+  , CacheSize(0)
+  , NumberOfHits(0)
+  , NumberOfMisses(0)
+  , NumberOfEvictions(0)
 {
-  this->cacheSizeLimit = -1;
-  this->LastCacheAccess = CacheData.end();
 }
 
 template <typename CacheDataType>
-void vtkCGNSCache<CacheDataType>::SetCacheSizeLimit(int size)
+void vtkCGNSCache<CacheDataType>::SetCacheSizeLimit(vtkIdType size)
 {
-  this->cacheSizeLimit = size;
+  this->CacheSizeLimit = size;
+  this->MakeRoom(0);
 }
 
 template <typename CacheDataType>
-int vtkCGNSCache<CacheDataType>::GetCacheSizeLimit()
+vtkIdType vtkCGNSCache<CacheDataType>::GetCacheSizeLimit() const
 {
-  return this->cacheSizeLimit;
+  return this->CacheSizeLimit;
 }
 
 template <typename CacheDataType>
 vtkSmartPointer<CacheDataType> vtkCGNSCache<CacheDataType>::Find(const std::string& query)
 {
-  typename CacheMapper::iterator iter;
-  iter = this->CacheData.find(query);
+  typename CacheMapper::iterator iter = this->CacheData.find(query);
   if (iter == this->CacheData.end())
+  {
+    ++this->NumberOfMisses;
     return vtkSmartPointer<CacheDataType>(nullptr);
-  this->LastCacheAccess = iter;
-  return iter->second;
+  }
+  ++this->NumberOfHits;
+  // Mark the entry as the most recently used one
+  this->Entries.splice(this->Entries.begin(), this->Entries, iter->second);
+  return iter->second->Data;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::Insert(
   const std::string& key, const vtkSmartPointer<CacheDataType>& data)
 {
+  typename CacheMapper::iterator iter = this->CacheData.find(key);
+  if (iter != this->CacheData.end())
+  {
+    this->Erase(iter->second);
+  }
+  if (data == nullptr)
+  {
+    return;
+  }
 
-  if (this->cacheSizeLimit > 0 &&
-    this->CacheData.size() >= static_cast<size_t>(this->cacheSizeLimit))
+  const vtkIdType size = static_cast<vtkIdType>(data->GetActualMemorySize());
+  if (this->CacheSizeLimit >= 0 && size > this->CacheSizeLimit)
   {
-    // Make some room by removing last accessed/inserted item
-    this->CacheData.erase(this->LastCacheAccess);
+    // Would evict everything and still not fit
+    return;
   }
-  this->CacheData[key] = data;
-  this->LastCacheAccess = this->CacheData.find(key);
+  this->MakeRoom(size);
+
+  CacheEntry entry;
+  entry.Key = key;
+  entry.Data = data;
+  entry.Size = size;
+  this->Entries.push_front(entry);
+  this->CacheData[key] = this->Entries.begin();
+  this->CacheSize += size;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::ClearCache()
 {
   this->CacheData.clear();
+  this->Entries.clear();
+  this->CacheSize = 0;
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::PrintStatistics(std::ostream& os) const
+{
+  os << this->CacheData.size() << " entries, " << this->CacheSize << " KiB (limit "
+     << this->CacheSizeLimit << "), " << this->NumberOfHits << " hits, " << this->NumberOfMisses
+     << " misses, " << this->NumberOfEvictions << " evictions";
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::Erase(typename CacheList::iterator iter)
+{
+  this->CacheSize -= iter->Size;
+  this->CacheData.erase(iter->Key);
+  this->Entries.erase(iter);
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::MakeRoom(vtkIdType size)
+{
+  if (this->CacheSizeLimit < 0)
+  {
+    return;
+  }
+  while (!this->Entries.empty() && this->CacheSize + size > this->CacheSizeLimit)
+  {
+    this->Erase(std::prev(this->Entries.end()));
+    ++this->NumberOfEvictions;
+  }
 }
 }
 #endif // vtkCGNSCache_h
@@ -47,6 +47,7 @@
 #include "vtkPVInformationKeys.h"
 #include "vtkPointData.h"
 #include "vtkPolyhedron.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTypeInt32Array.h"
@@ -59,6 +60,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <functional>
+#include <future>
 #include <iterator>
 #include <map>
 #include <set>
@@ -113,6 +115,75 @@ public:
   cgsize_t eDataSize;
 };
 
+//------------------------------------------------------------------------------
+/**
+ * Converts the connectivity of a section with a single element type, as read
+ * from the file, to the VTK layout: stores the number of points of each cell,
+ * makes the point indices 0-based and reorders high order cells. Cells have a
+ * fixed size so ranges of cells are converted independently.
+ */
+class MonoElemConnectivityConverter
+{
+public:
+  vtkIdType* Elements;
+  int NumberOfPointsPerCell;
+  int CellType;
+  bool ReOrderElements;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType stride = this->NumberOfPointsPerCell + 1;
+    vtkIdType* elements = this->Elements + begin * stride;
+    for (vtkIdType icell = begin; icell < end; ++icell, elements += stride)
+    {
+      elements[0] = static_cast<vtkIdType>(this->NumberOfPointsPerCell);
+      for (vtkIdType ip = 1; ip < stride; ++ip)
+      {
+        elements[ip] -= 1;
+      }
+    }
+    if (this->ReOrderElements)
+    {
+      CGNSRead::CGNS2VTKorderMonoElem(
+        end - begin, this->CellType, this->Elements + begin * stride);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+/**
+ * Converts the connectivity of a MIXED section, as read from the file, to the
+ * VTK layout and fills the cell types. Cells have a variable size so the
+ * section is converted sequentially.
+ */
+void ConvertMixedConnectivity(vtkIdType numCells, vtkIdType* elements, int* cellsTypes)
+{
+  vtkIdType pos = 0;
+  bool reOrderElements = false;
+  for (vtkIdType icell = 0; icell < numCells; ++icell)
+  {
+    bool higherOrderWarning;
+    bool orderFlag;
+    int numPointsPerCell = 0;
+    CGNS_ENUMT(ElementType_t) elemType = static_cast<CGNS_ENUMT(ElementType_t)>(elements[pos]);
+    cg_npe(elemType, &numPointsPerCell);
+    cellsTypes[icell] = CGNSRead::GetVTKElemType(elemType, higherOrderWarning, orderFlag);
+    reOrderElements = reOrderElements | orderFlag;
+    elements[pos] = static_cast<vtkIdType>(numPointsPerCell);
+    pos++;
+    for (vtkIdType ip = 0; ip < numPointsPerCell; ip++)
+    {
+      elements[ip + pos] = elements[ip + pos] - 1;
+    }
+    pos += numPointsPerCell;
+  }
+
+  if (reOrderElements)
+  {
+    CGNSRead::CGNS2VTKorder(numCells, cellsTypes, elements);
+  }
+}
+
 //------------------------------------------------------------------------------
 /**
  *
@@ -491,7 +562,8 @@ public:
   static int readBCData(const double nodeId, const int cellDim, const int physicalDim,
     const CGNS_ENUMT(GridLocation_t) locationParam, vtkDataSet* dataset, vtkCGNSReader* self);
 
-  static std::string GenerateMeshKey(const char* basename, const char* zonename);
+  static std::string GenerateMeshKey(
+    const char* basename, const char* zonename, const std::string& gridCoordName);
 };
 
 // Helpers for FlowSolutionxxxPointers
@@ -579,6 +651,7 @@ vtkCGNSReader::vtkCGNSReader()
   this->IgnoreSILChangeEvents = false;
   this->CacheMesh = false;
   this->CacheConnectivity = false;
+  this->CacheSizeLimit = -1;
 
   // Setup the selection callback to modify this object when an array
   // selection is changed.
@@ -650,10 +723,11 @@ void vtkCGNSReader::SetController(vtkMultiProcessController* c)
 
 //------------------------------------------------------------------------------
 
-std::string vtkCGNSReader::vtkPrivate::GenerateMeshKey(const char* basename, const char* zonename)
+std::string vtkCGNSReader::vtkPrivate::GenerateMeshKey(
+  const char* basename, const char* zonename, const std::string& gridCoordName)
 {
   std::ostringstream query;
-  query << "/" << basename << "/" << zonename;
+  query << "/" << basename << "/" << zonename << "/" << gridCoordName;
   return query.str();
 }
 
@@ -1796,22 +1870,31 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
     return vtkSmartPointer<vtkDataObject>();
   }
 
-  // If it is not a deforming mesh, gridCoordName keep the standard name
+  // Points are cached per grid coordinates node, so that static meshes are
+  // read once. Deforming meshes are only cached when the cache is bounded,
+  // otherwise every time step would stay in memory.
   // Only Volume mesh points, not subset are cached
-  bool caching = (gridCoordName == "GridCoordinates" && voi == nullptr && self->CacheMesh);
+  bool caching = (voi == nullptr && self->CacheMesh &&
+    (gridCoordName == "GridCoordinates" || self->CacheSizeLimit >= 0));
   if (caching)
   {
     // Try to get from cache
     const char* basename = self->Internal->GetBase(base).name;
     const char* zonename = self->Internal->GetBase(base).zones[zone].name;
-    // build a key /basename/zonename
-    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename);
+    // build a key /basename/zonename/gridcoordname
+    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename, gridCoordName);
 
     points = self->MeshPointsCache.Find(keyMesh);
     if (points.Get() != nullptr)
     {
-      // check storage data type
-      if ((self->GetDoublePrecisionMesh() != 0) != (points->GetDataType() == VTK_DOUBLE))
+      vtkIdType expectedPts = 1;
+      for (n = 0; n < cellDim; n++)
+      {
+        expectedPts *= static_cast<vtkIdType>(zsize[n]);
+      }
+      // check storage data type and size
+      if ((self->GetDoublePrecisionMesh() != 0) != (points->GetDataType() == VTK_DOUBLE) ||
+        points->GetNumberOfPoints() != expectedPts)
       {
         points = nullptr;
       }
@@ -2136,22 +2219,25 @@ int vtkCGNSReader::GetUnstructuredZone(
 
   vtkSmartPointer<vtkPoints> points;
 
-  // If it is not a deforming mesh, gridCoordName keep the standard name
-  // Only Volume mesh points, not subset are cached
-  bool caching = (gridCoordName == "GridCoordinates" && this->CacheMesh);
+  // Points are cached per grid coordinates node, so that static meshes are
+  // read once. Deforming meshes are only cached when the cache is bounded,
+  // otherwise every time step would stay in memory.
+  bool caching =
+    (this->CacheMesh && (gridCoordName == "GridCoordinates" || this->CacheSizeLimit >= 0));
   if (caching)
   {
     // Try to get from cache
     const char* basename = this->Internal->GetBase(base).name;
     const char* zonename = this->Internal->GetBase(base).zones[zone].name;
-    // build a key /basename/zonename
-    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename);
+    // build a key /basename/zonename/gridcoordname
+    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename, gridCoordName);
 
     points = this->MeshPointsCache.Find(keyMesh);
     if (points.Get() != nullptr)
     {
-      // check storage data type
-      if ((this->GetDoublePrecisionMesh() != 0) != (points->GetDataType() == VTK_DOUBLE))
+      // check storage data type and size
+      if ((this->GetDoublePrecisionMesh() != 0) != (points->GetDataType() == VTK_DOUBLE) ||
+        points->GetNumberOfPoints() != nPts)
       {
         points = nullptr;
       }
@@ -2827,6 +2913,10 @@ int vtkCGNSReader::GetUnstructuredZone(
       }
 
       // Iterate over core sections.
+      // Sections are read sequentially since cgio handles cannot be shared
+      // between threads, but the conversion of a section to the VTK layout is
+      // done on a separate thread while the next section is read.
+      std::future<void> conversion;
       for (std::vector<int>::iterator iter = coreSec.begin(); iter != coreSec.end(); ++iter)
       {
         size_t sec = *iter;
@@ -2902,29 +2992,22 @@ int vtkCGNSReader::GetUnstructuredZone(
           CGNSRead::get_section_connectivity(this->cgioNum, cgioSectionId, 2, srcStart, srcEnd,
             srcStride, memStart, memEnd, memStride, memDim, localElements);
 
-          // Add numptspercell and do -1 on indexes
-          for (vtkIdType icell = 0; icell < elementSize; ++icell)
-          {
-            vtkIdType pos = icell * (numPointsPerCell + 1);
-            localElements[pos] = static_cast<vtkIdType>(numPointsPerCell);
-            for (vtkIdType ip = 0; ip < numPointsPerCell; ++ip)
-            {
-              pos++;
-              localElements[pos] = localElements[pos] - 1;
-            }
-          }
-          if (reOrderElements == true)
+          // Add numptspercell and do -1 on indexes while the next section is read
+          MonoElemConnectivityConverter converter;
+          converter.Elements = localElements;
+          converter.NumberOfPointsPerCell = numPointsPerCell;
+          converter.CellType = cellType;
+          converter.ReOrderElements = reOrderElements;
+          if (conversion.valid())
           {
-            CGNSRead::CGNS2VTKorderMonoElem(elementSize, cellType, localElements);
+            conversion.wait();
           }
+          conversion = std::async(std::launch::async, [converter, elementSize]() mutable {
+            vtkSMPTools::For(0, static_cast<vtkIdType>(elementSize), converter);
+          });
         }
         else if (elemType == CGNS_ENUMV(MIXED))
         {
-          //
-          int numPointsPerCell = 0;
-          int cellType;
-          bool higherOrderWarning;
-          bool reOrderElements;
           // pointer on start !!
           vtkIdType* localElements = &(elements[startArraySec[sec]]);
 
@@ -2949,38 +3032,33 @@ int vtkCGNSReader::GetUnstructuredZone(
           CGNSRead::get_section_connectivity(this->cgioNum, cgioSectionId, 1, srcStart, srcEnd,
             srcStride, memStart, memEnd, memStride, memDim, localElements);
 
-          vtkIdType pos = 0;
-          reOrderElements = false;
-          for (vtkIdType icell = 0, i = start - 1; icell < elementSize; ++icell, ++i)
-          {
-            bool orderFlag;
-            elemType = static_cast<CGNS_ENUMT(ElementType_t)>(localElements[pos]);
-            cg_npe(elemType, &numPointsPerCell);
-            cellType = CGNSRead::GetVTKElemType(elemType, higherOrderWarning, orderFlag);
-            reOrderElements = reOrderElements | orderFlag;
-            cellsTypes[i] = cellType;
-            localElements[pos] = static_cast<vtkIdType>(numPointsPerCell);
-            pos++;
-            for (vtkIdType ip = 0; ip < numPointsPerCell; ip++)
-            {
-              localElements[ip + pos] = localElements[ip + pos] - 1;
-            }
-            pos += numPointsPerCell;
-          }
-
-          if (reOrderElements == true)
+          // Convert while the next section is read
+          int* localCellsTypes = &cellsTypes[start - 1];
+          if (conversion.valid())
           {
-            CGNSRead::CGNS2VTKorder(elementSize, &cellsTypes[start - 1], localElements);
+            conversion.wait();
           }
+          conversion = std::async(std::launch::async, [=]() {
+            ConvertMixedConnectivity(elementSize, localElements, localCellsTypes);
+          });
         }
         else
         {
           vtkErrorMacro(<< "Unsupported element Type\n");
+          if (conversion.valid())
+          {
+            conversion.wait();
+          }
+          delete[] cellsTypes;
           return 1;
         }
 
         cgio_release_id(this->cgioNum, cgioSectionId);
       }
+      if (conversion.valid())
+      {
+        conversion.wait();
+      }
 
       cells->SetCells(numCoreCells, cellLocations.GetPointer());
 
@@ -4686,6 +4764,15 @@ void vtkCGNSReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CreateEachSolutionAsBlock: " << this->CreateEachSolutionAsBlock << endl;
   os << indent << "IgnoreFlowSolutionPointers: " << this->IgnoreFlowSolutionPointers << endl;
   os << indent << "DistributeBlocks: " << this->DistributeBlocks << endl;
+  os << indent << "CacheMesh: " << this->CacheMesh << endl;
+  os << indent << "CacheConnectivity: " << this->CacheConnectivity << endl;
+  os << indent << "CacheSizeLimit: " << this->CacheSizeLimit << endl;
+  os << indent << "MeshPointsCache: ";
+  this->MeshPointsCache.PrintStatistics(os);
+  os << endl;
+  os << indent << "ConnectivitiesCache: ";
+  this->ConnectivitiesCache.PrintStatistics(os);
+  os << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -5073,6 +5160,19 @@ void vtkCGNSReader::SetCacheConnectivity(bool enable)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkCGNSReader::SetCacheSizeLimit(int megabytes)
+{
+  if (this->CacheSizeLimit != megabytes)
+  {
+    this->CacheSizeLimit = megabytes;
+    const vtkIdType limit = megabytes < 0 ? -1 : static_cast<vtkIdType>(megabytes) * 1024;
+    this->MeshPointsCache.SetCacheSizeLimit(limit);
+    this->ConnectivitiesCache.SetCacheSizeLimit(limit);
+    this->Modified();
+  }
+}
+
 //==============================================================================
 // *************** LEGACY API **************************************************
 //------------------------------------------------------------------------------
@@ -226,7 +226,10 @@ public:
   /**
    * This reader can cache the mesh points if they are time invariant.
    * They will be stored with a unique reference to their /base/zonename
-   * and not be read in the file when doing unsteady analysis.
+   * and grid coordinates node and not be read in the file when doing unsteady
+   * analysis. Deforming meshes referencing a different grid coordinates node
+   * per time step are cached per node, but only when a CacheSizeLimit is
+   * set, since every time step would otherwise stay in memory.
    */
   void SetCacheMesh(bool enable);
   vtkGetMacro(CacheMesh, bool);
@@ -242,6 +245,16 @@ public:
   vtkGetMacro(CacheConnectivity, bool);
   vtkBooleanMacro(CacheConnectivity, bool);
 
+  //@{
+  /**
+   * Set/get the maximum memory, in MiB, used by each of the mesh points and
+   * connectivity caches. The least recently used entries are dropped to stay
+   * within the limit. A negative value means no limit (default).
+   */
+  void SetCacheSizeLimit(int megabytes);
+  vtkGetMacro(CacheSizeLimit, int);
+  //@}
+
   //@{
   /**
    * Set/get the communication object used to relay a list of files
@@ -318,6 +331,7 @@ private:
   bool DistributeBlocks;
   bool CacheMesh;
   bool CacheConnectivity;
+  int CacheSizeLimit;
 
   // For internal cgio calls (low level IO)
   int cgioNum;      // cgio file reference
@@ -0,0 +1,292 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestArrayBufferMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that datasets marshalled by vtkArrayBufferMarshaller, with and
+// without compression, are reconstructed identically, including component
+// names, array information keys and arrays used for several attributes.
+
+#include "TestDataComparison.h"
+#include "vtkArrayBufferMarshaller.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+
+namespace
+{
+using TestDataComparison::CompareArrays;
+using TestDataComparison::CompareFieldData;
+
+bool CompareCellArrays(vtkCellArray* a, vtkCellArray* b)
+{
+  if (a == nullptr || b == nullptr)
+  {
+    return (a == nullptr || a->GetNumberOfCells() == 0) &&
+      (b == nullptr || b->GetNumberOfCells() == 0);
+  }
+  return a->GetNumberOfCells() == b->GetNumberOfCells() &&
+    CompareArrays(a->GetOffsetsArray(), b->GetOffsetsArray()) &&
+    CompareArrays(a->GetConnectivityArray(), b->GetConnectivityArray());
+}
+
+bool CompareAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (!CompareFieldData(a, b))
+  {
+    return false;
+  }
+  for (int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+  {
+    vtkAbstractArray* aa = a->GetAbstractAttribute(attr);
+    vtkAbstractArray* ba = b->GetAbstractAttribute(attr);
+    if ((aa == nullptr) != (ba == nullptr))
+    {
+      return false;
+    }
+    if (aa && aa->GetName() && (!ba->GetName() || strcmp(aa->GetName(), ba->GetName()) != 0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareDataSets(vtkDataSet* a, vtkDataSet* b)
+{
+  if (!a || !b || a->GetDataObjectType() != b->GetDataObjectType() ||
+    a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  if (!CompareAttributes(a->GetPointData(), b->GetPointData()) ||
+    !CompareAttributes(a->GetCellData(), b->GetCellData()) ||
+    !CompareFieldData(a->GetFieldData(), b->GetFieldData()))
+  {
+    return false;
+  }
+
+  if (auto apd = vtkPolyData::SafeDownCast(a))
+  {
+    auto bpd = vtkPolyData::SafeDownCast(b);
+    return CompareArrays(apd->GetPoints()->GetData(), bpd->GetPoints()->GetData()) &&
+      CompareCellArrays(apd->GetVerts(), bpd->GetVerts()) &&
+      CompareCellArrays(apd->GetLines(), bpd->GetLines()) &&
+      CompareCellArrays(apd->GetPolys(), bpd->GetPolys()) &&
+      CompareCellArrays(apd->GetStrips(), bpd->GetStrips());
+  }
+  if (auto aug = vtkUnstructuredGrid::SafeDownCast(a))
+  {
+    auto bug = vtkUnstructuredGrid::SafeDownCast(b);
+    return CompareArrays(aug->GetPoints()->GetData(), bug->GetPoints()->GetData()) &&
+      CompareCellArrays(aug->GetCells(), bug->GetCells()) &&
+      CompareArrays(aug->GetCellTypesArray(), bug->GetCellTypesArray());
+  }
+  if (auto aid = vtkImageData::SafeDownCast(a))
+  {
+    auto bid = vtkImageData::SafeDownCast(b);
+    int aext[6], bext[6];
+    double aorigin[3], borigin[3], aspacing[3], bspacing[3];
+    aid->GetExtent(aext);
+    bid->GetExtent(bext);
+    aid->GetOrigin(aorigin);
+    bid->GetOrigin(borigin);
+    aid->GetSpacing(aspacing);
+    bid->GetSpacing(bspacing);
+    return memcmp(aext, bext, sizeof(aext)) == 0 && memcmp(aorigin, borigin, sizeof(aorigin)) == 0 &&
+      memcmp(aspacing, bspacing, sizeof(aspacing)) == 0;
+  }
+  return false;
+}
+
+void AddAttributes(vtkDataSet* ds)
+{
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(ds->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < ds->GetNumberOfPoints(); ++cc)
+  {
+    scalars->SetTypedComponent(cc, 0, static_cast<float>(cc % 17));
+  }
+  ds->GetPointData()->SetScalars(scalars);
+  // an array used for more than one attribute.
+  ds->GetPointData()->SetActiveAttribute("Scalars", vtkDataSetAttributes::TCOORDS);
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("GlobalIds");
+  ids->SetNumberOfTuples(ds->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < ds->GetNumberOfCells(); ++cc)
+  {
+    ids->SetTypedComponent(cc, 0, 1000 + cc);
+  }
+  ds->GetCellData()->SetGlobalIds(ids);
+
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(ds->GetNumberOfCells());
+  vectors->FillValue(1.5);
+  vectors->SetComponentName(0, "X");
+  vectors->SetComponentName(1, "Y");
+  vectors->GetInformation()->Set(vtkAbstractArray::GUI_HIDE(), 1);
+  ds->GetCellData()->AddArray(vectors); // unnamed array
+
+  vtkNew<vtkIntArray> field;
+  field->SetName("Field");
+  field->InsertNextValue(42);
+  ds->GetFieldData()->AddArray(field);
+}
+
+vtkSmartPointer<vtkPolyData> CreatePolyData()
+{
+  const int dim = 20;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < dim; ++j)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.1 * i * j);
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> lines;
+  for (int j = 0; j + 1 < dim; ++j)
+  {
+    for (int i = 0; i + 1 < dim; ++i)
+    {
+      vtkIdType quad[4] = { j * dim + i, j * dim + i + 1, (j + 1) * dim + i + 1,
+        (j + 1) * dim + i };
+      polys->InsertNextCell(4, quad);
+    }
+    vtkIdType line[2] = { j * dim, (j + 1) * dim };
+    lines->InsertNextCell(2, line);
+  }
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->SetPolys(polys);
+  pd->SetLines(lines);
+  AddAttributes(pd);
+  return pd;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> CreateUnstructuredGrid()
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int cc = 0; cc < 12; ++cc)
+  {
+    points->InsertNextPoint(cc % 2, (cc / 2) % 2, cc / 4);
+  }
+  auto ug = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  ug->SetPoints(points);
+  vtkIdType hex[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+  ug->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+  vtkIdType tet[4] = { 4, 5, 6, 8 };
+  ug->InsertNextCell(VTK_TETRA, 4, tet);
+  vtkIdType tri[3] = { 9, 10, 11 };
+  ug->InsertNextCell(VTK_TRIANGLE, 3, tri);
+  AddAttributes(ug);
+  return ug;
+}
+
+vtkSmartPointer<vtkImageData> CreateImageData()
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(-2, 10, 3, 9, 0, 4);
+  image->SetOrigin(0.5, -1.25, 3.0);
+  image->SetSpacing(0.5, 1.0, 1.5);
+  AddAttributes(image);
+  return image;
+}
+
+bool TestRoundTrip(vtkDataSet* input, bool compress)
+{
+  if (!vtkArrayBufferMarshaller::CanMarshal(input))
+  {
+    cerr << "Cannot marshal " << input->GetClassName() << endl;
+    return false;
+  }
+
+  vtkIdType length = 0;
+  char* buffer = vtkArrayBufferMarshaller::Marshal(input, length, compress);
+  if (!buffer || !vtkArrayBufferMarshaller::IsMarshalledBuffer(buffer, length))
+  {
+    cerr << "Failed to marshal " << input->GetClassName() << endl;
+    delete[] buffer;
+    return false;
+  }
+
+  vtkSmartPointer<vtkDataObject> output;
+  output.TakeReference(vtkArrayBufferMarshaller::Unmarshal(buffer, length));
+  delete[] buffer;
+  if (!CompareDataSets(input, vtkDataSet::SafeDownCast(output)))
+  {
+    cerr << "Round trip mismatch for " << input->GetClassName()
+         << (compress ? " (compressed)" : "") << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestArrayBufferMarshaller(int, char* [])
+{
+  vtkSmartPointer<vtkDataSet> datasets[] = { CreatePolyData(), CreateUnstructuredGrid(),
+    CreateImageData() };
+
+  bool success = true;
+  for (auto& ds : datasets)
+  {
+    success = TestRoundTrip(ds, false) && success;
+    success = TestRoundTrip(ds, true) && success;
+  }
+
+  // Arrays without the standard memory layout cannot be marshalled.
+  auto image = CreateImageData();
+  vtkNew<vtkSOADataArrayTemplate<float> > soa;
+  soa->SetName("SOA");
+  soa->SetNumberOfComponents(2);
+  soa->SetNumberOfTuples(image->GetNumberOfPoints());
+  soa->Fill(0.0);
+  image->GetPointData()->AddArray(soa);
+  if (vtkArrayBufferMarshaller::CanMarshal(image))
+  {
+    cerr << "Data with SOA arrays should not be marshalled." << endl;
+    success = false;
+  }
+
+  const char legacy[] = "# vtk DataFile Version 4.2";
+  if (vtkArrayBufferMarshaller::IsMarshalledBuffer(legacy, sizeof(legacy)))
+  {
+    cerr << "Legacy buffer detected as marshalled buffer." << endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestDataComparison.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by the tests in this directory to check that two arrays or
+// two field data are identical.
+
+#ifndef TestDataComparison_h
+#define TestDataComparison_h
+
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace TestDataComparison
+{
+// Compares the type, size, names, component names, GUI_HIDE information key
+// and values of two arrays.
+inline bool CompareArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (a == nullptr || b == nullptr)
+  {
+    return a == b;
+  }
+  if (a->GetDataType() != b->GetDataType() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+    a->GetNumberOfTuples() != b->GetNumberOfTuples())
+  {
+    return false;
+  }
+  if ((a->GetName() == nullptr) != (b->GetName() == nullptr) ||
+    (a->GetName() && strcmp(a->GetName(), b->GetName()) != 0))
+  {
+    return false;
+  }
+  if (a->HasAComponentName() != b->HasAComponentName())
+  {
+    return false;
+  }
+  for (int cc = 0; a->HasAComponentName() && cc < a->GetNumberOfComponents(); ++cc)
+  {
+    const char* aname = a->GetComponentName(cc);
+    const char* bname = b->GetComponentName(cc);
+    if ((aname == nullptr) != (bname == nullptr) || (aname && strcmp(aname, bname) != 0))
+    {
+      return false;
+    }
+  }
+  vtkInformationIntegerKey* key = vtkAbstractArray::GUI_HIDE();
+  const bool ahidden = a->HasInformation() && a->GetInformation()->Has(key);
+  const bool bhidden = b->HasInformation() && b->GetInformation()->Has(key);
+  if (ahidden != bhidden ||
+    (ahidden && a->GetInformation()->Get(key) != b->GetInformation()->Get(key)))
+  {
+    return false;
+  }
+  const size_t bytes = static_cast<size_t>(a->GetNumberOfValues() * a->GetDataTypeSize());
+  return bytes == 0 || memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0), bytes) == 0;
+}
+
+// Compares the arrays of two field data, in order.
+inline bool CompareFieldData(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    if (!CompareArrays(a->GetArray(cc), b->GetArray(cc)))
+    {
+      const char* name = a->GetArrayName(cc);
+      std::cerr << "ERROR: array `" << (name ? name : "(unnamed)") << "` differs." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+#endif
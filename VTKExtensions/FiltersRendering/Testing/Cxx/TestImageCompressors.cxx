@@ -13,6 +13,7 @@
 
 =========================================================================*/
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkImageCompressor.h"
 #include "vtkImageData.h"
 #include "vtkLZ4Compressor.h"
@@ -26,6 +27,8 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <string>
 #include <vtksys/CommandLineArguments.hxx>
@@ -60,7 +63,7 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
 
   vtkNew<vtkTimerLog> timer;
   timer->StartTimer();
-  if (!compressor->Compress())
+  if (compressor->Compress() != VTK_OK)
   {
     return false;
   }
@@ -70,7 +73,7 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   compressor->SetInput(outputCompressed.Get());
   compressor->SetOutput(outputDeCompressed.Get());
   timer->StartTimer();
-  if (!compressor->Decompress())
+  if (compressor->Decompress() != VTK_OK)
   {
     return false;
   }
@@ -81,9 +84,161 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   return true;
 }
 
+// Times a vtkDeltaImageCompressor on frames that differ from the previous one
+// in a few tiles, i.e. the frames it is meant for. The key frame is not timed.
+bool DoDeltaTest(Data& data, vtkUnsignedCharArray* input, int width, int height)
+{
+  vtkNew<vtkDeltaImageCompressor> sender;
+  vtkNew<vtkDeltaImageCompressor> receiver;
+  sender->SetQuality(0);
+  sender->SetKeyFrameInterval(0);
+  receiver->RestoreConfiguration(sender->SaveConfiguration());
+  sender->SetImageResolution(width, height);
+  receiver->SetImageResolution(width, height);
+
+  vtkNew<vtkUnsignedCharArray> frame;
+  frame->DeepCopy(input);
+  vtkNew<vtkUnsignedCharArray> compressed;
+  vtkNew<vtkUnsignedCharArray> decompressed;
+  decompressed->SetNumberOfComponents(input->GetNumberOfComponents());
+  decompressed->SetNumberOfTuples(input->GetNumberOfTuples());
+  sender->SetInput(frame);
+  sender->SetOutput(compressed);
+  receiver->SetInput(compressed);
+  receiver->SetOutput(decompressed);
+  if (sender->Compress() != VTK_OK || receiver->Decompress() != VTK_OK)
+  {
+    return false;
+  }
+
+  // Change one pixel per tile along the diagonal.
+  const int comps = frame->GetNumberOfComponents();
+  const int step = sender->GetTileSize();
+  for (int cc = 0; cc < width && cc < height; cc += step)
+  {
+    unsigned char* pixel = frame->GetPointer((static_cast<vtkIdType>(cc) * width + cc) * comps);
+    pixel[0] = static_cast<unsigned char>(pixel[0] + 1);
+  }
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  if (sender->Compress() != VTK_OK)
+  {
+    return false;
+  }
+  timer->StopTimer();
+  data.CompressTime += timer->GetElapsedTime();
+
+  timer->StartTimer();
+  if (receiver->Decompress() != VTK_OK)
+  {
+    return false;
+  }
+  timer->StopTimer();
+  data.DecompressTime += timer->GetElapsedTime();
+  data.CompressedSize = compressed->GetNumberOfTuples() * compressed->GetNumberOfComponents();
+
+  if (sender->GetNumberOfChangedTiles() == 0 ||
+    sender->GetNumberOfChangedTiles() == sender->GetNumberOfTiles() ||
+    memcmp(frame->GetPointer(0), decompressed->GetPointer(0), frame->GetNumberOfValues()) != 0)
+  {
+    cerr << "Timed delta frame was not compressed as a partial frame." << endl;
+    return false;
+  }
+  return true;
+}
+
+// Compresses a sequence of frames with a vtkDeltaImageCompressor and checks
+// that only the changed tiles are sent and that the frames are reconstructed.
+bool TestDeltaFrames(vtkUnsignedCharArray* input, int width, int height)
+{
+  vtkNew<vtkDeltaImageCompressor> sender;
+  vtkNew<vtkDeltaImageCompressor> receiver;
+  sender->RestoreConfiguration("vtkDeltaImageCompressor 1 0 32 10");
+  receiver->RestoreConfiguration(sender->SaveConfiguration());
+
+  vtkNew<vtkUnsignedCharArray> frame;
+  frame->DeepCopy(input);
+  vtkNew<vtkUnsignedCharArray> compressed;
+  vtkNew<vtkUnsignedCharArray> decompressed;
+  decompressed->SetNumberOfComponents(input->GetNumberOfComponents());
+  decompressed->SetNumberOfTuples(input->GetNumberOfTuples());
+  sender->SetInput(frame);
+  sender->SetOutput(compressed);
+  receiver->SetInput(compressed);
+  receiver->SetOutput(decompressed);
+
+  const vtkIdType numValues = frame->GetNumberOfValues();
+  vtkIdType keyFrameSize = 0;
+  for (int cc = 0; cc < 12; ++cc)
+  {
+    if (cc == 2 || cc == 3)
+    {
+      // Change a single pixel, in the middle of the image.
+      unsigned char* pixel =
+        frame->GetPointer(((height / 2) * width + width / 2) * frame->GetNumberOfComponents());
+      pixel[0] = static_cast<unsigned char>(pixel[0] + 1);
+    }
+
+    sender->SetImageResolution(width, height);
+    receiver->SetImageResolution(width, height);
+    if (sender->Compress() != VTK_OK || receiver->Decompress() != VTK_OK ||
+      memcmp(frame->GetPointer(0), decompressed->GetPointer(0), numValues) != 0)
+    {
+      cerr << "Delta frame " << cc << " was not reconstructed correctly." << endl;
+      return false;
+    }
+
+    // Frames 0 and 10 are key frames, 2 and 3 have a single changed tile and
+    // the others are unchanged.
+    const int expected = (cc == 0 || cc == 10) ? sender->GetNumberOfTiles()
+                                               : ((cc == 2 || cc == 3) ? 1 : 0);
+    if (sender->GetNumberOfChangedTiles() != expected ||
+      receiver->GetNumberOfChangedTiles() != expected)
+    {
+      cerr << "Delta frame " << cc << ": unexpected number of changed tiles "
+           << sender->GetNumberOfChangedTiles() << " (expected " << expected << ")" << endl;
+      return false;
+    }
+    if (cc == 0)
+    {
+      keyFrameSize = compressed->GetNumberOfTuples();
+    }
+    else if (expected == 0 && compressed->GetNumberOfTuples() * 100 > keyFrameSize)
+    {
+      cerr << "Unchanged delta frame is too large: " << compressed->GetNumberOfTuples() << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Tiles the image `scale` times in each direction, to benchmark with large
+// images (e.g. tiled-display frames).
+vtkSmartPointer<vtkUnsignedCharArray> ReplicateImage(
+  vtkUnsignedCharArray* input, int width, int height, int scale)
+{
+  const int comps = input->GetNumberOfComponents();
+  auto output = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  output->SetNumberOfComponents(comps);
+  output->SetNumberOfTuples(static_cast<vtkIdType>(width) * height * scale * scale);
+  const size_t rowLength = static_cast<size_t>(width) * comps;
+  unsigned char* out = output->GetPointer(0);
+  for (int y = 0; y < height * scale; ++y)
+  {
+    const unsigned char* row = input->GetPointer(static_cast<vtkIdType>(y % height) * rowLength);
+    for (int x = 0; x < scale; ++x, out += rowLength)
+    {
+      memcpy(out, row, rowLength);
+    }
+  }
+  return output;
+}
+
 int TestImageCompressors(int argc, char* argv[])
 {
   int max_count = 10;
+  int scale = 1;
   bool test_lossy = true;
   std::string imageFile;
 
@@ -93,6 +248,8 @@ int TestImageCompressors(int argc, char* argv[])
   typedef vtksys::CommandLineArguments argT;
   arg.AddArgument("--image", argT::EQUAL_ARGUMENT, &imageFile,
     "Optionally specify an image to use for compressing.");
+  arg.AddArgument("--scale", argT::EQUAL_ARGUMENT, &scale,
+    "Optionally replicate the image this many times along each axis.");
   arg.StoreUnusedArguments(true);
   if (!arg.Parse())
   {
@@ -118,6 +275,14 @@ int TestImageCompressors(int argc, char* argv[])
 
   vtkSmartPointer<vtkUnsignedCharArray> input =
     vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetScalars());
+  int width = image->GetDimensions()[0];
+  int height = image->GetDimensions()[1];
+  if (scale > 1)
+  {
+    input = ReplicateImage(input, width, height, scale);
+    width *= scale;
+    height *= scale;
+  }
   vtkIdType uncompressedSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
 
   MapType datas;
@@ -129,6 +294,24 @@ int TestImageCompressors(int argc, char* argv[])
     {
       return TEST_FAILED;
     }
+
+    // A single chunk, i.e. no parallelism, for comparison.
+    vtkNew<vtkLZ4Compressor> lz4Serial;
+    lz4Serial->SetQuality(0);
+    lz4Serial->SetChunkSize(VTK_INT_MAX);
+    if (!DoTest(datas["LZ4 (quality: 0, single chunk)"], lz4Serial.Get(), input))
+    {
+      return TEST_FAILED;
+    }
+
+    // Small chunks, to exercise multiple chunks with the default test image.
+    vtkNew<vtkLZ4Compressor> lz4Small;
+    lz4Small->SetQuality(0);
+    lz4Small->SetChunkSize(4096 + 3);
+    if (!DoTest(datas["LZ4 (quality: 0, 4 KiB chunks)"], lz4Small.Get(), input))
+    {
+      return TEST_FAILED;
+    }
     if (test_lossy)
     {
       lz4->SetQuality(3);
@@ -145,6 +328,18 @@ int TestImageCompressors(int argc, char* argv[])
       }
     }
 
+    // The first frame of a vtkDeltaImageCompressor is always a key frame.
+    vtkNew<vtkDeltaImageCompressor> delta;
+    delta->SetQuality(0);
+    if (!DoTest(datas["DELTA (quality: 0, key frame)"], delta.Get(), input))
+    {
+      return TEST_FAILED;
+    }
+    if (!DoDeltaTest(datas["DELTA (quality: 0, changed tiles)"], input, width, height))
+    {
+      return TEST_FAILED;
+    }
+
     vtkNew<vtkSquirtCompressor> squirt;
     squirt->SetSquirtLevel(0);
     if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input))
@@ -195,16 +390,26 @@ int TestImageCompressors(int argc, char* argv[])
     }
   }
 
-  cout << "Input: " << image->GetDimensions()[0] << "x" << image->GetDimensions()[1] << "x"
-       << image->GetDimensions()[2] << " (uncompressed size: " << uncompressedSize << ") " << endl;
+  if (!TestDeltaFrames(input, width, height))
+  {
+    return TEST_FAILED;
+  }
+
+  cout << "Input: " << width << "x" << height << "x" << image->GetDimensions()[2]
+       << " (uncompressed size: " << uncompressedSize << ") " << endl;
 
+  // Throughput is reported in MiB of uncompressed data per second.
+  const double mebibytes = uncompressedSize * max_count / (1024.0 * 1024.0);
   for (MapType::iterator iter = datas.begin(); iter != datas.end(); ++iter)
   {
     cout << iter->first.c_str() << " :"
          << " compress: " << (iter->second.CompressTime / max_count)
          << " decompress: " << (iter->second.DecompressTime / max_count) << " compression ratio: "
          << ((uncompressedSize - iter->second.CompressedSize) * 100.0 / uncompressedSize)
-         << "( compressed size: " << iter->second.CompressedSize << ")" << endl;
+         << "( compressed size: " << iter->second.CompressedSize << ")"
+         << " compress throughput: " << mebibytes / std::max(iter->second.CompressTime, 1e-9)
+         << " MiB/s decompress throughput: "
+         << mebibytes / std::max(iter->second.DecompressTime, 1e-9) << " MiB/s" << endl;
   }
   return TEST_SUCCESS;
 }
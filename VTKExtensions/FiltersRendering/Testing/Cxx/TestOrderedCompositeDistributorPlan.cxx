@@ -0,0 +1,197 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestOrderedCompositeDistributorPlan.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkOrderedCompositeDistributor produces the same output when it
+// reuses a redistribution plan, after only the attributes of its input
+// changed, as when it redistributes the data again.
+
+#include "TestDataComparison.h"
+#include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkOrderedCompositeDistributor.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+namespace
+{
+using TestDataComparison::CompareArrays;
+using TestDataComparison::CompareFieldData;
+
+// Each rank gets a slab of the grid along Z.
+vtkSmartPointer<vtkUnstructuredGrid> CreateGrid(int rank)
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 10, 0, 10, 5 * rank, 5 * rank + 5);
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    points->SetPoint(cc, image->GetPoint(cc));
+  }
+  grid->SetPoints(points);
+  grid->Allocate(image->GetNumberOfCells());
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType cc = 0; cc < image->GetNumberOfCells(); ++cc)
+  {
+    image->GetCellPoints(cc, ids);
+    grid->InsertNextCell(image->GetCellType(cc), ids);
+  }
+  return grid;
+}
+
+// Replaces the attributes of `grid` with new arrays whose values depend on
+// `step`.
+void SetAttributes(vtkUnstructuredGrid* grid, int rank, int step)
+{
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(grid->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < grid->GetNumberOfPoints(); ++cc)
+  {
+    scalars->SetTypedComponent(cc, 0, rank * 1000.0 + cc * 0.5 + step);
+  }
+  grid->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkIntArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfComponents(2);
+  cellValues->SetNumberOfTuples(grid->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < grid->GetNumberOfCells(); ++cc)
+  {
+    cellValues->SetTypedComponent(cc, 0, rank);
+    cellValues->SetTypedComponent(cc, 1, static_cast<int>(cc) * (step + 1));
+  }
+  grid->GetCellData()->AddArray(cellValues);
+}
+
+bool CompareGrids(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (a == nullptr || b == nullptr)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    std::cerr << "ERROR: the number of points or cells differs." << std::endl;
+    return false;
+  }
+  if (a->GetNumberOfPoints() > 0 &&
+    !CompareArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()))
+  {
+    std::cerr << "ERROR: the points differ." << std::endl;
+    return false;
+  }
+  if (a->GetNumberOfCells() > 0 &&
+    (!CompareArrays(a->GetCells()->GetOffsetsArray(), b->GetCells()->GetOffsetsArray()) ||
+      !CompareArrays(a->GetCells()->GetConnectivityArray(), b->GetCells()->GetConnectivityArray())))
+  {
+    std::cerr << "ERROR: the cells differ." << std::endl;
+    return false;
+  }
+  return CompareFieldData(a->GetPointData(), b->GetPointData()) &&
+    CompareFieldData(a->GetCellData(), b->GetCellData());
+}
+
+bool TestPlan(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  // Cut along X so that cells move between ranks.
+  std::vector<vtkBoundingBox> cuts;
+  for (int cc = 0; cc < numRanks; ++cc)
+  {
+    cuts.push_back(vtkBoundingBox(
+      10.0 * cc / numRanks, 10.0 * (cc + 1) / numRanks, -1, 11, -1, 5 * numRanks + 1));
+  }
+
+  vtkNew<vtkOrderedCompositeDistributor> withPlan;
+  withPlan->SetController(controller);
+  withPlan->SetCuts(cuts);
+  withPlan->SetUseRedistributionPlan(true);
+
+  vtkNew<vtkOrderedCompositeDistributor> withoutPlan;
+  withoutPlan->SetController(controller);
+  withoutPlan->SetCuts(cuts);
+
+  auto grid = CreateGrid(rank);
+  SetAttributes(grid, rank, 0);
+  withPlan->SetInputDataObject(grid);
+  withPlan->Update();
+  withoutPlan->SetInputDataObject(grid);
+  withoutPlan->Update();
+  if (withPlan->GetRedistributionPlanReused())
+  {
+    std::cerr << "ERROR: no plan should have been reused on the first execution." << std::endl;
+    return false;
+  }
+  if (!CompareGrids(vtkUnstructuredGrid::SafeDownCast(withPlan->GetOutputDataObject(0)),
+        vtkUnstructuredGrid::SafeDownCast(withoutPlan->GetOutputDataObject(0))))
+  {
+    std::cerr << "ERROR: outputs differ when building the plan." << std::endl;
+    return false;
+  }
+
+  // Same points and cells, new attributes.
+  vtkNew<vtkUnstructuredGrid> next;
+  next->CopyStructure(grid);
+  SetAttributes(next, rank, 1);
+  withPlan->SetInputDataObject(next);
+  withPlan->Update();
+  withoutPlan->SetInputDataObject(next);
+  withoutPlan->Update();
+  if (!withPlan->GetRedistributionPlanReused())
+  {
+    std::cerr << "ERROR: the plan was not reused for an attribute-only change." << std::endl;
+    return false;
+  }
+  if (!CompareGrids(vtkUnstructuredGrid::SafeDownCast(withPlan->GetOutputDataObject(0)),
+        vtkUnstructuredGrid::SafeDownCast(withoutPlan->GetOutputDataObject(0))))
+  {
+    std::cerr << "ERROR: outputs differ when reusing the plan." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestOrderedCompositeDistributorPlan(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int success = TestPlan(controller) ? 1 : 0;
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  controller->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
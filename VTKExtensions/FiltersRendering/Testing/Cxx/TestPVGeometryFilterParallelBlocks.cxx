@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVGeometryFilterParallelBlocks.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkPVGeometryFilter produces identical output, and OutlineFlag,
+// for a multiblock dataset when blocks are executed serially or in parallel.
+
+#include "TestDataComparison.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+vtkSmartPointer<vtkImageData> CreateBlock(int index)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  const int size = 4 + (index % 5);
+  image->SetExtent(0, size, 0, size + 1, 0, size + 2);
+  image->SetOrigin(index * 10.0, 0, 0);
+  image->SetSpacing(0.5, 1.0, 1.5);
+
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    scalars->SetTypedComponent(cc, 0, index + cc * 0.25);
+  }
+  image->GetPointData()->SetScalars(scalars);
+  return image;
+}
+
+using TestDataComparison::CompareArrays;
+using TestDataComparison::CompareFieldData;
+
+bool ComparePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a == nullptr || b == nullptr)
+  {
+    return a == b;
+  }
+  return CompareArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()) &&
+    CompareArrays(a->GetPolys()->GetOffsetsArray(), b->GetPolys()->GetOffsetsArray()) &&
+    CompareArrays(
+      a->GetPolys()->GetConnectivityArray(), b->GetPolys()->GetConnectivityArray()) &&
+    CompareArrays(
+      a->GetLines()->GetConnectivityArray(), b->GetLines()->GetConnectivityArray()) &&
+    CompareFieldData(a->GetPointData(), b->GetPointData()) &&
+    CompareFieldData(a->GetCellData(), b->GetCellData()) &&
+    CompareFieldData(a->GetFieldData(), b->GetFieldData());
+}
+
+bool TestParallelBlocks(vtkMultiBlockDataSet* input, unsigned int expectedCount, int useOutline)
+{
+  vtkNew<vtkPVGeometryFilter> serial;
+  serial->SetUseOutline(useOutline);
+  serial->SetGenerateCellNormals(1);
+  serial->SetInputData(input);
+  serial->Update();
+
+  vtkNew<vtkPVGeometryFilter> parallel;
+  parallel->SetUseOutline(useOutline);
+  parallel->SetGenerateCellNormals(1);
+  parallel->SetExecuteBlocksInParallel(true);
+  parallel->SetInputData(input);
+  parallel->Update();
+
+  auto serialOutput = vtkMultiBlockDataSet::SafeDownCast(serial->GetOutputDataObject(0));
+  auto parallelOutput = vtkMultiBlockDataSet::SafeDownCast(parallel->GetOutputDataObject(0));
+  if (!serialOutput || !parallelOutput)
+  {
+    cerr << "ERROR: expected vtkMultiBlockDataSet outputs." << endl;
+    return false;
+  }
+
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(serialOutput->NewTreeIterator());
+  iter->SkipEmptyNodesOff();
+  unsigned int count = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    auto a = vtkPolyData::SafeDownCast(iter->GetCurrentDataObject());
+    auto b = vtkPolyData::SafeDownCast(parallelOutput->GetDataSet(iter));
+    if (!ComparePolyData(a, b))
+    {
+      cerr << "ERROR: outputs differ for block " << iter->GetCurrentFlatIndex()
+           << " (UseOutline: " << useOutline << ")" << endl;
+      return false;
+    }
+    count += a ? 1 : 0;
+  }
+
+  if (count != expectedCount)
+  {
+    cerr << "ERROR: unexpected number of non-empty blocks: " << count << endl;
+    return false;
+  }
+  if (serial->GetOutlineFlag() != parallel->GetOutlineFlag())
+  {
+    cerr << "ERROR: OutlineFlag mismatch (UseOutline: " << useOutline << ")" << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPVGeometryFilterParallelBlocks(int, char*[])
+{
+  const unsigned int numBlocks = 64;
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(numBlocks);
+  for (unsigned int cc = 0; cc < numBlocks; ++cc)
+  {
+    // leave a few blocks empty, including the last one, to exercise null
+    // leaves.
+    if (cc % 7 != 3 && cc != numBlocks - 1)
+    {
+      input->SetBlock(cc, CreateBlock(static_cast<int>(cc)));
+    }
+  }
+
+  const unsigned int expectedCount = numBlocks - 10;
+  return TestParallelBlocks(input, expectedCount, 0) &&
+      TestParallelBlocks(input, expectedCount, 1)
+    ? EXIT_SUCCESS
+    : EXIT_FAILURE;
+}
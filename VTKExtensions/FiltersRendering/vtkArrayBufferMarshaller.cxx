@@ -0,0 +1,1004 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkArrayBufferMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayBufferMarshaller.h"
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationIdTypeKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationIterator.h"
+#include "vtkInformationKeyLookup.h"
+#include "vtkInformationStringKey.h"
+#include "vtkInformationStringVectorKey.h"
+#include "vtkInformationUnsignedLongKey.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtk_lz4.h"
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Identifies buffers generated by vtkArrayBufferMarshaller::Marshal. The magic
+// is followed by the size of the header (as a little-endian 64-bit integer),
+// the header itself and then the array payloads.
+const char MAGIC[8] = { 'v', 't', 'k', 'a', 'b', 'm', '0', '2' };
+const vtkIdType PREAMBLE_SIZE = 16;
+
+// Format flag sent before the header by vtkArrayBufferMarshaller::Send.
+enum
+{
+  FORMAT_DATA_OBJECT = 0,
+  FORMAT_ARRAY_BUFFERS = 1
+};
+
+enum ArrayRole
+{
+  POINTS = 0,
+  VERTS_OFFSETS,
+  VERTS_CONNECTIVITY,
+  LINES_OFFSETS,
+  LINES_CONNECTIVITY,
+  POLYS_OFFSETS,
+  POLYS_CONNECTIVITY,
+  STRIPS_OFFSETS,
+  STRIPS_CONNECTIVITY,
+  CELLS_OFFSETS,
+  CELLS_CONNECTIVITY,
+  CELL_TYPES,
+  FACE_LOCATIONS,
+  FACES,
+  POINT_DATA,
+  CELL_DATA,
+  FIELD_DATA
+};
+
+// Types of the information keys that are serialized, the same types as the
+// ones supported by the legacy writer.
+enum InformationKeyType
+{
+  KEY_DOUBLE = 0,
+  KEY_DOUBLE_VECTOR,
+  KEY_ID_TYPE,
+  KEY_INTEGER,
+  KEY_INTEGER_VECTOR,
+  KEY_STRING,
+  KEY_STRING_VECTOR,
+  KEY_UNSIGNED_LONG
+};
+
+struct vtkInformationEntry
+{
+  std::string Location;
+  std::string Name;
+  int Type = KEY_DOUBLE;
+  std::vector<double> Doubles;
+  std::vector<vtkTypeInt64> Integers;
+  std::vector<std::string> Strings;
+};
+
+struct vtkArrayEntry
+{
+  int Role = POINTS;
+  // Bit `i` is set when the array is the attribute `i` (see
+  // vtkDataSetAttributes::AttributeTypes).
+  int AttributeMask = 0;
+  int HasName = 0;
+  std::string Name;
+  // Pairs of (has name, name) for each component, empty when the array has
+  // no component names.
+  std::vector<std::pair<int, std::string> > ComponentNames;
+  std::vector<vtkInformationEntry> Information;
+  int DataType = VTK_VOID;
+  int NumberOfComponents = 1;
+  vtkTypeInt64 NumberOfTuples = 0;
+  vtkTypeInt64 RawSize = 0;
+  vtkTypeInt64 EncodedSize = 0;
+
+  // Only used when sending.
+  vtkDataArray* Array = nullptr;
+  std::vector<char> Compressed;
+
+  bool IsCompressed() const { return this->EncodedSize != this->RawSize; }
+
+  const char* GetPayload() const
+  {
+    return this->IsCompressed() ? this->Compressed.data()
+                                : static_cast<const char*>(this->Array->GetVoidPointer(0));
+  }
+};
+
+struct vtkLayout
+{
+  int DataObjectType = VTK_POLY_DATA;
+  int BigEndian = 0;
+  int Extent[6] = { 0, -1, 0, -1, 0, -1 };
+  double Origin[3] = { 0, 0, 0 };
+  double Spacing[3] = { 1, 1, 1 };
+  std::vector<vtkArrayEntry> Arrays;
+};
+
+int IsBigEndian()
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+bool IsSupportedArray(vtkDataArray* array)
+{
+  // vtkBitArray uses a packed layout, and other array types (SOA, implicit,
+  // etc.) do not expose contiguous memory we can send as is.
+  return array && array->GetDataType() != VTK_BIT &&
+    array->GetArrayType() == vtkAbstractArray::AoSDataArrayTemplate &&
+    array->HasStandardMemoryLayout();
+}
+
+void CollectInformation(vtkInformation* info, std::vector<vtkInformationEntry>& entries)
+{
+  vtkNew<vtkInformationIterator> iter;
+  iter->SetInformationWeak(info);
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkInformationKey* key = iter->GetCurrentKey();
+    vtkInformationEntry entry;
+    entry.Location = key->GetLocation() ? key->GetLocation() : "";
+    entry.Name = key->GetName() ? key->GetName() : "";
+    if (auto dkey = vtkInformationDoubleKey::SafeDownCast(key))
+    {
+      entry.Type = KEY_DOUBLE;
+      entry.Doubles.push_back(info->Get(dkey));
+    }
+    else if (auto dvkey = vtkInformationDoubleVectorKey::SafeDownCast(key))
+    {
+      entry.Type = KEY_DOUBLE_VECTOR;
+      const double* values = info->Get(dvkey);
+      entry.Doubles.assign(values, values + info->Length(dvkey));
+    }
+    else if (auto idkey = vtkInformationIdTypeKey::SafeDownCast(key))
+    {
+      entry.Type = KEY_ID_TYPE;
+      entry.Integers.push_back(info->Get(idkey));
+    }
+    else if (auto ikey = vtkInformationIntegerKey::SafeDownCast(key))
+    {
+      entry.Type = KEY_INTEGER;
+      entry.Integers.push_back(info->Get(ikey));
+    }
+    else if (auto ivkey = vtkInformationIntegerVectorKey::SafeDownCast(key))
+    {
+      entry.Type = KEY_INTEGER_VECTOR;
+      const int* values = info->Get(ivkey);
+      entry.Integers.assign(values, values + info->Length(ivkey));
+    }
+    else if (auto skey = vtkInformationStringKey::SafeDownCast(key))
+    {
+      entry.Type = KEY_STRING;
+      entry.Strings.push_back(info->Get(skey) ? info->Get(skey) : "");
+    }
+    else if (auto svkey = vtkInformationStringVectorKey::SafeDownCast(key))
+    {
+      entry.Type = KEY_STRING_VECTOR;
+      for (int cc = 0, max = info->Length(svkey); cc < max; ++cc)
+      {
+        entry.Strings.push_back(info->Get(svkey, cc) ? info->Get(svkey, cc) : "");
+      }
+    }
+    else if (auto ulkey = vtkInformationUnsignedLongKey::SafeDownCast(key))
+    {
+      entry.Type = KEY_UNSIGNED_LONG;
+      entry.Integers.push_back(static_cast<vtkTypeInt64>(info->Get(ulkey)));
+    }
+    else
+    {
+      // other keys cannot be serialized, as with the legacy writer.
+      continue;
+    }
+    entries.push_back(std::move(entry));
+  }
+}
+
+void RestoreInformation(const std::vector<vtkInformationEntry>& entries, vtkInformation* info)
+{
+  for (const auto& entry : entries)
+  {
+    // keys unknown to this process are skipped, as with the legacy reader.
+    vtkInformationKey* key = vtkInformationKeyLookup::Find(entry.Name, entry.Location);
+    if (!key)
+    {
+      continue;
+    }
+    auto dkey = vtkInformationDoubleKey::SafeDownCast(key);
+    auto dvkey = vtkInformationDoubleVectorKey::SafeDownCast(key);
+    auto idkey = vtkInformationIdTypeKey::SafeDownCast(key);
+    auto ikey = vtkInformationIntegerKey::SafeDownCast(key);
+    auto ivkey = vtkInformationIntegerVectorKey::SafeDownCast(key);
+    auto skey = vtkInformationStringKey::SafeDownCast(key);
+    auto svkey = vtkInformationStringVectorKey::SafeDownCast(key);
+    auto ulkey = vtkInformationUnsignedLongKey::SafeDownCast(key);
+    if (entry.Type == KEY_DOUBLE && dkey && entry.Doubles.size() == 1)
+    {
+      info->Set(dkey, entry.Doubles[0]);
+    }
+    else if (entry.Type == KEY_DOUBLE_VECTOR && dvkey)
+    {
+      info->Set(dvkey, entry.Doubles.data(), static_cast<int>(entry.Doubles.size()));
+    }
+    else if (entry.Type == KEY_ID_TYPE && idkey && entry.Integers.size() == 1)
+    {
+      info->Set(idkey, static_cast<vtkIdType>(entry.Integers[0]));
+    }
+    else if (entry.Type == KEY_INTEGER && ikey && entry.Integers.size() == 1)
+    {
+      info->Set(ikey, static_cast<int>(entry.Integers[0]));
+    }
+    else if (entry.Type == KEY_INTEGER_VECTOR && ivkey)
+    {
+      std::vector<int> values(entry.Integers.begin(), entry.Integers.end());
+      info->Set(ivkey, values.data(), static_cast<int>(values.size()));
+    }
+    else if (entry.Type == KEY_STRING && skey && entry.Strings.size() == 1)
+    {
+      info->Set(skey, entry.Strings[0].c_str());
+    }
+    else if (entry.Type == KEY_STRING_VECTOR && svkey)
+    {
+      info->Remove(svkey);
+      for (const auto& value : entry.Strings)
+      {
+        info->Append(svkey, value.c_str());
+      }
+    }
+    else if (entry.Type == KEY_UNSIGNED_LONG && ulkey && entry.Integers.size() == 1)
+    {
+      info->Set(ulkey, static_cast<unsigned long>(entry.Integers[0]));
+    }
+  }
+}
+
+bool AddArray(vtkLayout& layout, int role, vtkAbstractArray* aa, int attributeMask = 0)
+{
+  vtkDataArray* array = vtkDataArray::SafeDownCast(aa);
+  if (!IsSupportedArray(array))
+  {
+    return false;
+  }
+
+  vtkArrayEntry entry;
+  entry.Role = role;
+  entry.AttributeMask = attributeMask;
+  entry.HasName = array->GetName() ? 1 : 0;
+  entry.Name = array->GetName() ? array->GetName() : "";
+  if (array->HasAComponentName())
+  {
+    for (int cc = 0; cc < array->GetNumberOfComponents(); ++cc)
+    {
+      const char* name = array->GetComponentName(cc);
+      entry.ComponentNames.push_back(std::make_pair(name ? 1 : 0, std::string(name ? name : "")));
+    }
+  }
+  if (array->HasInformation())
+  {
+    CollectInformation(array->GetInformation(), entry.Information);
+  }
+  entry.DataType = array->GetDataType();
+  entry.NumberOfComponents = array->GetNumberOfComponents();
+  entry.NumberOfTuples = array->GetNumberOfTuples();
+  entry.RawSize = static_cast<vtkTypeInt64>(array->GetNumberOfValues()) * array->GetDataTypeSize();
+  entry.EncodedSize = entry.RawSize;
+  entry.Array = array;
+  layout.Arrays.push_back(std::move(entry));
+  return true;
+}
+
+bool AddCellArray(vtkLayout& layout, int offsetsRole, vtkCellArray* cells)
+{
+  if (!cells)
+  {
+    return true;
+  }
+  return AddArray(layout, offsetsRole, cells->GetOffsetsArray()) &&
+    AddArray(layout, offsetsRole + 1, cells->GetConnectivityArray());
+}
+
+bool AddAttributes(vtkLayout& layout, int role, vtkFieldData* fd)
+{
+  vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+  if (dsa)
+  {
+    dsa->GetAttributeIndices(indices);
+  }
+  for (int cc = 0, max = fd->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    // an array may be used for several attributes.
+    int attributeMask = 0;
+    for (int attr = 0; dsa && attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+    {
+      attributeMask |= indices[attr] == cc ? (1 << attr) : 0;
+    }
+    if (!AddArray(layout, role, fd->GetAbstractArray(cc), attributeMask))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Builds the array list describing `data`. Returns false if `data` cannot be
+// marshalled as raw array buffers.
+bool Collect(vtkDataObject* data, vtkLayout& layout)
+{
+  if (!data)
+  {
+    return false;
+  }
+
+  layout.DataObjectType = data->GetDataObjectType();
+  layout.BigEndian = IsBigEndian();
+  switch (layout.DataObjectType)
+  {
+    case VTK_POLY_DATA:
+    {
+      vtkPolyData* pd = vtkPolyData::SafeDownCast(data);
+      if ((pd->GetPoints() && !AddArray(layout, POINTS, pd->GetPoints()->GetData())) ||
+        !AddCellArray(layout, VERTS_OFFSETS, pd->GetVerts()) ||
+        !AddCellArray(layout, LINES_OFFSETS, pd->GetLines()) ||
+        !AddCellArray(layout, POLYS_OFFSETS, pd->GetPolys()) ||
+        !AddCellArray(layout, STRIPS_OFFSETS, pd->GetStrips()))
+      {
+        return false;
+      }
+    }
+    break;
+
+    case VTK_UNSTRUCTURED_GRID:
+    {
+      vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(data);
+      if ((ug->GetPoints() && !AddArray(layout, POINTS, ug->GetPoints()->GetData())) ||
+        !AddCellArray(layout, CELLS_OFFSETS, ug->GetCells()) ||
+        (ug->GetCellTypesArray() && !AddArray(layout, CELL_TYPES, ug->GetCellTypesArray())) ||
+        (ug->GetFaceLocations() && !AddArray(layout, FACE_LOCATIONS, ug->GetFaceLocations())) ||
+        (ug->GetFaces() && !AddArray(layout, FACES, ug->GetFaces())))
+      {
+        return false;
+      }
+    }
+    break;
+
+    case VTK_IMAGE_DATA:
+    {
+      vtkImageData* id = vtkImageData::SafeDownCast(data);
+      id->GetExtent(layout.Extent);
+      id->GetOrigin(layout.Origin);
+      id->GetSpacing(layout.Spacing);
+    }
+    break;
+
+    default:
+      return false;
+  }
+
+  if (vtkDataSet* ds = vtkDataSet::SafeDownCast(data))
+  {
+    if (!AddAttributes(layout, POINT_DATA, ds->GetPointData()) ||
+      !AddAttributes(layout, CELL_DATA, ds->GetCellData()))
+    {
+      return false;
+    }
+  }
+  return AddAttributes(layout, FIELD_DATA, data->GetFieldData());
+}
+
+// Compresses arrays using LZ4, keeping the compressed payload only when it
+// is smaller than the raw one.
+void Compress(vtkLayout& layout)
+{
+  for (auto& entry : layout.Arrays)
+  {
+    if (entry.RawSize <= 0 || entry.RawSize > LZ4_MAX_INPUT_SIZE)
+    {
+      continue;
+    }
+    const int rawSize = static_cast<int>(entry.RawSize);
+    const int bound = LZ4_compressBound(rawSize);
+    entry.Compressed.resize(static_cast<size_t>(bound));
+    const int compressedSize =
+      LZ4_compress_default(static_cast<const char*>(entry.Array->GetVoidPointer(0)),
+        entry.Compressed.data(), rawSize, bound);
+    if (compressedSize > 0 && compressedSize < rawSize)
+    {
+      entry.Compressed.resize(static_cast<size_t>(compressedSize));
+      entry.EncodedSize = compressedSize;
+    }
+    else
+    {
+      entry.Compressed.clear();
+      entry.Compressed.shrink_to_fit();
+    }
+  }
+}
+
+void WriteHeader(const vtkLayout& layout, vtkMultiProcessStream& stream)
+{
+  stream << layout.DataObjectType << layout.BigEndian;
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    stream << layout.Extent[cc];
+  }
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    stream << layout.Origin[cc] << layout.Spacing[cc];
+  }
+  stream << static_cast<unsigned int>(layout.Arrays.size());
+  for (const auto& entry : layout.Arrays)
+  {
+    stream << entry.Role << entry.AttributeMask << entry.HasName << entry.Name << entry.DataType
+           << entry.NumberOfComponents << entry.NumberOfTuples << entry.RawSize
+           << entry.EncodedSize;
+    stream << static_cast<unsigned int>(entry.ComponentNames.size());
+    for (const auto& name : entry.ComponentNames)
+    {
+      stream << name.first << name.second;
+    }
+    stream << static_cast<unsigned int>(entry.Information.size());
+    for (const auto& info : entry.Information)
+    {
+      stream << info.Location << info.Name << info.Type
+             << static_cast<unsigned int>(info.Doubles.size())
+             << static_cast<unsigned int>(info.Integers.size())
+             << static_cast<unsigned int>(info.Strings.size());
+      for (double value : info.Doubles)
+      {
+        stream << value;
+      }
+      for (vtkTypeInt64 value : info.Integers)
+      {
+        stream << value;
+      }
+      for (const auto& value : info.Strings)
+      {
+        stream << value;
+      }
+    }
+  }
+}
+
+bool ReadHeader(vtkMultiProcessStream& stream, vtkLayout& layout)
+{
+  stream >> layout.DataObjectType >> layout.BigEndian;
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    stream >> layout.Extent[cc];
+  }
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    stream >> layout.Origin[cc] >> layout.Spacing[cc];
+  }
+  unsigned int numArrays = 0;
+  stream >> numArrays;
+  layout.Arrays.resize(numArrays);
+  for (auto& entry : layout.Arrays)
+  {
+    stream >> entry.Role >> entry.AttributeMask >> entry.HasName >> entry.Name >> entry.DataType >>
+      entry.NumberOfComponents >> entry.NumberOfTuples >> entry.RawSize >> entry.EncodedSize;
+    if (entry.RawSize < 0 || entry.EncodedSize < 0 || entry.NumberOfComponents < 1)
+    {
+      return false;
+    }
+
+    unsigned int numComponentNames = 0;
+    stream >> numComponentNames;
+    if (numComponentNames != 0 &&
+      numComponentNames != static_cast<unsigned int>(entry.NumberOfComponents))
+    {
+      return false;
+    }
+    entry.ComponentNames.resize(numComponentNames);
+    for (auto& name : entry.ComponentNames)
+    {
+      stream >> name.first >> name.second;
+    }
+
+    unsigned int numKeys = 0;
+    stream >> numKeys;
+    entry.Information.resize(numKeys);
+    for (auto& info : entry.Information)
+    {
+      unsigned int numDoubles = 0, numIntegers = 0, numStrings = 0;
+      stream >> info.Location >> info.Name >> info.Type >> numDoubles >> numIntegers >> numStrings;
+      if (info.Type < KEY_DOUBLE || info.Type > KEY_UNSIGNED_LONG)
+      {
+        return false;
+      }
+      info.Doubles.resize(numDoubles);
+      info.Integers.resize(numIntegers);
+      info.Strings.resize(numStrings);
+      for (auto& value : info.Doubles)
+      {
+        stream >> value;
+      }
+      for (auto& value : info.Integers)
+      {
+        stream >> value;
+      }
+      for (auto& value : info.Strings)
+      {
+        stream >> value;
+      }
+    }
+  }
+  return layout.DataObjectType == VTK_POLY_DATA || layout.DataObjectType == VTK_UNSTRUCTURED_GRID ||
+    layout.DataObjectType == VTK_IMAGE_DATA;
+}
+
+// Allocates the arrays described by the layout. The payloads are to be
+// filled in using `Decode`.
+bool Allocate(const vtkLayout& layout, std::vector<vtkSmartPointer<vtkDataArray> >& arrays)
+{
+  arrays.clear();
+  arrays.reserve(layout.Arrays.size());
+  for (const auto& entry : layout.Arrays)
+  {
+    vtkSmartPointer<vtkDataArray> array;
+    array.TakeReference(vtkDataArray::CreateDataArray(entry.DataType));
+    if (!array)
+    {
+      return false;
+    }
+    array->SetNumberOfComponents(entry.NumberOfComponents);
+    array->SetNumberOfTuples(entry.NumberOfTuples);
+    if (static_cast<vtkTypeInt64>(array->GetNumberOfValues()) * array->GetDataTypeSize() !=
+      entry.RawSize)
+    {
+      return false;
+    }
+    if (entry.HasName)
+    {
+      array->SetName(entry.Name.c_str());
+    }
+    for (size_t cc = 0; cc < entry.ComponentNames.size(); ++cc)
+    {
+      if (entry.ComponentNames[cc].first)
+      {
+        array->SetComponentName(
+          static_cast<vtkIdType>(cc), entry.ComponentNames[cc].second.c_str());
+      }
+    }
+    if (!entry.Information.empty())
+    {
+      RestoreInformation(entry.Information, array->GetInformation());
+    }
+    arrays.push_back(array);
+  }
+  return true;
+}
+
+// Fills `array` using the encoded payload.
+bool Decode(const vtkArrayEntry& entry, const char* payload, vtkDataArray* array)
+{
+  if (entry.RawSize == 0)
+  {
+    return true;
+  }
+  char* dest = static_cast<char*>(array->GetVoidPointer(0));
+  if (!entry.IsCompressed())
+  {
+    std::memcpy(dest, payload, static_cast<size_t>(entry.RawSize));
+    return true;
+  }
+  const int decompressedSize = LZ4_decompress_safe(payload, dest,
+    static_cast<int>(entry.EncodedSize), static_cast<int>(entry.RawSize));
+  return decompressedSize == entry.RawSize;
+}
+
+void SwapBytes(const vtkLayout& layout, const std::vector<vtkSmartPointer<vtkDataArray> >& arrays)
+{
+  if (layout.BigEndian == IsBigEndian())
+  {
+    return;
+  }
+  for (auto& array : arrays)
+  {
+    if (array->GetDataTypeSize() > 1)
+    {
+      vtkByteSwap::SwapVoidRange(
+        array->GetVoidPointer(0), array->GetNumberOfValues(), array->GetDataTypeSize());
+    }
+  }
+}
+
+vtkCellArray* NewCellArray(vtkDataArray* offsets, vtkDataArray* connectivity)
+{
+  vtkCellArray* cells = vtkCellArray::New();
+  if (offsets && connectivity)
+  {
+    cells->SetData(offsets, connectivity);
+  }
+  return cells;
+}
+
+// Builds the data object from the decoded arrays.
+vtkDataObject* Assemble(
+  const vtkLayout& layout, const std::vector<vtkSmartPointer<vtkDataArray> >& arrays)
+{
+  vtkDataArray* roles[FACES + 1] = { nullptr };
+  for (size_t cc = 0; cc < arrays.size(); ++cc)
+  {
+    const int role = layout.Arrays[cc].Role;
+    if (role >= POINTS && role <= FACES)
+    {
+      roles[role] = arrays[cc];
+    }
+  }
+
+  vtkSmartPointer<vtkDataObject> data;
+  vtkSmartPointer<vtkPoints> points;
+  if (roles[POINTS])
+  {
+    points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(roles[POINTS]);
+  }
+
+  switch (layout.DataObjectType)
+  {
+    case VTK_POLY_DATA:
+    {
+      auto pd = vtkSmartPointer<vtkPolyData>::New();
+      pd->SetPoints(points);
+      if (roles[VERTS_OFFSETS])
+      {
+        vtkCellArray* verts = NewCellArray(roles[VERTS_OFFSETS], roles[VERTS_CONNECTIVITY]);
+        pd->SetVerts(verts);
+        verts->Delete();
+      }
+      if (roles[LINES_OFFSETS])
+      {
+        vtkCellArray* lines = NewCellArray(roles[LINES_OFFSETS], roles[LINES_CONNECTIVITY]);
+        pd->SetLines(lines);
+        lines->Delete();
+      }
+      if (roles[POLYS_OFFSETS])
+      {
+        vtkCellArray* polys = NewCellArray(roles[POLYS_OFFSETS], roles[POLYS_CONNECTIVITY]);
+        pd->SetPolys(polys);
+        polys->Delete();
+      }
+      if (roles[STRIPS_OFFSETS])
+      {
+        vtkCellArray* strips = NewCellArray(roles[STRIPS_OFFSETS], roles[STRIPS_CONNECTIVITY]);
+        pd->SetStrips(strips);
+        strips->Delete();
+      }
+      data = pd;
+    }
+    break;
+
+    case VTK_UNSTRUCTURED_GRID:
+    {
+      auto ug = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      ug->SetPoints(points);
+      auto types = vtkUnsignedCharArray::SafeDownCast(roles[CELL_TYPES]);
+      if (roles[CELLS_OFFSETS] && types)
+      {
+        vtkCellArray* cells = NewCellArray(roles[CELLS_OFFSETS], roles[CELLS_CONNECTIVITY]);
+        ug->SetCells(types, cells, vtkIdTypeArray::SafeDownCast(roles[FACE_LOCATIONS]),
+          vtkIdTypeArray::SafeDownCast(roles[FACES]));
+        cells->Delete();
+      }
+      data = ug;
+    }
+    break;
+
+    case VTK_IMAGE_DATA:
+    {
+      auto id = vtkSmartPointer<vtkImageData>::New();
+      id->SetExtent(const_cast<int*>(layout.Extent));
+      id->SetOrigin(layout.Origin[0], layout.Origin[1], layout.Origin[2]);
+      id->SetSpacing(layout.Spacing[0], layout.Spacing[1], layout.Spacing[2]);
+      data = id;
+    }
+    break;
+
+    default:
+      return nullptr;
+  }
+
+  vtkDataSet* ds = vtkDataSet::SafeDownCast(data);
+  for (size_t cc = 0; cc < arrays.size(); ++cc)
+  {
+    const vtkArrayEntry& entry = layout.Arrays[cc];
+    vtkDataSetAttributes* dsa = nullptr;
+    switch (entry.Role)
+    {
+      case POINT_DATA:
+        dsa = ds->GetPointData();
+        break;
+      case CELL_DATA:
+        dsa = ds->GetCellData();
+        break;
+      case FIELD_DATA:
+        data->GetFieldData()->AddArray(arrays[cc]);
+        continue;
+      default:
+        continue;
+    }
+    const int idx = dsa->AddArray(arrays[cc]);
+    for (int attr = 0; idx >= 0 && attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+    {
+      if ((entry.AttributeMask & (1 << attr)) != 0)
+      {
+        dsa->SetActiveAttribute(idx, attr);
+      }
+    }
+  }
+
+  data->Register(nullptr);
+  return data;
+}
+}
+
+vtkStandardNewMacro(vtkArrayBufferMarshaller);
+//----------------------------------------------------------------------------
+vtkArrayBufferMarshaller::vtkArrayBufferMarshaller()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkArrayBufferMarshaller::~vtkArrayBufferMarshaller()
+{
+}
+
+//----------------------------------------------------------------------------
+bool vtkArrayBufferMarshaller::CanMarshal(vtkDataObject* data)
+{
+  vtkLayout layout;
+  return Collect(data, layout);
+}
+
+//----------------------------------------------------------------------------
+char* vtkArrayBufferMarshaller::Marshal(vtkDataObject* data, vtkIdType& length, bool compress)
+{
+  length = 0;
+  vtkLayout layout;
+  if (!Collect(data, layout))
+  {
+    return nullptr;
+  }
+  if (compress)
+  {
+    Compress(layout);
+  }
+
+  vtkMultiProcessStream stream;
+  WriteHeader(layout, stream);
+  std::vector<unsigned char> header;
+  stream.GetRawData(header);
+
+  vtkTypeInt64 total = PREAMBLE_SIZE + static_cast<vtkTypeInt64>(header.size());
+  for (const auto& entry : layout.Arrays)
+  {
+    total += entry.EncodedSize;
+  }
+
+  char* buffer = new char[static_cast<size_t>(total)];
+  std::memcpy(buffer, MAGIC, sizeof(MAGIC));
+  vtkTypeUInt64 headerSize = static_cast<vtkTypeUInt64>(header.size());
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    buffer[8 + cc] = static_cast<char>((headerSize >> (8 * cc)) & 0xff);
+  }
+  char* cursor = buffer + PREAMBLE_SIZE;
+  if (!header.empty())
+  {
+    std::memcpy(cursor, header.data(), header.size());
+    cursor += header.size();
+  }
+  for (const auto& entry : layout.Arrays)
+  {
+    if (entry.EncodedSize > 0)
+    {
+      std::memcpy(cursor, entry.GetPayload(), static_cast<size_t>(entry.EncodedSize));
+      cursor += entry.EncodedSize;
+    }
+  }
+
+  length = static_cast<vtkIdType>(total);
+  return buffer;
+}
+
+//----------------------------------------------------------------------------
+bool vtkArrayBufferMarshaller::IsMarshalledBuffer(const char* buffer, vtkIdType length)
+{
+  return buffer && length >= PREAMBLE_SIZE && std::memcmp(buffer, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkArrayBufferMarshaller::Unmarshal(const char* buffer, vtkIdType length)
+{
+  if (!vtkArrayBufferMarshaller::IsMarshalledBuffer(buffer, length))
+  {
+    return nullptr;
+  }
+
+  vtkTypeUInt64 headerSize = 0;
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    headerSize |= static_cast<vtkTypeUInt64>(static_cast<unsigned char>(buffer[8 + cc]))
+      << (8 * cc);
+  }
+  if (headerSize > static_cast<vtkTypeUInt64>(length - PREAMBLE_SIZE))
+  {
+    vtkGenericWarningMacro("Corrupted array buffer header.");
+    return nullptr;
+  }
+
+  vtkMultiProcessStream stream;
+  stream.SetRawData(reinterpret_cast<const unsigned char*>(buffer + PREAMBLE_SIZE),
+    static_cast<unsigned int>(headerSize));
+  vtkLayout layout;
+  std::vector<vtkSmartPointer<vtkDataArray> > arrays;
+  if (!ReadHeader(stream, layout) || !Allocate(layout, arrays))
+  {
+    vtkGenericWarningMacro("Corrupted array buffer header.");
+    return nullptr;
+  }
+
+  const char* cursor = buffer + PREAMBLE_SIZE + headerSize;
+  const char* end = buffer + length;
+  for (size_t cc = 0; cc < arrays.size(); ++cc)
+  {
+    const vtkArrayEntry& entry = layout.Arrays[cc];
+    if (entry.EncodedSize > end - cursor || !Decode(entry, cursor, arrays[cc]))
+    {
+      vtkGenericWarningMacro("Corrupted array buffer payload.");
+      return nullptr;
+    }
+    cursor += entry.EncodedSize;
+  }
+
+  SwapBytes(layout, arrays);
+  return Assemble(layout, arrays);
+}
+
+//----------------------------------------------------------------------------
+int vtkArrayBufferMarshaller::Send(vtkDataObject* data, vtkMultiProcessController* controller,
+  int remoteId, int tag, bool compress)
+{
+  vtkLayout layout;
+  vtkMultiProcessStream stream;
+  if (!Collect(data, layout))
+  {
+    stream << static_cast<int>(FORMAT_DATA_OBJECT);
+    if (!controller->Send(stream, remoteId, tag))
+    {
+      return 0;
+    }
+    return controller->Send(data, remoteId, tag);
+  }
+
+  if (compress)
+  {
+    Compress(layout);
+  }
+  stream << static_cast<int>(FORMAT_ARRAY_BUFFERS);
+  WriteHeader(layout, stream);
+  if (!controller->Send(stream, remoteId, tag))
+  {
+    return 0;
+  }
+
+  // Send each array's memory (or its compressed counterpart) directly.
+  for (const auto& entry : layout.Arrays)
+  {
+    if (entry.EncodedSize > 0 &&
+      !controller->Send(
+        entry.GetPayload(), static_cast<vtkIdType>(entry.EncodedSize), remoteId, tag))
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkArrayBufferMarshaller::Receive(
+  vtkMultiProcessController* controller, int remoteId, int tag)
+{
+  vtkMultiProcessStream stream;
+  if (!controller->Receive(stream, remoteId, tag))
+  {
+    return nullptr;
+  }
+
+  int format = FORMAT_DATA_OBJECT;
+  stream >> format;
+  if (format == FORMAT_DATA_OBJECT)
+  {
+    return controller->ReceiveDataObject(remoteId, tag);
+  }
+
+  vtkLayout layout;
+  std::vector<vtkSmartPointer<vtkDataArray> > arrays;
+  const bool valid = ReadHeader(stream, layout) && Allocate(layout, arrays);
+
+  // Receive the payloads even if the header is invalid to keep the
+  // communication in sync with the sender.
+  std::vector<char> encoded;
+  bool decoded = valid;
+  for (size_t cc = 0; cc < layout.Arrays.size(); ++cc)
+  {
+    const vtkArrayEntry& entry = layout.Arrays[cc];
+    if (entry.EncodedSize == 0)
+    {
+      continue;
+    }
+    if (valid && !entry.IsCompressed())
+    {
+      // Receive directly into the array's memory.
+      if (!controller->Receive(static_cast<char*>(arrays[cc]->GetVoidPointer(0)),
+            static_cast<vtkIdType>(entry.EncodedSize), remoteId, tag))
+      {
+        return nullptr;
+      }
+      continue;
+    }
+    encoded.resize(static_cast<size_t>(entry.EncodedSize));
+    if (!controller->Receive(
+          encoded.data(), static_cast<vtkIdType>(entry.EncodedSize), remoteId, tag))
+    {
+      return nullptr;
+    }
+    decoded = decoded && Decode(entry, encoded.data(), arrays[cc]);
+  }
+
+  if (!decoded)
+  {
+    vtkGenericWarningMacro("Failed to receive array buffers.");
+    return nullptr;
+  }
+
+  SwapBytes(layout, arrays);
+  return Assemble(layout, arrays);
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayBufferMarshaller::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
@@ -0,0 +1,107 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkArrayBufferMarshaller.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkArrayBufferMarshaller
+ * @brief   marshals datasets as raw array buffers for data movement.
+ *
+ * vtkArrayBufferMarshaller is used by vtkMPIMoveData and
+ * vtkClientServerMoveData to move datasets between processes without going
+ * through the legacy VTK file format. A dataset is described by a small
+ * header, serialized using vtkMultiProcessStream, that lists the arrays
+ * making up the dataset (points, cells, attribute arrays) followed by the raw
+ * memory for each of the arrays. The header also carries array names,
+ * component names, the attributes each array is used for and the array
+ * information keys of the types supported by the legacy writer. Arrays can
+ * optionally be compressed using LZ4, in which case an array is sent
+ * compressed only if that reduces its size.
+ *
+ * `Send` and `Receive` send the header followed by each array's memory
+ * directly, avoiding any intermediate copies on either side when compression
+ * is not used. `Marshal` and `Unmarshal` use the same layout in a single
+ * contiguous buffer, for use with collective operations.
+ *
+ * Only vtkPolyData, vtkUnstructuredGrid and vtkImageData with arrays using
+ * the standard array-of-structures memory layout are supported (see
+ * `CanMarshal`). `Send` and `Receive` fall back to
+ * vtkMultiProcessController's data object communication for other types,
+ * while `Marshal` returns nullptr and lets the caller pick another format.
+ *
+ * Array payloads are stored in the sender's native byte order and swapped by
+ * the receiver, if needed.
+ */
+
+#ifndef vtkArrayBufferMarshaller_h
+#define vtkArrayBufferMarshaller_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+
+class vtkDataObject;
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkArrayBufferMarshaller : public vtkObject
+{
+public:
+  static vtkArrayBufferMarshaller* New();
+  vtkTypeMacro(vtkArrayBufferMarshaller, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Returns true if `data` can be marshalled as raw array buffers.
+   */
+  static bool CanMarshal(vtkDataObject* data);
+
+  /**
+   * Marshals `data` into a newly allocated contiguous buffer. The caller is
+   * responsible for releasing the buffer using `delete[]`. Returns nullptr if
+   * the data cannot be marshalled.
+   */
+  static char* Marshal(vtkDataObject* data, vtkIdType& length, bool compress);
+
+  /**
+   * Returns true if the buffer was generated by `Marshal`.
+   */
+  static bool IsMarshalledBuffer(const char* buffer, vtkIdType length);
+
+  /**
+   * Reconstructs the data object from a buffer generated by `Marshal`. Returns
+   * a new instance (the caller is responsible for releasing it) or nullptr on
+   * failure.
+   */
+  static vtkDataObject* Unmarshal(const char* buffer, vtkIdType length);
+
+  /**
+   * Sends `data` to `remoteId`. Unsupported data types are sent using
+   * vtkMultiProcessController::Send(vtkDataObject*, ...). Returns 1 on success.
+   */
+  static int Send(vtkDataObject* data, vtkMultiProcessController* controller, int remoteId,
+    int tag, bool compress);
+
+  /**
+   * Receives a data object sent using `Send`. Returns a new instance (the
+   * caller is responsible for releasing it) or nullptr on failure.
+   */
+  static vtkDataObject* Receive(vtkMultiProcessController* controller, int remoteId, int tag);
+
+protected:
+  vtkArrayBufferMarshaller();
+  ~vtkArrayBufferMarshaller() override;
+
+private:
+  vtkArrayBufferMarshaller(const vtkArrayBufferMarshaller&) = delete;
+  void operator=(const vtkArrayBufferMarshaller&) = delete;
+};
+
+#endif
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkClientServerMoveData.h"
 
+#include "vtkArrayBufferMarshaller.h"
 #include "vtkCharArray.h"
 #include "vtkDataObject.h"
 #include "vtkDataObjectTypes.h"
@@ -21,6 +22,7 @@
 #include "vtkGenericDataObjectWriter.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMPIMoveData.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
@@ -211,7 +213,10 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
     }
   }
 
-  return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  // Send the arrays directly, when possible, to avoid the cost of the legacy
+  // writer/reader.
+  return vtkArrayBufferMarshaller::Send(input, controller, 1,
+    vtkClientServerMoveData::TRANSMIT_DATA_OBJECT, vtkMPIMoveData::GetUseLZ4Compression());
 }
 
 //-----------------------------------------------------------------------------
@@ -240,7 +245,8 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
   }
   else
   {
-    data = controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    data = vtkArrayBufferMarshaller::Receive(
+      controller, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
   }
   return data;
 }
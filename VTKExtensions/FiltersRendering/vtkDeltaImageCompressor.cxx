@@ -0,0 +1,432 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDeltaImageCompressor.h"
+
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtk_lz4.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+// Header of a compressed image:
+// [magic, width, height, components, tile size, key frame, number of changed
+// tiles], followed by the indices of the changed tiles (omitted for key frames)
+// and the LZ4 compressed pixels of the changed tiles.
+enum
+{
+  HEADER_MAGIC = 0,
+  HEADER_WIDTH,
+  HEADER_HEIGHT,
+  HEADER_COMPONENTS,
+  HEADER_TILE_SIZE,
+  HEADER_KEY_FRAME,
+  HEADER_NUMBER_OF_CHANGED_TILES,
+  HEADER_SIZE
+};
+const int MAGIC = 0x44544943; // "DTIC"
+
+class vtkTiling
+{
+public:
+  vtkTiling(int width, int height, int components, int tileSize)
+    : Width(width)
+    , Height(height)
+    , Components(components)
+    , TileSize(tileSize)
+    , TilesX((width + tileSize - 1) / tileSize)
+    , TilesY((height + tileSize - 1) / tileSize)
+  {
+  }
+
+  int GetNumberOfTiles() const { return this->TilesX * this->TilesY; }
+
+  // Calls `op(offset, rowLength)` for each row of the tile, with offsets and
+  // lengths in bytes.
+  template <typename Op>
+  void ForEachRow(int tile, Op&& op) const
+  {
+    const int x0 = (tile % this->TilesX) * this->TileSize;
+    const int y0 = (tile / this->TilesX) * this->TileSize;
+    const int x1 = std::min(x0 + this->TileSize, this->Width);
+    const int y1 = std::min(y0 + this->TileSize, this->Height);
+    const size_t rowLength = static_cast<size_t>(x1 - x0) * this->Components;
+    for (int y = y0; y < y1; ++y)
+    {
+      op((static_cast<size_t>(y) * this->Width + x0) * this->Components, rowLength);
+    }
+  }
+
+  size_t GetTileLength(int tile) const
+  {
+    size_t length = 0;
+    this->ForEachRow(tile, [&length](size_t, size_t rowLength) { length += rowLength; });
+    return length;
+  }
+
+private:
+  int Width;
+  int Height;
+  int Components;
+  int TileSize;
+  int TilesX;
+  int TilesY;
+};
+}
+
+vtkStandardNewMacro(vtkDeltaImageCompressor);
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::vtkDeltaImageCompressor()
+  : Quality(0)
+  , TileSize(64)
+  , KeyFrameInterval(60)
+  , Width(0)
+  , Height(0)
+  , FramesSinceKeyFrame(0)
+  , KeyFrameRequested(true)
+  , NumberOfTiles(0)
+  , NumberOfChangedTiles(0)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::~vtkDeltaImageCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::Reset()
+{
+  this->SentImage->Initialize();
+  this->ReceivedImage->Initialize();
+  this->KeyFrameRequested = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SetImageResolution(int width, int height)
+{
+  if (this->Width != width || this->Height != height)
+  {
+    this->Width = width;
+    this->Height = height;
+    this->Reset();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
+    { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
+    { 0xE0, 0xF0, 0xE0, 0xE0 } };
+  int compress_level = this->LossLessMode ? 0 : this->Quality;
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int components = input->GetNumberOfComponents();
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  const vtkIdType numValues = numPixels * components;
+
+  // When the resolution does not match the input, treat it as a single row.
+  int width = this->Width;
+  int height = this->Height;
+  if (static_cast<vtkIdType>(width) * height != numPixels)
+  {
+    width = static_cast<int>(numPixels);
+    height = 1;
+  }
+
+  if (compress_level > 0 && components == 4)
+  {
+    unsigned int compress_mask;
+    memcpy(&compress_mask, &compress_masks[compress_level], 4);
+    this->MaskedImage->SetNumberOfComponents(components);
+    this->MaskedImage->SetNumberOfTuples(numPixels);
+    const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
+    unsigned int* out = reinterpret_cast<unsigned int*>(this->MaskedImage->GetPointer(0));
+    for (vtkIdType cc = 0; cc < numPixels; ++cc)
+    {
+      out[cc] = in[cc] & compress_mask;
+    }
+    input = this->MaskedImage.Get();
+  }
+
+  bool keyFrame = this->KeyFrameRequested ||
+    this->SentImage->GetNumberOfComponents() != components ||
+    this->SentImage->GetNumberOfTuples() != numPixels ||
+    (this->KeyFrameInterval > 0 && this->FramesSinceKeyFrame >= this->KeyFrameInterval);
+  if (keyFrame)
+  {
+    this->SentImage->SetNumberOfComponents(components);
+    this->SentImage->SetNumberOfTuples(numPixels);
+  }
+
+  // Gather the changed tiles, updating the last image sent as we go.
+  vtkTiling tiling(width, height, components, this->TileSize);
+  const unsigned char* current = input->GetPointer(0);
+  unsigned char* previous = this->SentImage->GetPointer(0);
+  this->TileBuffer->SetNumberOfTuples(numValues);
+  unsigned char* tileBuffer = this->TileBuffer->GetPointer(0);
+  size_t tileBufferLength = 0;
+  std::vector<int> changedTiles;
+  for (int tile = 0, max = tiling.GetNumberOfTiles(); tile < max; ++tile)
+  {
+    bool changed = keyFrame;
+    if (!changed)
+    {
+      tiling.ForEachRow(tile, [&](size_t offset, size_t length) {
+        changed = changed || memcmp(current + offset, previous + offset, length) != 0;
+      });
+    }
+    if (changed)
+    {
+      changedTiles.push_back(tile);
+      tiling.ForEachRow(tile, [&](size_t offset, size_t length) {
+        memcpy(tileBuffer + tileBufferLength, current + offset, length);
+        memcpy(previous + offset, current + offset, length);
+        tileBufferLength += length;
+      });
+    }
+  }
+  if (static_cast<int>(changedTiles.size()) == tiling.GetNumberOfTiles())
+  {
+    // No point in sending the tile indices if all tiles changed.
+    keyFrame = true;
+  }
+
+  this->NumberOfTiles = tiling.GetNumberOfTiles();
+  this->NumberOfChangedTiles = static_cast<int>(changedTiles.size());
+  this->FramesSinceKeyFrame = keyFrame ? 1 : this->FramesSinceKeyFrame + 1;
+  this->KeyFrameRequested = false;
+
+  int header[HEADER_SIZE];
+  header[HEADER_MAGIC] = MAGIC;
+  header[HEADER_WIDTH] = width;
+  header[HEADER_HEIGHT] = height;
+  header[HEADER_COMPONENTS] = components;
+  header[HEADER_TILE_SIZE] = this->TileSize;
+  header[HEADER_KEY_FRAME] = keyFrame ? 1 : 0;
+  header[HEADER_NUMBER_OF_CHANGED_TILES] = this->NumberOfChangedTiles;
+
+  const size_t indicesLength = keyFrame ? 0 : changedTiles.size() * sizeof(int);
+  const size_t prefixLength = sizeof(header) + indicesLength;
+  const int maxOutputSize = LZ4_compressBound(static_cast<int>(tileBufferLength));
+  this->Output->SetNumberOfComponents(1);
+  unsigned char* output = this->Output->WritePointer(0, prefixLength + maxOutputSize);
+  memcpy(output, header, sizeof(header));
+  if (indicesLength > 0)
+  {
+    memcpy(output + sizeof(header), changedTiles.data(), indicesLength);
+  }
+
+  int compressedSize = 0;
+  if (tileBufferLength > 0)
+  {
+    compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(tileBuffer),
+      reinterpret_cast<char*>(output + prefixLength), static_cast<int>(tileBufferLength),
+      maxOutputSize, 16);
+    if (compressedSize <= 0)
+    {
+      this->Reset();
+      return VTK_ERROR;
+    }
+  }
+  this->Output->SetNumberOfTuples(prefixLength + compressedSize);
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const unsigned char* input = this->Input->GetPointer(0);
+  const size_t inputLength = static_cast<size_t>(this->Input->GetNumberOfValues());
+  int header[HEADER_SIZE];
+  if (inputLength < sizeof(header))
+  {
+    vtkWarningMacro("Cannot decompress, invalid input.");
+    return VTK_ERROR;
+  }
+  memcpy(header, input, sizeof(header));
+
+  const int width = header[HEADER_WIDTH];
+  const int height = header[HEADER_HEIGHT];
+  const int components = header[HEADER_COMPONENTS];
+  const bool keyFrame = header[HEADER_KEY_FRAME] != 0;
+  const int numChanged = header[HEADER_NUMBER_OF_CHANGED_TILES];
+  if (header[HEADER_MAGIC] != MAGIC || width < 0 || height < 0 || header[HEADER_TILE_SIZE] < 1 ||
+    components != this->Output->GetNumberOfComponents() ||
+    static_cast<vtkIdType>(width) * height != this->Output->GetNumberOfTuples())
+  {
+    vtkWarningMacro("Cannot decompress, input does not match the output image.");
+    return VTK_ERROR;
+  }
+
+  const vtkIdType numPixels = this->Output->GetNumberOfTuples();
+  if (keyFrame)
+  {
+    this->ReceivedImage->SetNumberOfComponents(components);
+    this->ReceivedImage->SetNumberOfTuples(numPixels);
+  }
+  else if (this->ReceivedImage->GetNumberOfComponents() != components ||
+    this->ReceivedImage->GetNumberOfTuples() != numPixels)
+  {
+    vtkWarningMacro("Cannot decompress, missing key frame.");
+    return VTK_ERROR;
+  }
+
+  vtkTiling tiling(width, height, components, header[HEADER_TILE_SIZE]);
+  std::vector<int> changedTiles;
+  size_t offset = sizeof(header);
+  if (keyFrame)
+  {
+    changedTiles.resize(tiling.GetNumberOfTiles());
+    for (int tile = 0; tile < tiling.GetNumberOfTiles(); ++tile)
+    {
+      changedTiles[tile] = tile;
+    }
+  }
+  else
+  {
+    if (numChanged < 0 || numChanged > tiling.GetNumberOfTiles() ||
+      inputLength < offset + numChanged * sizeof(int))
+    {
+      vtkWarningMacro("Cannot decompress, invalid input.");
+      return VTK_ERROR;
+    }
+    changedTiles.resize(numChanged);
+    memcpy(changedTiles.data(), input + offset, numChanged * sizeof(int));
+    offset += numChanged * sizeof(int);
+  }
+
+  size_t tileBufferLength = 0;
+  for (int tile : changedTiles)
+  {
+    if (tile < 0 || tile >= tiling.GetNumberOfTiles())
+    {
+      vtkWarningMacro("Cannot decompress, invalid input.");
+      return VTK_ERROR;
+    }
+    tileBufferLength += tiling.GetTileLength(tile);
+  }
+
+  this->TileBuffer->SetNumberOfTuples(tileBufferLength);
+  unsigned char* tileBuffer = this->TileBuffer->GetPointer(0);
+  if (tileBufferLength > 0)
+  {
+    const int decompressedSize =
+      LZ4_decompress_safe(reinterpret_cast<const char*>(input + offset),
+        reinterpret_cast<char*>(tileBuffer), static_cast<int>(inputLength - offset),
+        static_cast<int>(tileBufferLength));
+    if (decompressedSize != static_cast<int>(tileBufferLength))
+    {
+      this->ReceivedImage->Initialize();
+      return VTK_ERROR;
+    }
+  }
+
+  // Apply the changed tiles to the last image received.
+  unsigned char* received = this->ReceivedImage->GetPointer(0);
+  size_t tileBufferOffset = 0;
+  for (int tile : changedTiles)
+  {
+    tiling.ForEachRow(tile, [&](size_t rowOffset, size_t length) {
+      memcpy(received + rowOffset, tileBuffer + tileBufferOffset, length);
+      tileBufferOffset += length;
+    });
+  }
+
+  this->NumberOfTiles = tiling.GetNumberOfTiles();
+  this->NumberOfChangedTiles = static_cast<int>(changedTiles.size());
+  memcpy(this->Output->GetPointer(0), received, static_cast<size_t>(numPixels) * components);
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->Quality << this->TileSize << this->KeyFrameInterval;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkDeltaImageCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int quality, tileSize, keyFrameInterval;
+    *stream >> quality >> tileSize >> keyFrameInterval;
+    this->SetQuality(quality);
+    this->SetTileSize(tileSize);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    this->Reset();
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality << " " << this->TileSize
+      << " " << this->KeyFrameInterval;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int quality, tileSize, keyFrameInterval;
+    iss >> quality >> tileSize >> keyFrameInterval;
+    this->SetQuality(quality);
+    this->SetTileSize(tileSize);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    this->Reset();
+    return stream + iss.tellg();
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "TileSize: " << this->TileSize << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+  os << indent << "NumberOfTiles: " << this->NumberOfTiles << endl;
+  os << indent << "NumberOfChangedTiles: " << this->NumberOfChangedTiles << endl;
+}
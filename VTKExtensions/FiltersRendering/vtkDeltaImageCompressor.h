@@ -0,0 +1,154 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDeltaImageCompressor
+ * @brief   Image compressor/decompressor
+ * that only sends tiles that changed since the previous image.
+ *
+ * vtkDeltaImageCompressor splits images into square tiles and keeps a copy of
+ * the last image compressed (and decompressed) to only encode the tiles that
+ * changed since then. The changed tiles are compressed using LZ4. This is
+ * well suited for remote rendering where interactions often only change a
+ * small part of the rendered image, or nothing at all.
+ *
+ * Since the sender and the receiver must agree on the previous image, all
+ * images compressed by a vtkDeltaImageCompressor instance must be
+ * decompressed, in the same order, by a single vtkDeltaImageCompressor
+ * instance. A key frame, which includes all tiles, is generated for the first
+ * image, when the image resolution changes, when the configuration changes and
+ * every `KeyFrameInterval` images.
+ *
+ * The configuration stream is:
+ * [ClassName, LossLessMode, Quality, TileSize, KeyFrameInterval].
+ */
+
+#ifndef vtkDeltaImageCompressor_h
+#define vtkDeltaImageCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkNew.h"                                   // needed for vtkNew
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for exports
+
+class vtkMultiProcessStream;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkDeltaImageCompressor : public vtkImageCompressor
+{
+public:
+  static vtkDeltaImageCompressor* New();
+  vtkTypeMacro(vtkDeltaImageCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set the quality measure. The value can be between 0 and 5. 0 means preserve
+   * input image quality while 5 means improve compression at the cost of image
+   * quality. This uses the same color masks as vtkLZ4Compressor.
+   */
+  vtkSetClampMacro(Quality, int, 0, 5);
+  vtkGetMacro(Quality, int);
+  //@}
+
+  //@{
+  /**
+   * Set the size of the square tiles, in pixels. Default is 64.
+   */
+  vtkSetClampMacro(TileSize, int, 8, 1024);
+  vtkGetMacro(TileSize, int);
+  //@}
+
+  //@{
+  /**
+   * Set the number of images between key frames. Key frames include all
+   * tiles, which limits how long artifacts can persist. 0 means key frames are
+   * only generated when required. Default is 60.
+   */
+  vtkSetClampMacro(KeyFrameInterval, int, 0, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  //@}
+
+  /**
+   * Forces the next compressed image to be a key frame.
+   */
+  void ForceKeyFrame() { this->KeyFrameRequested = true; }
+
+  //@{
+  /**
+   * Returns the number of tiles and the number of changed tiles encoded in the
+   * last compressed image.
+   */
+  vtkGetMacro(NumberOfTiles, int);
+  vtkGetMacro(NumberOfChangedTiles, int);
+  //@}
+
+  //@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  //@}
+
+  /**
+   * Communicates the next expected image resolution.
+   */
+  void SetImageResolution(int width, int height) override;
+
+  //@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the stream.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  //@}
+
+protected:
+  vtkDeltaImageCompressor();
+  ~vtkDeltaImageCompressor() override;
+
+  int Quality;
+  int TileSize;
+  int KeyFrameInterval;
+
+private:
+  vtkDeltaImageCompressor(const vtkDeltaImageCompressor&) = delete;
+  void operator=(const vtkDeltaImageCompressor&) = delete;
+
+  /**
+   * Drops the previous images, forcing a key frame.
+   */
+  void Reset();
+
+  int Width;
+  int Height;
+  int FramesSinceKeyFrame;
+  bool KeyFrameRequested;
+  int NumberOfTiles;
+  int NumberOfChangedTiles;
+
+  // Input image with the color mask applied, when Quality > 0.
+  vtkNew<vtkUnsignedCharArray> MaskedImage;
+
+  // Last image compressed and last image decompressed.
+  vtkNew<vtkUnsignedCharArray> SentImage;
+  vtkNew<vtkUnsignedCharArray> ReceivedImage;
+
+  // Changed tiles, gathered before compression or after decompression.
+  vtkNew<vtkUnsignedCharArray> TileBuffer;
+};
+
+#endif
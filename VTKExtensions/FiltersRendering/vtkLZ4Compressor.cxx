@@ -16,16 +16,27 @@
 
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 
 #include "vtk_lz4.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <sstream>
+#include <vector>
+
+namespace
+{
+// Identifies images compressed in independent chunks.
+const int LZ4_CHUNKS_MAGIC = 0x4c5a3443; // "LZ4C"
+}
 
 vtkStandardNewMacro(vtkLZ4Compressor);
 //----------------------------------------------------------------------------
 vtkLZ4Compressor::vtkLZ4Compressor()
   : Quality(3)
+  , ChunkSize(1 << 20)
 {
 }
 
@@ -56,27 +67,75 @@ int vtkLZ4Compressor::Compress()
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
   vtkUnsignedCharArray* input = this->Input;
-  int inputSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
+  const vtkIdType inputSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
 
-  if (this->Quality > 0 && input->GetNumberOfComponents() == 4)
+  // The mask is applied chunk by chunk, right before compressing each chunk,
+  // to avoid an extra pass over the whole image.
+  unsigned char* masked = nullptr;
+  if (compress_level > 0 && input->GetNumberOfComponents() == 4)
   {
     this->TemporaryBuffer->SetNumberOfComponents(input->GetNumberOfComponents());
     this->TemporaryBuffer->SetNumberOfTuples(input->GetNumberOfTuples());
-    const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
-    unsigned int* out = reinterpret_cast<unsigned int*>(this->TemporaryBuffer->GetPointer(0));
-    for (vtkIdType cc = 0, max = this->Input->GetNumberOfTuples(); cc < max; ++cc)
+    masked = this->TemporaryBuffer->GetPointer(0);
+  }
+
+  // Chunks must hold whole pixels for the mask to be applied.
+  const vtkIdType chunkSize = std::max(4, this->ChunkSize - this->ChunkSize % 4);
+  const vtkIdType numChunks = (inputSize + chunkSize - 1) / chunkSize;
+  const int maxChunkOutputSize =
+    LZ4_compressBound(static_cast<int>(std::min(chunkSize, inputSize)));
+  const vtkIdType headerSize = (2 + numChunks) * static_cast<vtkIdType>(sizeof(int));
+
+  // Chunks are compressed in parallel to slots large enough for the worst
+  // case and packed once done.
+  unsigned char* output =
+    this->Output->WritePointer(0, headerSize + numChunks * maxChunkOutputSize);
+  const unsigned char* in = input->GetPointer(0);
+  std::vector<int> compressedSizes(numChunks, 0);
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
     {
-      out[cc] = in[cc] & compress_mask;
+      const vtkIdType offset = chunk * chunkSize;
+      const int rawSize = static_cast<int>(std::min(chunkSize, inputSize - offset));
+      const unsigned char* source = in + offset;
+      if (masked)
+      {
+        const unsigned int* chunkIn = reinterpret_cast<const unsigned int*>(source);
+        unsigned int* chunkOut = reinterpret_cast<unsigned int*>(masked + offset);
+        for (int cc = 0, max = rawSize / 4; cc < max; ++cc)
+        {
+          chunkOut[cc] = chunkIn[cc] & compress_mask;
+        }
+        source = masked + offset;
+      }
+      compressedSizes[chunk] = LZ4_compress_fast(reinterpret_cast<const char*>(source),
+        reinterpret_cast<char*>(output + headerSize + chunk * maxChunkOutputSize), rawSize,
+        maxChunkOutputSize, 16);
     }
-    input = this->TemporaryBuffer.Get();
-  }
+  });
 
-  int maxOutputSize = LZ4_compressBound(inputSize);
-  int compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(input->GetPointer(0)),
-    reinterpret_cast<char*>(this->Output->WritePointer(0, maxOutputSize)), inputSize, maxOutputSize,
-    16);
-  this->Output->SetNumberOfTuples(compressedSize);
-  return compressedSize > 0 ? VTK_OK : VTK_ERROR;
+  // Header: [magic, chunk size, compressed size of each chunk].
+  std::vector<int> header(2 + numChunks);
+  header[0] = LZ4_CHUNKS_MAGIC;
+  header[1] = static_cast<int>(chunkSize);
+  vtkIdType outputSize = headerSize;
+  for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+  {
+    if (compressedSizes[chunk] <= 0)
+    {
+      return VTK_ERROR;
+    }
+    header[2 + chunk] = compressedSizes[chunk];
+    if (outputSize != headerSize + chunk * maxChunkOutputSize)
+    {
+      memmove(output + outputSize, output + headerSize + chunk * maxChunkOutputSize,
+        compressedSizes[chunk]);
+    }
+    outputSize += compressedSizes[chunk];
+  }
+  memcpy(output, header.data(), headerSize);
+  this->Output->SetNumberOfTuples(outputSize);
+  return VTK_OK;
 }
 
 //----------------------------------------------------------------------------
@@ -88,20 +147,61 @@ int vtkLZ4Compressor::Decompress()
     return VTK_ERROR;
   }
 
-  int maxDecompressedSize =
+  const unsigned char* input = this->Input->GetPointer(0);
+  const vtkIdType inputSize = this->Input->GetNumberOfTuples();
+  const vtkIdType maxDecompressedSize =
     this->Output->GetNumberOfComponents() * this->Output->GetNumberOfTuples();
-  int decompressedSize =
-    LZ4_decompress_safe(reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-      reinterpret_cast<char*>(this->Output->GetPointer(0)), this->Input->GetNumberOfTuples(),
-      maxDecompressedSize);
-
-  //  // We use LZ4_decompress_safe for now since there seems to be some bug
-  //  // in LZ4_decompress_fast which is causing segfaults on Windows.
-  //  int decompressedSize = LZ4_decompress_fast(
-  //    reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-  //    reinterpret_cast<char*>(this->Output->GetPointer(0)),
-  //    maxDecompressedSize);
-  return decompressedSize > 0 ? VTK_OK : VTK_ERROR;
+
+  int header[2] = { 0, 0 };
+  if (inputSize < static_cast<vtkIdType>(sizeof(header)))
+  {
+    vtkWarningMacro("Cannot decompress, invalid input.");
+    return VTK_ERROR;
+  }
+  memcpy(header, input, sizeof(header));
+  const vtkIdType chunkSize = header[1];
+  const vtkIdType numChunks = chunkSize > 0 ? (maxDecompressedSize + chunkSize - 1) / chunkSize : 0;
+  const vtkIdType headerSize = (2 + numChunks) * static_cast<vtkIdType>(sizeof(int));
+  if (header[0] != LZ4_CHUNKS_MAGIC || chunkSize <= 0 || inputSize < headerSize)
+  {
+    vtkWarningMacro("Cannot decompress, invalid input.");
+    return VTK_ERROR;
+  }
+
+  std::vector<int> compressedSizes(numChunks);
+  memcpy(compressedSizes.data(), input + sizeof(header), numChunks * sizeof(int));
+  std::vector<vtkIdType> offsets(numChunks);
+  vtkIdType offset = headerSize;
+  for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+  {
+    offsets[chunk] = offset;
+    offset += compressedSizes[chunk];
+  }
+  if (offset > inputSize)
+  {
+    vtkWarningMacro("Cannot decompress, invalid input.");
+    return VTK_ERROR;
+  }
+
+  // We use LZ4_decompress_safe for now since there seems to be some bug
+  // in LZ4_decompress_fast which is causing segfaults on Windows.
+  unsigned char* output = this->Output->GetPointer(0);
+  std::atomic<bool> success(true);
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      const int rawSize =
+        static_cast<int>(std::min(chunkSize, maxDecompressedSize - chunk * chunkSize));
+      const int decompressedSize =
+        LZ4_decompress_safe(reinterpret_cast<const char*>(input + offsets[chunk]),
+          reinterpret_cast<char*>(output + chunk * chunkSize), compressedSizes[chunk], rawSize);
+      if (decompressedSize != rawSize)
+      {
+        success = false;
+      }
+    }
+  });
+  return success ? VTK_OK : VTK_ERROR;
 }
 
 //-----------------------------------------------------------------------------
@@ -153,4 +253,5 @@ void vtkLZ4Compressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   cout << "Quality: " << this->Quality << endl;
+  os << indent << "ChunkSize: " << this->ChunkSize << endl;
 }
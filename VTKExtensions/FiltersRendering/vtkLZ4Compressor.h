@@ -18,7 +18,8 @@
  * that uses LZ4 for fast lossless compression.
  *
  * vtkLZ4Compressor uses LZ4 for fast lossless compression and decompression on
- * data.
+ * data. The image is split into chunks that are compressed and decompressed
+ * independently, in parallel using vtkSMPTools.
 */
 
 #ifndef vtkLZ4Compressor_h
@@ -48,6 +49,17 @@ public:
   vtkGetMacro(Quality, int);
   //@}
 
+  //@{
+  /**
+   * Set the size, in bytes, of the chunks the image is split into. Chunks are
+   * compressed independently, in parallel. Smaller chunks improve parallelism
+   * at the cost of a slightly lower compression ratio. This only affects the
+   * compressing side. Default is 1 MiB.
+   */
+  vtkSetClampMacro(ChunkSize, int, 1024, VTK_INT_MAX);
+  vtkGetMacro(ChunkSize, int);
+  //@}
+
   //@{
   /**
    * Compress/Decompress data array on the objects input with results
@@ -72,6 +84,7 @@ protected:
   ~vtkLZ4Compressor() override;
 
   int Quality;
+  int ChunkSize;
 
 private:
   vtkLZ4Compressor(const vtkLZ4Compressor&) = delete;
@@ -15,6 +15,7 @@
 #include "vtkMPIMoveData.h"
 
 #include "vtkAllToNRedistributeCompositePolyData.h"
+#include "vtkArrayBufferMarshaller.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
@@ -49,6 +50,7 @@
 #include <vector>
 
 bool vtkMPIMoveData::UseZLibCompression = false;
+bool vtkMPIMoveData::UseLZ4Compression = false;
 
 namespace
 {
@@ -180,6 +182,18 @@ bool vtkMPIMoveData::GetUseZLibCompression()
   return vtkMPIMoveData::UseZLibCompression;
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseLZ4Compression(bool b)
+{
+  vtkMPIMoveData::UseLZ4Compression = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseLZ4Compression()
+{
+  return vtkMPIMoveData::UseLZ4Compression;
+}
+
 //----------------------------------------------------------------------------
 int vtkMPIMoveData::FillInputPortInformation(int, vtkInformation* info)
 {
@@ -959,25 +973,36 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
-  // Copy input to isolate reader from the pipeline.
-  vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
-  writer->SetInputData(data);
-  if (imageData)
+  // Datasets made up of plain arrays are sent as raw array buffers, avoiding
+  // the cost of the legacy writer/reader.
+  vtkIdType raw_length = 0;
+  char* raw_buffer =
+    vtkArrayBufferMarshaller::Marshal(data, raw_length, vtkMPIMoveData::UseLZ4Compression);
+  if (!raw_buffer)
   {
-    // We add the image extents to the header, since the writer doesn't preserve
-    // the extents.
-    int* extent = imageData->GetExtent();
-    double* origin = imageData->GetOrigin();
-    std::ostringstream stream;
-    stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
-           << " " << extent[4] << " " << extent[5];
-    stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
-    writer->SetHeader(stream.str().c_str());
-  }
+    // Copy input to isolate reader from the pipeline.
+    vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
+    writer->SetInputData(data);
+    if (imageData)
+    {
+      // We add the image extents to the header, since the writer doesn't preserve
+      // the extents.
+      int* extent = imageData->GetExtent();
+      double* origin = imageData->GetOrigin();
+      std::ostringstream stream;
+      stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
+             << " " << extent[4] << " " << extent[5];
+      stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
+      writer->SetHeader(stream.str().c_str());
+    }
 
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->Write();
+    writer->SetFileTypeToBinary();
+    writer->WriteToOutputStringOn();
+    writer->Write();
+    raw_length = writer->GetOutputStringLength();
+    raw_buffer = writer->RegisterAndGetOutputString();
+    writer->Delete();
+  }
 
   char* buffer = NULL;
   vtkIdType buffer_length = 0;
@@ -986,15 +1011,15 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   {
     vtkTimerLog::MarkStartEvent("Zlib compress");
     // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
+    uLongf out_size = compressBound(raw_length);
     buffer = new char[out_size + 8];
     memcpy(buffer, "zlib0000", 8);
 
     compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
+      reinterpret_cast<const Bytef*>(raw_buffer), raw_length,
       /* compression_level */ Z_DEFAULT_COMPRESSION);
     vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
+    int in_size = static_cast<int>(raw_length);
     for (int cc = 0; cc < 4; cc++)
     {
       // the first 4 bytes in the header are "zlib" which helps the receiver
@@ -1005,11 +1030,12 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
       in_size = in_size >> 8;
     }
     buffer_length = out_size + 8;
+    delete[] raw_buffer;
   }
   else
   {
-    buffer_length = writer->GetOutputStringLength();
-    buffer = writer->RegisterAndGetOutputString();
+    buffer_length = raw_length;
+    buffer = raw_buffer;
   }
 
   // Get string.
@@ -1020,9 +1046,6 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   this->BufferOffsets[0] = 0;
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
-
-  writer->Delete();
-  writer = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -1065,6 +1088,24 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
       bufferLength = uncompressed_length;
     }
 
+    if (vtkArrayBufferMarshaller::IsMarshalledBuffer(bufferArray, bufferLength))
+    {
+      vtkDataObject* output = vtkArrayBufferMarshaller::Unmarshal(bufferArray, bufferLength);
+      if (output)
+      {
+        // reconstructing data distributted on MPI node, so global ids are valid
+        unsetGlobalIdsAttribute(output);
+        pieces.push_back(output);
+        output->Delete();
+      }
+      else
+      {
+        vtkErrorMacro("Failed to unmarshal data.");
+      }
+      delete[] realBuffer;
+      continue;
+    }
+
     // Setup a reader.
     vtkDataReader* reader = vtkGenericDataObjectReader::New();
     reader->ReadFromInputStringOn();
@@ -113,6 +113,17 @@ public:
   static bool GetUseZLibCompression();
   //@}
 
+  //@{
+  /**
+   * When set to true, arrays of datasets sent as raw array buffers (see
+   * vtkArrayBufferMarshaller) are compressed using LZ4. False by default.
+   * This is also used by vtkClientServerMoveData. This value has any effect
+   * only on the data-sender processes.
+   */
+  static void SetUseLZ4Compression(bool b);
+  static bool GetUseLZ4Compression();
+  //@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -197,6 +208,7 @@ private:
   void operator=(const vtkMPIMoveData&) = delete;
 
   static bool UseZLibCompression;
+  static bool UseLZ4Compression;
 };
 
 #endif
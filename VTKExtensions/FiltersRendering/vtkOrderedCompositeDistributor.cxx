@@ -24,38 +24,434 @@
 
 #include "vtkOrderedCompositeDistributor.h"
 
+#include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTypes.h"
+#include "vtkDIYExplicitAssigner.h"
+#include "vtkDIYUtilities.h"
 #include "vtkDataSetSurfaceFilter.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRedistributeDataSetFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// clang-format off
+#include "vtk_diy2.h"
+#include VTK_DIY2(diy/assigner.hpp)
+#include VTK_DIY2(diy/decomposition.hpp)
+#include VTK_DIY2(diy/master.hpp)
+#include VTK_DIY2(diy/mpi.hpp)
+#include VTK_DIY2(diy/reduce-operations.hpp)
+// clang-format on
+
+namespace
+{
+// Name of the arrays recording the source rank and id of redistributed cells
+// and points while building a redistribution plan.
+const char* SOURCE_IDS_ARRAY_NAME = "__vtkOrderedCompositeDistributorSourceIds";
+
+// Signatures are truncated so that they can be negated when reduced.
+const vtkTypeUInt64 SIGNATURE_MASK = 0x3fffffffffffffffull;
+
+vtkTypeUInt64 HashBytes(vtkTypeUInt64 hash, const void* data, size_t length)
+{
+  // FNV-1a applied on 64-bit words, then on the remaining bytes.
+  const vtkTypeUInt64 prime = 0x100000001b3ull;
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  size_t cc = 0;
+  for (; cc + sizeof(vtkTypeUInt64) <= length; cc += sizeof(vtkTypeUInt64))
+  {
+    vtkTypeUInt64 word;
+    memcpy(&word, bytes + cc, sizeof(word));
+    hash = (hash ^ word) * prime;
+  }
+  for (; cc < length; ++cc)
+  {
+    hash = (hash ^ bytes[cc]) * prime;
+  }
+  return hash;
+}
+
+template <typename T>
+vtkTypeUInt64 HashValue(vtkTypeUInt64 hash, const T& value)
+{
+  return HashBytes(hash, &value, sizeof(value));
+}
+
+vtkTypeUInt64 HashString(vtkTypeUInt64 hash, const char* str)
+{
+  return str ? HashBytes(hash, str, strlen(str) + 1) : HashValue(hash, 0);
+}
+
+vtkTypeUInt64 HashArray(vtkTypeUInt64 hash, vtkDataArray* array)
+{
+  if (array == nullptr)
+  {
+    return HashValue(hash, -1);
+  }
+  hash = HashValue(hash, array->GetDataType());
+  hash = HashValue(hash, array->GetNumberOfComponents());
+  hash = HashValue(hash, array->GetNumberOfTuples());
+  if (array->HasStandardMemoryLayout())
+  {
+    return HashBytes(hash, array->GetVoidPointer(0),
+      static_cast<size_t>(array->GetNumberOfValues()) * array->GetDataTypeSize());
+  }
+  for (vtkIdType cc = 0, max = array->GetNumberOfValues(); cc < max; ++cc)
+  {
+    hash = HashValue(hash, array->GetComponent(cc / array->GetNumberOfComponents(),
+                             static_cast<int>(cc % array->GetNumberOfComponents())));
+  }
+  return hash;
+}
+
+// Collects the arrays defining the geometry of a dataset. Returns false for
+// unsupported dataset types.
+bool GetGeometryArrays(vtkDataSet* ds, std::vector<vtkDataArray*>& arrays)
+{
+  auto addCells = [&arrays](vtkCellArray* cells) {
+    arrays.push_back(cells ? cells->GetOffsetsArray() : nullptr);
+    arrays.push_back(cells ? cells->GetConnectivityArray() : nullptr);
+  };
+
+  auto ps = vtkPointSet::SafeDownCast(ds);
+  arrays.push_back(ps && ps->GetPoints() ? ps->GetPoints()->GetData() : nullptr);
+  if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    addCells(ug->GetCells());
+    arrays.push_back(ug->GetCellTypesArray());
+    arrays.push_back(ug->GetFaces());
+    arrays.push_back(ug->GetFaceLocations());
+    return true;
+  }
+  if (auto pd = vtkPolyData::SafeDownCast(ds))
+  {
+    addCells(pd->GetVerts());
+    addCells(pd->GetLines());
+    addCells(pd->GetPolys());
+    addCells(pd->GetStrips());
+    return true;
+  }
+  return false;
+}
+
+struct vtkArrayLayout
+{
+  std::string Name;
+  bool HasName;
+  int DataType;
+  int NumberOfComponents;
+  int Attribute;
+};
+
+// Returns the layout of the arrays in `dsa`, ignoring the source ids array.
+// Returns false if some array cannot be exchanged as raw tuples.
+bool GetArrayLayouts(vtkDataSetAttributes* dsa, std::vector<vtkArrayLayout>& layouts)
+{
+  layouts.clear();
+  for (int cc = 0, max = dsa->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    auto aa = dsa->GetAbstractArray(cc);
+    if (aa->GetName() && strcmp(aa->GetName(), SOURCE_IDS_ARRAY_NAME) == 0)
+    {
+      continue;
+    }
+    auto array = vtkDataArray::SafeDownCast(aa);
+    if (array == nullptr || !array->HasStandardMemoryLayout())
+    {
+      return false;
+    }
+    vtkArrayLayout layout;
+    layout.HasName = array->GetName() != nullptr;
+    layout.Name = layout.HasName ? array->GetName() : "";
+    layout.DataType = array->GetDataType();
+    layout.NumberOfComponents = array->GetNumberOfComponents();
+    layout.Attribute = dsa->IsArrayAnAttribute(cc);
+    layouts.push_back(layout);
+  }
+  return true;
+}
+
+vtkTypeUInt64 HashArrayLayouts(vtkTypeUInt64 hash, const std::vector<vtkArrayLayout>& layouts)
+{
+  hash = HashValue(hash, layouts.size());
+  for (const auto& layout : layouts)
+  {
+    hash = HashString(hash, layout.HasName ? layout.Name.c_str() : nullptr);
+    hash = HashValue(hash, layout.DataType);
+    hash = HashValue(hash, layout.NumberOfComponents);
+    hash = HashValue(hash, layout.Attribute);
+  }
+  return hash;
+}
+
+// Returns the signature of the point and cell arrays layouts of `ds` in
+// `signature`. Returns false if they cannot be exchanged as raw tuples.
+bool GetAttributesSignature(vtkDataSet* ds, vtkTypeUInt64& signature)
+{
+  std::vector<vtkArrayLayout> cellLayouts, pointLayouts;
+  if (!GetArrayLayouts(ds->GetCellData(), cellLayouts) ||
+    !GetArrayLayouts(ds->GetPointData(), pointLayouts))
+  {
+    return false;
+  }
+  signature = HashArrayLayouts(HashArrayLayouts(0xcbf29ce484222325ull, cellLayouts), pointLayouts) &
+    SIGNATURE_MASK;
+  return true;
+}
+
+vtkIdType GetTupleSize(const std::vector<vtkArrayLayout>& layouts)
+{
+  vtkIdType size = 0;
+  for (const auto& layout : layouts)
+  {
+    size += layout.NumberOfComponents * vtkDataArray::GetDataTypeSize(layout.DataType);
+  }
+  return size;
+}
+
+vtkSmartPointer<vtkIdTypeArray> NewSourceIds(int rank, vtkIdType count)
+{
+  auto ids = vtkSmartPointer<vtkIdTypeArray>::New();
+  ids->SetName(SOURCE_IDS_ARRAY_NAME);
+  ids->SetNumberOfComponents(2);
+  ids->SetNumberOfTuples(count);
+  for (vtkIdType cc = 0; cc < count; ++cc)
+  {
+    ids->SetTypedComponent(cc, 0, rank);
+    ids->SetTypedComponent(cc, 1, cc);
+  }
+  return ids;
+}
+
+// Appends the tuples `ids` of all arrays in `dsa`, in order, to `buffer`.
+void PackTuples(vtkDataSetAttributes* dsa, const std::vector<vtkIdType>& ids, std::vector<char>& buffer)
+{
+  for (int cc = 0, max = dsa->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    auto array = dsa->GetArray(cc);
+    const size_t tupleSize =
+      static_cast<size_t>(array->GetNumberOfComponents()) * array->GetDataTypeSize();
+    const char* data = static_cast<const char*>(array->GetVoidPointer(0));
+    size_t offset = buffer.size();
+    buffer.resize(offset + tupleSize * ids.size());
+    for (const vtkIdType id : ids)
+    {
+      memcpy(&buffer[offset], data + tupleSize * id, tupleSize);
+      offset += tupleSize;
+    }
+  }
+}
+
+// Copies tuples from `buffer` into all arrays in `dsa`, at `ids`. Returns the
+// number of bytes read.
+size_t UnpackTuples(const char* buffer, const std::vector<vtkIdType>& ids, vtkDataSetAttributes* dsa)
+{
+  size_t offset = 0;
+  for (int cc = 0, max = dsa->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    auto array = dsa->GetArray(cc);
+    const size_t tupleSize =
+      static_cast<size_t>(array->GetNumberOfComponents()) * array->GetDataTypeSize();
+    char* data = static_cast<char*>(array->GetVoidPointer(0));
+    for (const vtkIdType id : ids)
+    {
+      memcpy(data + tupleSize * id, buffer + offset, tupleSize);
+      offset += tupleSize;
+    }
+  }
+  return offset;
+}
+
+typedef std::vector<std::vector<char> > vtkBufferVector;
+
+// Sends `send[cc]` to rank `cc`, for all ranks, in a single all-to-all
+// exchange. Returns the buffers received from each rank, indexed by rank.
+vtkBufferVector AllToAll(vtkMultiProcessController* controller, vtkBufferVector& send)
+{
+  const int numRanks = controller->GetNumberOfProcesses();
+  if (numRanks == 1)
+  {
+    return send;
+  }
+
+  diy::mpi::communicator comm = vtkDIYUtilities::GetCommunicator(controller);
+  diy::Master master(comm, 1, -1, []() { return static_cast<void*>(new vtkBufferVector()); },
+    [](void* b) { delete static_cast<vtkBufferVector*>(b); });
+  vtkDIYExplicitAssigner assigner(comm, 1);
+  diy::RegularDecomposer<diy::DiscreteBounds> decomposer(
+    /*dim*/ 1, diy::interval(0, assigner.nblocks() - 1), assigner.nblocks());
+  decomposer.decompose(comm.rank(), assigner, master);
+  assert(master.size() == 1);
+
+  // With one block per rank, block ids are ranks.
+  master.block<vtkBufferVector>(0)->swap(send);
+  diy::all_to_all(
+    master, assigner, [numRanks](vtkBufferVector* block, const diy::ReduceProxy& rp) {
+      if (rp.in_link().size() == 0)
+      {
+        for (int cc = 0; cc < rp.out_link().size(); ++cc)
+        {
+          const diy::BlockID& target = rp.out_link().target(cc);
+          rp.enqueue(target, (*block)[target.gid]);
+        }
+        block->clear();
+      }
+      else
+      {
+        block->resize(numRanks);
+        for (int cc = 0; cc < rp.in_link().size(); ++cc)
+        {
+          const int gid = rp.in_link().target(cc).gid;
+          rp.dequeue(gid, (*block)[gid]);
+        }
+      }
+    });
+
+  vtkBufferVector received;
+  received.swap(*master.block<vtkBufferVector>(0));
+  received.resize(numRanks);
+  return received;
+}
+
+void AddArrays(vtkDataSetAttributes* dsa, const std::vector<vtkArrayLayout>& layouts, vtkIdType count)
+{
+  for (const auto& layout : layouts)
+  {
+    vtkSmartPointer<vtkDataArray> array;
+    array.TakeReference(vtkDataArray::CreateDataArray(layout.DataType));
+    if (layout.HasName)
+    {
+      array->SetName(layout.Name.c_str());
+    }
+    array->SetNumberOfComponents(layout.NumberOfComponents);
+    array->SetNumberOfTuples(count);
+    const int index = dsa->AddArray(array);
+    if (layout.Attribute >= 0)
+    {
+      dsa->SetActiveAttribute(index, layout.Attribute);
+    }
+  }
+}
+}
+
+class vtkOrderedCompositeDistributor::vtkInternals
+{
+public:
+  std::vector<vtkBoundingBox> Cuts;
+
+  // Geometry signatures computed by the last GetGeometrySignature call, keyed
+  // by the geometry arrays and their modification times.
+  typedef std::vector<std::pair<vtkDataArray*, vtkMTimeType> > GeometryKeyType;
+  std::map<GeometryKeyType, vtkTypeUInt64> Signatures;
+
+  struct vtkPlan
+  {
+    bool Valid = false;
+    vtkTypeUInt64 GeometrySignature = 0;
+    vtkTypeUInt64 AttributesSignature = 0;
+    int BoundaryMode = 0;
+    std::vector<vtkBoundingBox> Cuts;
+
+    // Redistributed points and cells, without attributes.
+    vtkSmartPointer<vtkUnstructuredGrid> Geometry;
+
+    // Layout of the redistributed cell and point data.
+    std::vector<vtkArrayLayout> CellArrays;
+    std::vector<vtkArrayLayout> PointArrays;
+
+    // Input cell and point ids to send to each rank.
+    std::vector<std::vector<vtkIdType> > SendCells;
+    std::vector<std::vector<vtkIdType> > SendPoints;
+
+    // Output cell and point ids received from each rank, in the order they
+    // are sent.
+    std::vector<std::vector<vtkIdType> > ReceiveCells;
+    std::vector<std::vector<vtkIdType> > ReceivePoints;
+  };
+  vtkPlan Plan;
+
+  vtkTypeUInt64 GetSignature(vtkDataSet* ds, std::map<GeometryKeyType, vtkTypeUInt64>& used)
+  {
+    std::vector<vtkDataArray*> arrays;
+    if (!GetGeometryArrays(ds, arrays))
+    {
+      return 0;
+    }
+    GeometryKeyType key;
+    for (auto array : arrays)
+    {
+      key.push_back(std::make_pair(array, array ? array->GetMTime() : 0));
+    }
+    auto iter = this->Signatures.find(key);
+    vtkTypeUInt64 signature = 0;
+    if (iter != this->Signatures.end())
+    {
+      signature = iter->second;
+    }
+    else
+    {
+      signature = HashString(0xcbf29ce484222325ull, ds->GetClassName());
+      for (auto array : arrays)
+      {
+        signature = HashArray(signature, array);
+      }
+      signature = (signature & SIGNATURE_MASK) | 0x1;
+    }
+    used[key] = signature;
+    return signature;
+  }
+};
+
 vtkStandardNewMacro(vtkOrderedCompositeDistributor);
 //-----------------------------------------------------------------------------
 vtkOrderedCompositeDistributor::vtkOrderedCompositeDistributor()
 {
   this->RedistributeDataSetFilter->SetUseExplicitCuts(true);
   this->RedistributeDataSetFilter->SetGenerateGlobalCellIds(false);
+  this->BoundaryMode = this->RedistributeDataSetFilter->GetBoundaryMode();
+  this->UseRedistributionPlan = false;
+  this->RedistributionPlanReused = false;
+  this->Internals = new vtkInternals();
 }
 
 //-----------------------------------------------------------------------------
 vtkOrderedCompositeDistributor::~vtkOrderedCompositeDistributor()
 {
+  delete this->Internals;
 }
 
 //-----------------------------------------------------------------------------
 void vtkOrderedCompositeDistributor::SetCuts(const std::vector<vtkBoundingBox>& boxes)
 {
   this->RedistributeDataSetFilter->SetExplicitCuts(boxes);
+  this->Internals->Cuts = boxes;
   this->Modified();
 }
 
@@ -63,6 +459,7 @@ void vtkOrderedCompositeDistributor::SetCuts(const std::vector<vtkBoundingBox>&
 void vtkOrderedCompositeDistributor::SetController(vtkMultiProcessController* controller)
 {
   this->RedistributeDataSetFilter->SetController(controller);
+  this->Controller = controller;
   this->Modified();
 }
 
@@ -70,13 +467,50 @@ void vtkOrderedCompositeDistributor::SetController(vtkMultiProcessController* co
 void vtkOrderedCompositeDistributor::SetBoundaryMode(int mode)
 {
   this->RedistributeDataSetFilter->SetBoundaryMode(mode);
+  this->BoundaryMode = mode;
   this->Modified();
 }
 
+//-----------------------------------------------------------------------------
+vtkTypeUInt64 vtkOrderedCompositeDistributor::GetGeometrySignature(vtkDataObject* data)
+{
+  std::map<vtkInternals::GeometryKeyType, vtkTypeUInt64> used;
+  vtkTypeUInt64 signature = 0;
+  if (auto ds = vtkDataSet::SafeDownCast(data))
+  {
+    signature = this->Internals->GetSignature(ds, used);
+  }
+  else if (auto cd = vtkCompositeDataSet::SafeDownCast(data))
+  {
+    signature = 0xcbf29ce484222325ull;
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cd->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      const vtkTypeUInt64 leafSignature = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject())
+        ? this->Internals->GetSignature(
+            vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()), used)
+        : 0;
+      if (leafSignature == 0)
+      {
+        signature = 0;
+        break;
+      }
+      signature = HashValue(HashValue(signature, iter->GetCurrentFlatIndex()), leafSignature);
+    }
+    signature = signature != 0 ? ((signature & SIGNATURE_MASK) | 0x1) : 0;
+  }
+  // Only keep signatures of the geometry seen last to limit the cache size.
+  this->Internals->Signatures.swap(used);
+  return signature;
+}
+
 //-----------------------------------------------------------------------------
 void vtkOrderedCompositeDistributor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseRedistributionPlan: " << this->UseRedistributionPlan << endl;
+  os << indent << "RedistributionPlanReused: " << this->RedistributionPlanReused << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -117,6 +551,16 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
   auto inputDO = vtkDataObject::GetData(inputVector[0], 0);
   auto outputDO = vtkDataObject::GetData(outputVector, 0);
 
+  this->RedistributionPlanReused = false;
+  auto inputUG = vtkUnstructuredGrid::SafeDownCast(inputDO);
+  if (inputUG && this->UseRedistributionPlan && this->Controller &&
+    this->BoundaryMode != SPLIT_BOUNDARY_CELLS)
+  {
+    return this->RedistributeWithPlan(inputUG, vtkUnstructuredGrid::SafeDownCast(outputDO)) ? 1
+                                                                                             : 0;
+  }
+  this->Internals->Plan = vtkInternals::vtkPlan();
+
   this->RedistributeDataSetFilter->SetInputDataObject(inputDO);
   this->RedistributeDataSetFilter->Update();
   auto distributedData = this->RedistributeDataSetFilter->GetOutputDataObject(0);
@@ -165,3 +609,197 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
   }
   return 1;
 }
+
+//-----------------------------------------------------------------------------
+bool vtkOrderedCompositeDistributor::RedistributeWithPlan(
+  vtkUnstructuredGrid* input, vtkUnstructuredGrid* output)
+{
+  auto controller = this->Controller.GetPointer();
+  const int numRanks = controller->GetNumberOfProcesses();
+  const int rank = controller->GetLocalProcessId();
+  auto& plan = this->Internals->Plan;
+
+  const bool hasInput = input->GetNumberOfCells() > 0 || input->GetNumberOfPoints() > 0;
+  vtkTypeUInt64 attributesSignature = 0;
+  const bool canExchangeAttributes = GetAttributesSignature(input, attributesSignature);
+  const vtkTypeUInt64 geometrySignature = this->GetGeometrySignature(input);
+
+  // The plan is only reused if it is valid on all ranks.
+  int reuse = plan.Valid && geometrySignature == plan.GeometrySignature &&
+      plan.BoundaryMode == this->BoundaryMode && plan.Cuts == this->Internals->Cuts &&
+      canExchangeAttributes && (!hasInput || attributesSignature == plan.AttributesSignature)
+    ? 1
+    : 0;
+  int reuseAll = 0;
+  controller->AllReduce(&reuse, &reuseAll, 1, vtkCommunicator::MIN_OP);
+
+  if (reuseAll == 0)
+  {
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "building redistribution plan");
+    plan = vtkInternals::vtkPlan();
+
+    // Tag cells and points with their source so that the plan can be built
+    // from the redistributed data.
+    vtkNew<vtkUnstructuredGrid> tagged;
+    tagged->ShallowCopy(input);
+    tagged->GetCellData()->AddArray(NewSourceIds(rank, input->GetNumberOfCells()));
+    tagged->GetPointData()->AddArray(NewSourceIds(rank, input->GetNumberOfPoints()));
+    this->RedistributeDataSetFilter->SetInputDataObject(tagged);
+    this->RedistributeDataSetFilter->Update();
+    this->RedistributeDataSetFilter->SetInputDataObject(nullptr);
+    auto distributed =
+      vtkUnstructuredGrid::SafeDownCast(this->RedistributeDataSetFilter->GetOutputDataObject(0));
+    if (distributed)
+    {
+      output->ShallowCopy(distributed);
+    }
+    else
+    {
+      output->Initialize();
+    }
+
+    vtkSmartPointer<vtkIdTypeArray> cellSources =
+      vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetAbstractArray(SOURCE_IDS_ARRAY_NAME));
+    vtkSmartPointer<vtkIdTypeArray> pointSources = vtkIdTypeArray::SafeDownCast(
+      output->GetPointData()->GetAbstractArray(SOURCE_IDS_ARRAY_NAME));
+    output->GetCellData()->RemoveArray(SOURCE_IDS_ARRAY_NAME);
+    output->GetPointData()->RemoveArray(SOURCE_IDS_ARRAY_NAME);
+
+    // Find where each output cell and point comes from.
+    bool valid = canExchangeAttributes &&
+      GetArrayLayouts(output->GetCellData(), plan.CellArrays) &&
+      GetArrayLayouts(output->GetPointData(), plan.PointArrays);
+    std::vector<std::vector<vtkIdType> > requestedCells(numRanks), requestedPoints(numRanks);
+    plan.ReceiveCells.resize(numRanks);
+    plan.ReceivePoints.resize(numRanks);
+    auto collect = [&](vtkIdTypeArray* sources, vtkIdType count,
+      std::vector<std::vector<vtkIdType> >& requested,
+      std::vector<std::vector<vtkIdType> >& received) {
+      if (count == 0)
+      {
+        return true;
+      }
+      if (sources == nullptr || sources->GetNumberOfComponents() != 2 ||
+        sources->GetNumberOfTuples() != count)
+      {
+        return false;
+      }
+      for (vtkIdType cc = 0; cc < count; ++cc)
+      {
+        const vtkIdType source = sources->GetTypedComponent(cc, 0);
+        if (source < 0 || source >= numRanks)
+        {
+          return false;
+        }
+        requested[source].push_back(sources->GetTypedComponent(cc, 1));
+        received[source].push_back(cc);
+      }
+      return true;
+    };
+    valid = valid &&
+      collect(cellSources, output->GetNumberOfCells(), requestedCells, plan.ReceiveCells) &&
+      collect(pointSources, output->GetNumberOfPoints(), requestedPoints, plan.ReceivePoints);
+
+    // Make sure that all ranks exchange arrays with the same layout: the
+    // smallest and largest signatures of the sent and received attributes
+    // must match.
+    long long values[3] = { LLONG_MAX, LLONG_MAX, valid ? 0 : -1 };
+    auto addSignature = [&values](vtkTypeUInt64 signature) {
+      values[0] = std::min(values[0], static_cast<long long>(signature));
+      values[1] = std::min(values[1], -static_cast<long long>(signature));
+    };
+    if (hasInput)
+    {
+      addSignature(attributesSignature);
+    }
+    vtkTypeUInt64 outputSignature = 0;
+    if ((output->GetNumberOfCells() > 0 || output->GetNumberOfPoints() > 0) &&
+      GetAttributesSignature(output, outputSignature))
+    {
+      addSignature(outputSignature);
+    }
+    long long results[3];
+    controller->AllReduce(values, results, 3, vtkCommunicator::MIN_OP);
+    if (results[2] != 0 || (results[0] != LLONG_MAX && results[0] != -results[1]))
+    {
+      vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "data cannot be redistributed using a plan");
+      plan = vtkInternals::vtkPlan();
+      return true;
+    }
+
+    // Let each rank know which of its cells and points are sent where: each
+    // rank receives the number of cells requested from it followed by the
+    // requested cell and point ids.
+    vtkBufferVector requests(numRanks);
+    for (int cc = 0; cc < numRanks; ++cc)
+    {
+      std::vector<vtkIdType> ids(1, static_cast<vtkIdType>(requestedCells[cc].size()));
+      ids.insert(ids.end(), requestedCells[cc].begin(), requestedCells[cc].end());
+      ids.insert(ids.end(), requestedPoints[cc].begin(), requestedPoints[cc].end());
+      requests[cc].resize(ids.size() * sizeof(vtkIdType));
+      memcpy(&requests[cc][0], &ids[0], requests[cc].size());
+    }
+    auto allRequests = AllToAll(controller, requests);
+    plan.SendCells.resize(numRanks);
+    plan.SendPoints.resize(numRanks);
+    for (int cc = 0; cc < numRanks; ++cc)
+    {
+      std::vector<vtkIdType> ids(allRequests[cc].size() / sizeof(vtkIdType));
+      if (ids.empty())
+      {
+        continue;
+      }
+      memcpy(&ids[0], &allRequests[cc][0], ids.size() * sizeof(vtkIdType));
+      const auto numCells = std::min(static_cast<size_t>(ids[0]), ids.size() - 1);
+      plan.SendCells[cc].assign(ids.begin() + 1, ids.begin() + 1 + numCells);
+      plan.SendPoints[cc].assign(ids.begin() + 1 + numCells, ids.end());
+    }
+
+    plan.Valid = true;
+    plan.GeometrySignature = geometrySignature;
+    plan.AttributesSignature = attributesSignature;
+    plan.BoundaryMode = this->BoundaryMode;
+    plan.Cuts = this->Internals->Cuts;
+    plan.Geometry = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    plan.Geometry->CopyStructure(output);
+    return true;
+  }
+
+  // Only exchange attributes, the geometry is unchanged.
+  vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "reusing redistribution plan");
+  output->Initialize();
+  output->CopyStructure(plan.Geometry);
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+  AddArrays(output->GetCellData(), plan.CellArrays, output->GetNumberOfCells());
+  AddArrays(output->GetPointData(), plan.PointArrays, output->GetNumberOfPoints());
+  const vtkIdType cellTupleSize = GetTupleSize(plan.CellArrays);
+  const vtkIdType pointTupleSize = GetTupleSize(plan.PointArrays);
+
+  vtkBufferVector sendBuffers(numRanks);
+  for (int cc = 0; cc < numRanks; ++cc)
+  {
+    PackTuples(input->GetCellData(), plan.SendCells[cc], sendBuffers[cc]);
+    PackTuples(input->GetPointData(), plan.SendPoints[cc], sendBuffers[cc]);
+  }
+  auto receiveBuffers = AllToAll(controller, sendBuffers);
+  for (int cc = 0; cc < numRanks; ++cc)
+  {
+    const size_t receiveLength =
+      static_cast<size_t>(plan.ReceiveCells[cc].size() * cellTupleSize +
+        plan.ReceivePoints[cc].size() * pointTupleSize);
+    if (receiveBuffers[cc].size() != receiveLength)
+    {
+      vtkErrorMacro("Unexpected attributes received from rank " << cc << ".");
+      return false;
+    }
+    if (receiveLength > 0)
+    {
+      const size_t read =
+        UnpackTuples(receiveBuffers[cc].data(), plan.ReceiveCells[cc], output->GetCellData());
+      UnpackTuples(
+        receiveBuffers[cc].data() + read, plan.ReceivePoints[cc], output->GetPointData());
+    }
+  }
+  this->RedistributionPlanReused = true;
+  return true;
+}
@@ -36,6 +36,14 @@
  * This class also has an optional pass through mode to make it easy to
  * turn ordered compositing on and off.
  *
+ * When `UseRedistributionPlan` is enabled, the distributor remembers where each
+ * cell and point of a vtkUnstructuredGrid input was sent. If the next input has
+ * the same points and cells (see GetGeometrySignature), the same cuts and the
+ * same boundary mode, only the point and cell data are exchanged using that
+ * plan and the redistributed geometry from the previous execution is reused.
+ * This avoids partitioning the data again when only attributes change e.g.
+ * when playing back time steps of a static mesh.
+ *
 */
 
 #ifndef vtkOrderedCompositeDistributor_h
@@ -44,13 +52,15 @@
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
 
 #include "vtkDataObjectAlgorithm.h"
-#include "vtkNew.h" // needed for ivar
+#include "vtkNew.h"         // needed for ivar
+#include "vtkWeakPointer.h" // needed for ivar
 
 #include <vector> // for std::vector
 
 class vtkBoundingBox;
 class vtkMultiProcessController;
 class vtkRedistributeDataSetFilter;
+class vtkUnstructuredGrid;
 
 class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkOrderedCompositeDistributor
   : public vtkDataObjectAlgorithm
@@ -74,6 +84,34 @@ public:
     SPLIT_BOUNDARY_CELLS = 2
   };
 
+  //@{
+  /**
+   * When set, the distributor keeps a redistribution plan for
+   * vtkUnstructuredGrid inputs and reuses it while the geometry, the cuts and
+   * the boundary mode don't change. The plan is never used with
+   * SPLIT_BOUNDARY_CELLS since split cells don't come from a single input cell.
+   * Default is false.
+   */
+  vtkSetMacro(UseRedistributionPlan, bool);
+  vtkGetMacro(UseRedistributionPlan, bool);
+  vtkBooleanMacro(UseRedistributionPlan, bool);
+  //@}
+
+  /**
+   * Returns true if the last execution only exchanged attributes using the
+   * redistribution plan.
+   */
+  vtkGetMacro(RedistributionPlanReused, bool);
+
+  /**
+   * Returns a signature of the points and cells of `data`, ignoring point and
+   * cell data. vtkUnstructuredGrid, vtkPolyData and composite datasets of those
+   * are supported; 0 is returned for other types. Signatures of datasets whose
+   * geometry arrays were not modified since the previous call are not computed
+   * again.
+   */
+  vtkTypeUInt64 GetGeometrySignature(vtkDataObject* data);
+
 protected:
   vtkOrderedCompositeDistributor();
   ~vtkOrderedCompositeDistributor() override;
@@ -86,7 +124,20 @@ private:
   vtkOrderedCompositeDistributor(const vtkOrderedCompositeDistributor&) = delete;
   void operator=(const vtkOrderedCompositeDistributor&) = delete;
 
+  /**
+   * Redistributes `input` using the redistribution plan, rebuilding it first
+   * when it cannot be reused.
+   */
+  bool RedistributeWithPlan(vtkUnstructuredGrid* input, vtkUnstructuredGrid* output);
+
   vtkNew<vtkRedistributeDataSetFilter> RedistributeDataSetFilter;
+  vtkWeakPointer<vtkMultiProcessController> Controller;
+  int BoundaryMode;
+  bool UseRedistributionPlan;
+  bool RedistributionPlanReused;
+
+  class vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif // vtkOrderedCompositeDistributor_h
@@ -58,6 +58,8 @@
 #include "vtkPolygon.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -74,10 +76,12 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
 #include <map>
 #include <math.h>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 template <typename T>
@@ -150,6 +154,75 @@ public:
   int Commutative() override { return 1; }
 };
 
+//----------------------------------------------------------------------------
+// Functor used to execute leaf blocks in parallel. Each thread lazily creates
+// its own instance of vtkPVGeometryFilter since the internal filters used by
+// ExecuteBlock cannot be shared between threads. Outputs are written into
+// preallocated slots, one per block, so that the order in which blocks are
+// processed does not affect the result.
+class vtkPVGeometryFilter::ExecuteBlocksFunctor
+{
+  vtkPVGeometryFilter* Self;
+  const std::vector<vtkDataObject*>& Blocks;
+  const int* WholeExtent;
+  std::vector<vtkSmartPointer<vtkPolyData> >& Outputs;
+  std::vector<int>& OutlineFlags;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkPVGeometryFilter> > Workers;
+  std::atomic<vtkIdType> NumberOfCompletedBlocks;
+  std::thread::id MainThreadId;
+
+public:
+  ExecuteBlocksFunctor(vtkPVGeometryFilter* self, const std::vector<vtkDataObject*>& blocks,
+    const int* wholeExtent, std::vector<vtkSmartPointer<vtkPolyData> >& outputs,
+    std::vector<int>& outlineFlags)
+    : Self(self)
+    , Blocks(blocks)
+    , WholeExtent(wholeExtent)
+    , Outputs(outputs)
+    , OutlineFlags(outlineFlags)
+    , NumberOfCompletedBlocks(0)
+    , MainThreadId(std::this_thread::get_id())
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& worker = this->Workers.Local();
+    if (worker == nullptr)
+    {
+      worker.TakeReference(this->Self->NewInstance());
+      this->Self->CopyWorkerSettings(worker);
+    }
+
+    const auto numBlocks = static_cast<vtkIdType>(this->Blocks.size());
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      if (this->Self->AbortExecute)
+      {
+        break;
+      }
+      if (this->Blocks[cc] == nullptr)
+      {
+        continue;
+      }
+
+      auto tmpOut = vtkSmartPointer<vtkPolyData>::New();
+      worker->ExecuteBlock(this->Blocks[cc], tmpOut, 0, 0, 1, 0, this->WholeExtent);
+      worker->CleanupOutputData(tmpOut, 0);
+      this->Outputs[cc] = tmpOut;
+      this->OutlineFlags[cc] = worker->OutlineFlag;
+
+      // Progress is accumulated from all threads, but only reported from the
+      // main thread since observers are generally not thread-safe.
+      const vtkIdType completed = ++this->NumberOfCompletedBlocks;
+      if (std::this_thread::get_id() == this->MainThreadId)
+      {
+        this->Self->UpdateProgress(static_cast<double>(completed) / numBlocks);
+      }
+    }
+  }
+};
+
 //----------------------------------------------------------------------------
 vtkPVGeometryFilter::vtkPVGeometryFilter()
 {
@@ -195,6 +268,7 @@ vtkPVGeometryFilter::vtkPVGeometryFilter()
 
   this->HideInternalAMRFaces = true;
   this->UseNonOverlappingAMRMetaDataForOutlines = true;
+  this->ExecuteBlocksInParallel = false;
 }
 
 //----------------------------------------------------------------------------
@@ -946,35 +1020,74 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
 
   int* wholeExtent =
     vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
-  int numInputs = 0;
-  for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
+  if (this->ExecuteBlocksInParallel && totNumBlocks > 1)
   {
-    vtkDataObject* block = inIter->GetCurrentDataObject();
-    if (!block)
+    std::vector<vtkDataObject*> blocks;
+    blocks.reserve(totNumBlocks);
+    for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
     {
-      continue;
+      blocks.push_back(inIter->GetCurrentDataObject());
     }
 
-    vtkPolyData* tmpOut = vtkPolyData::New();
-    this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
-    this->CleanupOutputData(tmpOut, 0);
-    // skip empty nodes.
-    if (tmpOut->GetNumberOfPoints() > 0)
-    {
-      output->SetDataSet(inIter, tmpOut);
-      tmpOut->FastDelete();
+    std::vector<vtkSmartPointer<vtkPolyData> > outputs(blocks.size());
+    std::vector<int> outlineFlags(blocks.size(), this->OutlineFlag);
+    ExecuteBlocksFunctor functor(this, blocks, wholeExtent, outputs, outlineFlags);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), functor);
 
-      const unsigned int current_flat_index = inIter->GetCurrentFlatIndex();
-      this->AddCompositeIndex(tmpOut, current_flat_index);
-    }
-    else
+    // Assign outputs in the same order as the serial code path.
+    size_t index = 0;
+    for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem(), ++index)
     {
-      tmpOut->Delete();
-      tmpOut = NULL;
+      vtkPolyData* tmpOut = outputs[index];
+      if (tmpOut == nullptr)
+      {
+        // null leaves are skipped and do not affect OutlineFlag, as in the
+        // serial code path.
+        continue;
+      }
+      // skip empty nodes.
+      if (tmpOut->GetNumberOfPoints() > 0)
+      {
+        output->SetDataSet(inIter, tmpOut);
+        this->AddCompositeIndex(tmpOut, inIter->GetCurrentFlatIndex());
+      }
+      this->OutlineFlag = outlineFlags[index];
     }
+    outputs.clear();
+    this->UpdateProgress(1.0);
+  }
+  else
+  {
+    int numInputs = 0;
+    for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
+    {
+      vtkDataObject* block = inIter->GetCurrentDataObject();
+      if (!block)
+      {
+        continue;
+      }
+
+      vtkPolyData* tmpOut = vtkPolyData::New();
+      this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
+      this->CleanupOutputData(tmpOut, 0);
+      // skip empty nodes.
+      if (tmpOut->GetNumberOfPoints() > 0)
+      {
+        output->SetDataSet(inIter, tmpOut);
+        tmpOut->FastDelete();
 
-    numInputs++;
-    this->UpdateProgress(static_cast<float>(numInputs) / totNumBlocks);
+        const unsigned int current_flat_index = inIter->GetCurrentFlatIndex();
+        this->AddCompositeIndex(tmpOut, current_flat_index);
+      }
+      else
+      {
+        tmpOut->Delete();
+        tmpOut = NULL;
+      }
+
+      numInputs++;
+      this->UpdateProgress(static_cast<float>(numInputs) / totNumBlocks);
+    }
   }
   vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteCompositeDataSet");
 
@@ -1781,6 +1894,27 @@ void vtkPVGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "PassThroughCellIds: " << (this->PassThroughCellIds ? "On\n" : "Off\n");
   os << indent << "PassThroughPointIds: " << (this->PassThroughPointIds ? "On\n" : "Off\n");
+  os << indent << "ExecuteBlocksInParallel: " << this->ExecuteBlocksInParallel << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::CopyWorkerSettings(vtkPVGeometryFilter* worker)
+{
+  worker->SetUseOutline(this->UseOutline);
+  worker->SetGenerateFeatureEdges(this->GenerateFeatureEdges);
+  worker->SetBlockColorsDistinctValues(this->BlockColorsDistinctValues);
+  worker->SetUseStrips(this->UseStrips);
+  worker->SetGenerateCellNormals(this->GenerateCellNormals);
+  worker->SetTriangulate(this->Triangulate);
+  worker->SetNonlinearSubdivisionLevel(this->NonlinearSubdivisionLevel);
+  worker->SetController(this->Controller);
+  worker->SetPassThroughCellIds(this->PassThroughCellIds);
+  worker->SetPassThroughPointIds(this->PassThroughPointIds);
+  worker->SetGenerateProcessIds(this->GenerateProcessIds);
+  worker->SetHideInternalAMRFaces(this->HideInternalAMRFaces);
+  worker->SetUseNonOverlappingAMRMetaDataForOutlines(
+    this->UseNonOverlappingAMRMetaDataForOutlines);
+  worker->OutlineFlag = this->OutlineFlag;
 }
 
 //----------------------------------------------------------------------------
@@ -207,6 +207,19 @@ public:
   vtkBooleanMacro(UseNonOverlappingAMRMetaDataForOutlines, bool);
   //@}
 
+  //@{
+  /**
+   * When set to true, leaf blocks of a vtkDataObjectTree input are processed
+   * concurrently using vtkSMPTools. Each thread uses its own instance of this
+   * filter, configured identically, and results are collected in input order
+   * so the output is identical to that produced when processing blocks
+   * serially. Default is false.
+   */
+  vtkSetMacro(ExecuteBlocksInParallel, bool);
+  vtkGetMacro(ExecuteBlocksInParallel, bool);
+  vtkBooleanMacro(ExecuteBlocksInParallel, bool);
+  //@}
+
   // These keys are put in the output composite-data metadata for multipieces
   // since this filter merges multipieces together.
   static vtkInformationIntegerVectorKey* POINT_OFFSETS();
@@ -331,6 +344,7 @@ protected:
   bool HideInternalAMRFaces;
   bool UseNonOverlappingAMRMetaDataForOutlines;
   bool GenerateFeatureEdges;
+  bool ExecuteBlocksInParallel;
 
 private:
   vtkPVGeometryFilter(const vtkPVGeometryFilter&) = delete;
@@ -348,6 +362,13 @@ private:
   void AddHierarchicalIndex(vtkPolyData* pd, unsigned int level, unsigned int index);
   class BoundsReductionOperation;
   //@}
+
+  /**
+   * Copies all parameters that affect block execution to `worker`. Used to
+   * setup the per-thread instances when ExecuteBlocksInParallel is true.
+   */
+  void CopyWorkerSettings(vtkPVGeometryFilter* worker);
+  class ExecuteBlocksFunctor;
 };
 
 #endif
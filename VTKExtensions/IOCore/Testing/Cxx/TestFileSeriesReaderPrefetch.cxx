@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestFileSeriesReaderPrefetch.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkFileSeriesReader produces the right outputs when it prefetches
+// files, playing the series forward and backward, and when the arrays to read
+// change after files were prefetched.
+
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerInterpreterInitializer.h"
+#include "vtkClientServerStream.h"
+#include "vtkDataArraySelection.h"
+#include "vtkFileSeriesReader.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int NumberOfFiles = 6;
+
+// Handles the calls made by vtkFileSeriesReader to set the file name of its
+// internal reader, which the client-server wrapping does in ParaView.
+int vtkXMLPolyDataReaderCommand(vtkClientServerInterpreter*, vtkObjectBase* ob, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream& result, void*)
+{
+  vtkXMLPolyDataReader* reader = vtkXMLPolyDataReader::SafeDownCast(ob);
+  const char* fname = nullptr;
+  result.Reset();
+  if (reader && strcmp(method, "SetFileName") == 0 && msg.GetArgument(0, 2, &fname))
+  {
+    reader->SetFileName(fname);
+    result << vtkClientServerStream::Reply << vtkClientServerStream::End;
+    return 1;
+  }
+  result << vtkClientServerStream::Error << "Unexpected call." << vtkClientServerStream::End;
+  return 0;
+}
+
+// File `index` has 10 + index points and two point arrays, "Index", set to
+// `index`, and "Other".
+std::vector<std::string> WriteFiles(const std::string& directory)
+{
+  std::vector<std::string> fileNames;
+  for (int index = 0; index < NumberOfFiles; ++index)
+  {
+    vtkNew<vtkPolyData> polydata;
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkIntArray> indices;
+    indices->SetName("Index");
+    vtkNew<vtkIntArray> other;
+    other->SetName("Other");
+    for (int cc = 0; cc < 10 + index; ++cc)
+    {
+      points->InsertNextPoint(cc, index, 0);
+      indices->InsertNextValue(index);
+      other->InsertNextValue(cc);
+    }
+    polydata->SetPoints(points);
+    polydata->GetPointData()->AddArray(indices);
+    polydata->GetPointData()->AddArray(other);
+
+    std::ostringstream fname;
+    fname << directory << "/TestFileSeriesReaderPrefetch_" << index << ".vtp";
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetInputData(polydata);
+    writer->SetFileName(fname.str().c_str());
+    if (!writer->Write())
+    {
+      return std::vector<std::string>();
+    }
+    fileNames.push_back(fname.str());
+  }
+  return fileNames;
+}
+
+bool CheckOutput(vtkFileSeriesReader* reader, int index, bool hasOther)
+{
+  reader->UpdateTimeStep(index);
+  vtkPolyData* output = vtkPolyData::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfPoints() != 10 + index)
+  {
+    std::cerr << "ERROR: wrong number of points for file " << index << "." << std::endl;
+    return false;
+  }
+  vtkIntArray* indices = vtkIntArray::SafeDownCast(output->GetPointData()->GetArray("Index"));
+  if (!indices || indices->GetValue(0) != index)
+  {
+    std::cerr << "ERROR: wrong data for file " << index << "." << std::endl;
+    return false;
+  }
+  if ((output->GetPointData()->GetArray("Other") != nullptr) != hasOther)
+  {
+    std::cerr << "ERROR: wrong arrays for file " << index << "." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestFileSeriesReaderPrefetch(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::vector<std::string> fileNames = WriteFiles(tempDir);
+  delete[] tempDir;
+  if (fileNames.empty())
+  {
+    std::cerr << "ERROR: cannot write the files." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkClientServerInterpreter* interpreter =
+    vtkClientServerInterpreterInitializer::GetGlobalInterpreter();
+  if (!interpreter->HasCommandFunction("vtkXMLPolyDataReader"))
+  {
+    interpreter->AddCommandFunction("vtkXMLPolyDataReader", vtkXMLPolyDataReaderCommand);
+  }
+
+  vtkNew<vtkXMLPolyDataReader> internalReader;
+  vtkNew<vtkFileSeriesReader> reader;
+  reader->SetReader(internalReader);
+  reader->SetFileNameMethod("SetFileName");
+  for (const auto& fname : fileNames)
+  {
+    reader->AddFileName(fname.c_str());
+  }
+  reader->SetNumberOfFilesToPrefetch(2);
+
+  for (int index = 0; index < NumberOfFiles; ++index)
+  {
+    if (!CheckOutput(reader, index, true))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Files prefetched while playing backward must not have the array that is
+  // no longer read.
+  if (!CheckOutput(reader, NumberOfFiles - 2, true))
+  {
+    return EXIT_FAILURE;
+  }
+  internalReader->GetPointDataArraySelection()->DisableArray("Other");
+  for (int index = NumberOfFiles - 3; index >= 0; --index)
+  {
+    if (!CheckOutput(reader, index, false))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
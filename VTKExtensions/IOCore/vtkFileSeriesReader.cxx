@@ -24,19 +24,25 @@
 
 #include "vtkFileSeriesReader.h"
 
+#include "vtkCallbackCommand.h"
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommand.h"
+#include "vtkDataArraySelection.h"
+#include "vtkDataObject.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkTypeTraits.h"
+#include "vtkXMLReader.h"
 
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
@@ -45,10 +51,16 @@
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <condition_variable>
 #include <ctype.h> // for isprint().
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vtk_jsoncpp.h"
@@ -360,6 +372,259 @@ private:
 };
 }
 
+//=============================================================================
+// Internal class reading the files following the current one on a worker
+// thread, using a second reader, so that their outputs can be handed over to
+// the vtkFileSeriesReader instead of being read when they are requested.
+class vtkFileSeriesReaderPrefetcher
+{
+public:
+  // A file to read and the piece of it requested by the pipeline.
+  struct vtkRequest
+  {
+    int Index;
+    std::string FileName;
+    int Piece;
+    int NumberOfPieces;
+    int GhostLevels;
+    bool HasExtent;
+    int Extent[6];
+
+    bool operator==(const vtkRequest& other) const
+    {
+      return this->Index == other.Index && this->FileName == other.FileName &&
+        this->Piece == other.Piece && this->NumberOfPieces == other.NumberOfPieces &&
+        this->GhostLevels == other.GhostLevels && this->HasExtent == other.HasExtent &&
+        (!this->HasExtent || std::equal(this->Extent, this->Extent + 6, other.Extent));
+    }
+  };
+
+  static vtkRequest MakeRequest(int index, const char* fname, vtkInformation* outInfo)
+  {
+    vtkRequest request;
+    request.Index = index;
+    request.FileName = fname;
+    request.Piece = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER())
+      : 0;
+    request.NumberOfPieces =
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES())
+      : 1;
+    request.GhostLevels =
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS())
+      : 0;
+    request.HasExtent = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()) != 0;
+    std::fill(request.Extent, request.Extent + 6, 0);
+    if (request.HasExtent)
+    {
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), request.Extent);
+    }
+    return request;
+  }
+
+  // Returns a string that changes whenever the array selections or the time
+  // array of `reader` change.
+  static std::string GetConfiguration(vtkXMLReader* reader)
+  {
+    std::ostringstream stream;
+    for (vtkDataArraySelection* selection : { reader->GetPointDataArraySelection(),
+           reader->GetCellDataArraySelection(), reader->GetColumnArraySelection() })
+    {
+      for (int cc = 0; cc < selection->GetNumberOfArrays(); ++cc)
+      {
+        stream << selection->GetArrayName(cc) << "=" << selection->GetArraySetting(cc) << ";";
+      }
+      stream << "|";
+    }
+    const char* timeArray = reader->GetActiveTimeDataArrayName();
+    stream << (timeArray ? timeArray : "");
+    return stream.str();
+  }
+
+  vtkFileSeriesReaderPrefetcher(vtkXMLReader* source)
+    : Done(false)
+    , Busy(false)
+    , Failed(false)
+  {
+    this->Reader.TakeReference(source->NewInstance());
+
+    // Errors are not reported from the worker thread. A file that fails to be
+    // read is not handed over, so the vtkFileSeriesReader reads it again and
+    // reports the errors.
+    vtkNew<vtkCallbackCommand> observer;
+    observer->SetCallback(&vtkFileSeriesReaderPrefetcher::OnError);
+    observer->SetClientData(this);
+    this->Reader->AddObserver(vtkCommand::ErrorEvent, observer);
+    this->Reader->AddObserver(vtkCommand::WarningEvent, observer);
+
+    this->Configure(source);
+  }
+
+  ~vtkFileSeriesReaderPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Done = true;
+      this->Pending.clear();
+    }
+    this->Condition.notify_all();
+    if (this->Thread.joinable())
+    {
+      this->Thread.join();
+    }
+  }
+
+  /**
+   * Returns true if the reader used to prefetch the files was configured as
+   * `source` currently is.
+   */
+  bool IsConfiguredAs(vtkXMLReader* source)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Configuration == GetConfiguration(source);
+  }
+
+  /**
+   * Drops the files prefetched and waiting to be prefetched, then copies the
+   * configuration of `source` to the reader used to prefetch the files.
+   */
+  void Configure(vtkXMLReader* source)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Pending.clear();
+    this->Condition.wait(lock, [this]() { return !this->Busy; });
+    this->Outputs.clear();
+
+    this->Reader->GetPointDataArraySelection()->CopySelections(
+      source->GetPointDataArraySelection());
+    this->Reader->GetCellDataArraySelection()->CopySelections(source->GetCellDataArraySelection());
+    this->Reader->GetColumnArraySelection()->CopySelections(source->GetColumnArraySelection());
+    this->Reader->SetActiveTimeDataArrayName(source->GetActiveTimeDataArrayName());
+    this->Configuration = GetConfiguration(source);
+  }
+
+  /**
+   * Replaces the files waiting to be prefetched. Outputs prefetched for files
+   * that are no longer requested are dropped.
+   */
+  void Prefetch(const std::vector<vtkRequest>& requests)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (auto iter = this->Outputs.begin(); iter != this->Outputs.end();)
+    {
+      if (std::find(requests.begin(), requests.end(), iter->first) == requests.end())
+      {
+        iter = this->Outputs.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+    this->Pending.clear();
+    for (const auto& request : requests)
+    {
+      if ((!this->Busy || !(this->Current == request)) && !this->HasOutput(request))
+      {
+        this->Pending.push_back(request);
+      }
+    }
+    if (!this->Thread.joinable())
+    {
+      this->Thread = std::thread(&vtkFileSeriesReaderPrefetcher::Run, this);
+    }
+    this->Condition.notify_all();
+  }
+
+  /**
+   * Returns the output prefetched for `request`, waiting for it if it is being
+   * read, or nullptr if it was not prefetched.
+   */
+  vtkSmartPointer<vtkDataObject> Take(const vtkRequest& request)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(
+      lock, [this, &request]() { return !this->Busy || !(this->Current == request); });
+    for (auto iter = this->Outputs.begin(); iter != this->Outputs.end(); ++iter)
+    {
+      if (iter->first == request)
+      {
+        vtkSmartPointer<vtkDataObject> output = iter->second;
+        this->Outputs.erase(iter);
+        return output;
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  static void OnError(vtkObject*, unsigned long, void* clientdata, void*)
+  {
+    static_cast<vtkFileSeriesReaderPrefetcher*>(clientdata)->Failed = true;
+  }
+
+  bool HasOutput(const vtkRequest& request) const
+  {
+    return std::any_of(this->Outputs.begin(), this->Outputs.end(),
+      [&request](const std::pair<vtkRequest, vtkSmartPointer<vtkDataObject> >& item) {
+        return item.first == request;
+      });
+  }
+
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Done || !this->Pending.empty(); });
+      if (this->Done)
+      {
+        return;
+      }
+      this->Current = this->Pending.front();
+      this->Pending.pop_front();
+      this->Busy = true;
+      const vtkRequest request = this->Current;
+      lock.unlock();
+
+      this->Failed = false;
+      this->Reader->SetFileName(request.FileName.c_str());
+      vtkSmartPointer<vtkDataObject> output;
+      if (this->Reader->UpdatePiece(request.Piece, request.NumberOfPieces, request.GhostLevels,
+            request.HasExtent ? request.Extent : nullptr) &&
+        !this->Failed)
+      {
+        // The reader reuses its output, hand over a copy of it.
+        vtkDataObject* result = this->Reader->GetOutputDataObject(0);
+        output.TakeReference(result->NewInstance());
+        output->ShallowCopy(result);
+      }
+
+      lock.lock();
+      this->Busy = false;
+      if (output)
+      {
+        this->Outputs.push_back(std::make_pair(request, output));
+      }
+      this->Condition.notify_all();
+    }
+  }
+
+  vtkSmartPointer<vtkXMLReader> Reader;
+  std::string Configuration;
+  bool Done;
+  bool Busy;
+  bool Failed;
+  vtkRequest Current;
+  std::deque<vtkRequest> Pending;
+  std::vector<std::pair<vtkRequest, vtkSmartPointer<vtkDataObject> > > Outputs;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::thread Thread;
+};
+
 //=============================================================================
 struct vtkFileSeriesReaderInternals
 {
@@ -368,6 +633,12 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+
+  // Prefetching state: the last file index read and the direction in which
+  // the file indices are moving (+1 or -1).
+  int LastFileIndex = -1;
+  int Direction = 1;
+  std::unique_ptr<vtkFileSeriesReaderPrefetcher> Prefetcher;
 };
 
 //=============================================================================
@@ -384,6 +655,8 @@ vtkFileSeriesReader::vtkFileSeriesReader()
   this->UseJsonMetaFile = false;
 
   this->IgnoreReaderTime = false;
+
+  this->NumberOfFilesToPrefetch = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -704,7 +977,23 @@ int vtkFileSeriesReader::RequestData(
   vtkInformation* outInfo = outputVector->GetInformationObject(requestFromPort);
   this->Internal->TimeRanges->GetInputTimeInfo(this->_FileIndex, outInfo);
 
-  int retVal = this->Reader->ProcessRequest(request, inputVector, outputVector);
+  int retVal = 0;
+  if (this->NumberOfFilesToPrefetch > 0 && this->UsePrefetchedOutput(outInfo))
+  {
+    retVal = 1;
+  }
+  else
+  {
+    retVal = this->Reader->ProcessRequest(request, inputVector, outputVector);
+  }
+
+  // Read the next files while the rest of the pipeline processes this one.
+  // This is done before restoring the information, which is needed to know
+  // the number of time steps in the current file.
+  if (retVal && this->NumberOfFilesToPrefetch > 0)
+  {
+    this->PrefetchNextFiles(outInfo);
+  }
 
   if (this->GetNumberOfFileNames() > 0)
   {
@@ -715,6 +1004,90 @@ int vtkFileSeriesReader::RequestData(
   return retVal;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReader::UsePrefetchedOutput(vtkInformation* outInfo)
+{
+  auto& prefetcher = this->Internal->Prefetcher;
+  vtkXMLReader* reader = vtkXMLReader::SafeDownCast(this->Reader);
+  const char* fname = this->GetFileName(static_cast<unsigned int>(this->_FileIndex));
+  vtkDataObject* output = vtkDataObject::GetData(outInfo);
+  if (!prefetcher || !reader || !fname || !output)
+  {
+    return false;
+  }
+
+  // Outputs read before the arrays to read changed cannot be used.
+  if (!prefetcher->IsConfiguredAs(reader))
+  {
+    prefetcher->Configure(reader);
+    return false;
+  }
+
+  vtkSmartPointer<vtkDataObject> prefetched = prefetcher->Take(
+    vtkFileSeriesReaderPrefetcher::MakeRequest(this->_FileIndex, fname, outInfo));
+  if (!prefetched)
+  {
+    return false;
+  }
+  output->ShallowCopy(prefetched);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::PrefetchNextFiles(vtkInformation* outInfo)
+{
+  auto& internals = *this->Internal;
+  const int numFiles = static_cast<int>(this->GetNumberOfFileNames());
+  const int index = this->_FileIndex;
+  vtkXMLReader* reader = vtkXMLReader::SafeDownCast(this->Reader);
+  if (index < 0 || index >= numFiles || !reader)
+  {
+    return;
+  }
+
+  // Files with several time steps are read for the time requested, which the
+  // second reader does not know.
+  if (outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()) > 1)
+  {
+    return;
+  }
+
+  // Follow the direction in which the animation is playing.
+  if (internals.LastFileIndex >= 0 && index != internals.LastFileIndex)
+  {
+    internals.Direction = index > internals.LastFileIndex ? 1 : -1;
+  }
+  internals.LastFileIndex = index;
+
+  // Only the piece requested from this process is read, so that, in
+  // parallel, each rank only prefetches its own part of the files.
+  std::vector<vtkFileSeriesReaderPrefetcher::vtkRequest> requests;
+  for (int cc = 1; cc <= this->NumberOfFilesToPrefetch; ++cc)
+  {
+    const int next = index + cc * internals.Direction;
+    if (next < 0 || next >= numFiles)
+    {
+      break;
+    }
+    requests.push_back(vtkFileSeriesReaderPrefetcher::MakeRequest(
+      next, this->GetFileName(static_cast<unsigned int>(next)), outInfo));
+  }
+  if (requests.empty())
+  {
+    return;
+  }
+
+  if (!internals.Prefetcher)
+  {
+    internals.Prefetcher.reset(new vtkFileSeriesReaderPrefetcher(reader));
+  }
+  else if (!internals.Prefetcher->IsConfiguredAs(reader))
+  {
+    internals.Prefetcher->Configure(reader);
+  }
+  internals.Prefetcher->Prefetch(requests);
+}
+
 //-----------------------------------------------------------------------------
 int vtkFileSeriesReader::RequestInformationForInput(
   int index, vtkInformation* request, vtkInformationVector* outputVector)
@@ -962,6 +1335,7 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "NumberOfFilesToPrefetch: " << this->NumberOfFilesToPrefetch << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -153,6 +153,25 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   //@}
 
+  //@{
+  /**
+   * Number of files, following the current one in the direction the time steps
+   * are being played, to read ahead in the background. This hides the time
+   * spent reading a file when the pipeline processing a time step takes about
+   * as long. The files are read by a second instance of the internal reader,
+   * configured as the internal reader, on a worker thread, and its outputs are
+   * used when the pipeline requests these files. Only the piece requested from
+   * this process is read. 0, the default, disables prefetching.
+   *
+   * Prefetching is only supported for internal readers that are vtkXMLReader
+   * subclasses, reading files with at most one time step. Their array
+   * selections and time array are copied to the second reader, and outputs
+   * read with an older configuration are dropped.
+   */
+  vtkSetClampMacro(NumberOfFilesToPrefetch, int, 0, 16);
+  vtkGetMacro(NumberOfFilesToPrefetch, int);
+  //@}
+
   // Expose number of files, first filename and current file number as
   // information keys for potential use in the internal reader
   static vtkInformationIntegerKey* FILE_SERIES_NUMBER_OF_FILES();
@@ -233,8 +252,22 @@ protected:
 
   bool IgnoreReaderTime;
 
+  int NumberOfFilesToPrefetch;
+
   int ChooseInput(vtkInformation*);
 
+  /**
+   * Starts reading the files following the current one in the background.
+   * Called after the data for the current file has been read.
+   */
+  void PrefetchNextFiles(vtkInformation* outInfo);
+
+  /**
+   * Shallow copies the output prefetched for the current file, if any, to the
+   * output. Returns false if the file was not prefetched.
+   */
+  bool UsePrefetchedOutput(vtkInformation* outInfo);
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
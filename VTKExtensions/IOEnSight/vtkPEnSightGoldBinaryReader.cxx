@@ -21,8 +21,166 @@
 #include <ctype.h>
 #include <string>
 
+#ifdef _WIN32
+#include "vtksys/Encoding.hxx"
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Read-only memory mapping of a whole file.
+class vtkPEnSightMappedFile
+{
+public:
+  vtkPEnSightMappedFile() = default;
+  ~vtkPEnSightMappedFile() { this->Close(); }
+
+  bool Open(const char* filename, size_t size)
+  {
+    this->Close();
+    if (size == 0)
+    {
+      return false;
+    }
+#ifdef _WIN32
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWide(filename).c_str(), GENERIC_READ,
+      FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+      return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr)
+    {
+      return false;
+    }
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+      return false;
+    }
+#endif
+    this->Data = static_cast<char*>(data);
+    this->Size = size;
+    return true;
+  }
+
+  void Close()
+  {
+    if (this->Data)
+    {
+#ifdef _WIN32
+      UnmapViewOfFile(this->Data);
+#else
+      munmap(this->Data, this->Size);
+#endif
+    }
+    this->Data = nullptr;
+    this->Size = 0;
+  }
+
+  char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+
+private:
+  vtkPEnSightMappedFile(const vtkPEnSightMappedFile&) = delete;
+  void operator=(const vtkPEnSightMappedFile&) = delete;
+
+  char* Data = nullptr;
+  size_t Size = 0;
+};
+
+//----------------------------------------------------------------------------
+// Stream buffer exposing a whole mapped file as its get area, so that reads
+// are plain copies from memory and seeks only move a pointer.
+class vtkPEnSightMappedStreamBuffer : public std::streambuf
+{
+public:
+  void SetData(char* data, size_t size) { this->setg(data, data, data + size); }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+  {
+    if (!(which & std::ios_base::in))
+    {
+      return pos_type(off_type(-1));
+    }
+    const off_type size = this->egptr() - this->eback();
+    off_type pos = off;
+    if (dir == std::ios_base::cur)
+    {
+      pos += this->gptr() - this->eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      pos += size;
+    }
+    if (pos < 0 || pos > size)
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->eback(), this->eback() + pos, this->egptr());
+    return pos_type(pos);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+  {
+    return this->seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+// Input stream reading from a memory mapped file.
+class vtkPEnSightGoldBinaryReader::vtkMappedIStream : public std::istream
+{
+public:
+  vtkMappedIStream()
+    : std::istream(nullptr)
+  {
+  }
+
+  bool Open(const char* filename, size_t size)
+  {
+    if (!this->File.Open(filename, size))
+    {
+      return false;
+    }
+    this->Buffer.SetData(this->File.GetData(), this->File.GetSize());
+    this->rdbuf(&this->Buffer);
+    return true;
+  }
+
+  const char* GetData() const { return this->File.GetData(); }
+  size_t GetSize() const { return this->File.GetSize(); }
+
+private:
+  vtkPEnSightMappedFile File;
+  vtkPEnSightMappedStreamBuffer Buffer;
+};
+
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
@@ -44,6 +202,7 @@ vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
   this->FloatBufferIndexBegin = -1;
   this->FloatBufferFilePosition = 0;
   this->FloatBufferNumberOfVectors = 0;
+  this->FloatBufferMappedData = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -77,11 +236,23 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
+    // Map the file in memory so that the many small reads and seeks done while
+    // walking through parts are cheap. Fall back to a regular stream if the
+    // file cannot be mapped.
+    vtkMappedIStream* mapped = new vtkMappedIStream;
+    if (mapped->Open(filename, static_cast<size_t>(fs.st_size)))
+    {
+      this->IFile = mapped;
+    }
+    else
+    {
+      delete mapped;
 #ifdef _WIN32
-    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
+      this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
 #else
-    this->IFile = new vtksys::ifstream(filename, ios::in);
+      this->IFile = new vtksys::ifstream(filename, ios::in);
 #endif
+    }
   }
   else
   {
@@ -158,6 +329,16 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::RequestInformation(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // The case file is read again: the variable files, or their contents, may
+  // have changed since they were indexed.
+  this->PartOffsets.clear();
+  return this->Superclass::RequestInformation(request, inputVector, outputVector);
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::InitializeFile(const char* fileName)
 {
@@ -1441,13 +1622,22 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
         scalars = (vtkFloatArray*)(output->GetPointData()->GetArray(description));
       }
 
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
+      if (this->GetPointIds(realId)->GetLocalNumberOfIds() > 0)
+      {
+        scalarsRead = new float[numPts];
+        this->ReadFloatArray(scalarsRead, numPts);
 
-      for (i = 0; i < numPts; i++)
+        for (i = 0; i < numPts; i++)
+        {
+          this->InsertVariableComponent(
+            scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_NODE);
+        }
+        delete[] scalarsRead;
+      }
+      else
       {
-        this->InsertVariableComponent(
-          scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_NODE);
+        // None of the points of this part are read by this process.
+        this->SkipFloatArrays(1, numPts);
       }
       if (component == 0)
       {
@@ -1463,7 +1653,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       {
         output->GetPointData()->AddArray(scalars);
       }
-      delete[] scalarsRead;
     }
 
     this->IFile->peek();
@@ -1647,18 +1836,29 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       this->ReadLine(line); // "coordinates" or "block"
       vectors->SetNumberOfComponents(3);
       vectors->SetNumberOfTuples(this->GetPointIds(realId)->GetLocalNumberOfIds());
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
+      if (vectors->GetNumberOfTuples() > 0)
+      {
+        comp1 = new float[numPts];
+        comp2 = new float[numPts];
+        comp3 = new float[numPts];
+        this->ReadFloatArray(comp1, numPts);
+        this->ReadFloatArray(comp2, numPts);
+        this->ReadFloatArray(comp3, numPts);
+        for (i = 0; i < numPts; i++)
+        {
+          tuple[0] = comp1[i];
+          tuple[1] = comp2[i];
+          tuple[2] = comp3[i];
+          this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_NODE);
+        }
+        delete[] comp1;
+        delete[] comp2;
+        delete[] comp3;
+      }
+      else
       {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_NODE);
+        // None of the points of this part are read by this process.
+        this->SkipFloatArrays(3, numPts);
       }
       vectors->SetName(description);
       output->GetPointData()->AddArray(vectors);
@@ -1666,11 +1866,8 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       {
         output->GetPointData()->SetVectors(vectors);
       }
-      vectors->Delete();
-      delete[] comp1;
-      delete[] comp2;
-      delete[] comp3;
     }
+    vectors->Delete();
 
     this->IFile->peek();
     if (this->IFile->eof())
@@ -1798,37 +1995,45 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
       this->ReadLine(line); // "coordinates" or "block"
       tensors->SetNumberOfComponents(6);
       tensors->SetNumberOfTuples(this->GetPointIds(realId)->GetLocalNumberOfIds());
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      comp4 = new float[numPts];
-      comp5 = new float[numPts];
-      comp6 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      this->ReadFloatArray(comp4, numPts);
-      this->ReadFloatArray(comp6, numPts);
-      this->ReadFloatArray(comp5, numPts);
-      for (i = 0; i < numPts; i++)
+      if (tensors->GetNumberOfTuples() > 0)
+      {
+        comp1 = new float[numPts];
+        comp2 = new float[numPts];
+        comp3 = new float[numPts];
+        comp4 = new float[numPts];
+        comp5 = new float[numPts];
+        comp6 = new float[numPts];
+        this->ReadFloatArray(comp1, numPts);
+        this->ReadFloatArray(comp2, numPts);
+        this->ReadFloatArray(comp3, numPts);
+        this->ReadFloatArray(comp4, numPts);
+        this->ReadFloatArray(comp6, numPts);
+        this->ReadFloatArray(comp5, numPts);
+        for (i = 0; i < numPts; i++)
+        {
+          tuple[0] = comp1[i];
+          tuple[1] = comp2[i];
+          tuple[2] = comp3[i];
+          tuple[3] = comp4[i];
+          tuple[4] = comp5[i];
+          tuple[5] = comp6[i];
+          this->InsertVariableComponent(tensors, i, -1, tuple, realId, 0, TENSOR_SYMM_PER_NODE);
+        }
+        delete[] comp1;
+        delete[] comp2;
+        delete[] comp3;
+        delete[] comp4;
+        delete[] comp5;
+        delete[] comp6;
+      }
+      else
       {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        tuple[3] = comp4[i];
-        tuple[4] = comp5[i];
-        tuple[5] = comp6[i];
-        this->InsertVariableComponent(tensors, i, -1, tuple, realId, 0, TENSOR_SYMM_PER_NODE);
+        // None of the points of this part are read by this process.
+        this->SkipFloatArrays(6, numPts);
       }
       tensors->SetName(description);
       output->GetPointData()->AddArray(tensors);
       tensors->Delete();
-      delete[] comp1;
-      delete[] comp2;
-      delete[] comp3;
-      delete[] comp4;
-      delete[] comp5;
-      delete[] comp6;
     }
 
     this->IFile->peek();
@@ -1853,6 +2058,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
 {
   char line[80];
   int partId, realId, numCells, numCellsPerElement, i, idx;
+  vtkIdType localNumCells;
   vtkFloatArray* scalars;
   float* scalarsRead;
   int lineRead, elementType;
@@ -1887,7 +2093,9 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
     return 0;
   }
 
-  if (this->UseFileSets)
+  // Once the time step is indexed, its parts are read directly.
+  PartOffsetsType* partOffsets = this->FindPartOffsets(fileName, timeStep);
+  if (this->UseFileSets && !partOffsets)
   {
     int realTimeStep = timeStep - 1;
     // Try to find the nearest time step for which we know the offset
@@ -1974,78 +2182,75 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
     }
   }
 
-  this->ReadLine(line);            // skip the description line
-  lineRead = this->ReadLine(line); // "part"
+  PartOffsetsType newPartOffsets;
+  size_t nextPart = 0;
+  lineRead = 1;
+  if (!partOffsets)
+  {
+    this->ReadLine(line);            // skip the description line
+    lineRead = this->ReadLine(line); // "part"
+  }
 
-  while (lineRead && strncmp(line, "part", 4) == 0)
+  while (
+    partOffsets ? nextPart < partOffsets->size() : (lineRead && strncmp(line, "part", 4) == 0))
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing with 1.
+    if (partOffsets)
+    {
+      partId = (*partOffsets)[nextPart].first;
+      this->IFile->clear();
+      this->IFile->seekg((*partOffsets)[nextPart++].second, ios::beg);
+    }
+    else
+    {
+      this->ReadPartId(&partId);
+      partId--; // EnSight starts #ing with 1.
+      newPartOffsets.push_back(std::make_pair(partId, static_cast<long>(this->IFile->tellg())));
+    }
     realId = this->InsertNewPartId(partId);
     output = this->GetDataSetFromBlock(compositeOutput, realId);
     numCells = this->GetTotalNumberOfCellIds(realId);
+    localNumCells = this->GetLocalTotalNumberOfCellIds(realId);
     if (numCells)
     {
-      this->ReadLine(line); // element type or "block"
       if (component == 0)
       {
         scalars = vtkFloatArray::New();
         scalars->SetNumberOfComponents(numberOfComponents);
-        scalars->SetNumberOfTuples(this->GetLocalTotalNumberOfCellIds(realId));
+        scalars->SetNumberOfTuples(localNumCells);
       }
       else
       {
         scalars = (vtkFloatArray*)(output->GetCellData()->GetArray(description));
       }
 
-      // need to find out from CellIds how many cells we have of this element
-      // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
-      if (strncmp(line, "block", 5) == 0)
+      if (partOffsets && localNumCells == 0)
       {
-        scalarsRead = new float[numCells];
-        this->ReadFloatArray(scalarsRead, numCells);
-        for (i = 0; i < numCells; i++)
-        {
-          this->InsertVariableComponent(
-            scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_ELEMENT);
-        }
-        if (this->IFile->eof())
-        {
-          lineRead = 0;
-        }
-        else
-        {
-          lineRead = this->ReadLine(line);
-        }
-        delete[] scalarsRead;
+        // None of the cells of this part are read by this process, and the
+        // next part is found with the index.
       }
       else
       {
-        while (lineRead && strncmp(line, "part", 4) != 0 && strncmp(line, "END TIME STEP", 13) != 0)
+        this->ReadLine(line); // element type or "block"
+
+        // need to find out from CellIds how many cells we have of this element
+        // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
+        if (strncmp(line, "block", 5) == 0)
         {
-          elementType = this->GetElementType(line);
-          if (elementType == -1)
+          if (localNumCells > 0)
           {
-            vtkErrorMacro("Unknown element type \"" << line << "\"");
-            delete this->IFile;
-            this->IFile = NULL;
-
-            if (component == 0)
+            scalarsRead = new float[numCells];
+            this->ReadFloatArray(scalarsRead, numCells);
+            for (i = 0; i < numCells; i++)
             {
-              scalars->Delete();
+              this->InsertVariableComponent(
+                scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_ELEMENT);
             }
-            return 0;
+            delete[] scalarsRead;
           }
-          idx = this->UnstructuredPartIds->IsId(realId);
-          numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          scalarsRead = new float[numCellsPerElement];
-          this->ReadFloatArray(scalarsRead, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
+          else
           {
-            this->InsertVariableComponent(
-              scalars, i, component, &(scalarsRead[i]), idx, elementType, SCALAR_PER_ELEMENT);
+            this->SkipFloatArrays(1, numCells);
           }
-          this->IFile->peek();
           if (this->IFile->eof())
           {
             lineRead = 0;
@@ -2054,9 +2259,54 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
           {
             lineRead = this->ReadLine(line);
           }
-          delete[] scalarsRead;
-        } // end while
-      }   // end else
+        }
+        else
+        {
+          while (
+            lineRead && strncmp(line, "part", 4) != 0 && strncmp(line, "END TIME STEP", 13) != 0)
+          {
+            elementType = this->GetElementType(line);
+            if (elementType == -1)
+            {
+              vtkErrorMacro("Unknown element type \"" << line << "\"");
+              delete this->IFile;
+              this->IFile = NULL;
+
+              if (component == 0)
+              {
+                scalars->Delete();
+              }
+              return 0;
+            }
+            idx = this->UnstructuredPartIds->IsId(realId);
+            numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
+            if (localNumCells > 0)
+            {
+              scalarsRead = new float[numCellsPerElement];
+              this->ReadFloatArray(scalarsRead, numCellsPerElement);
+              for (i = 0; i < numCellsPerElement; i++)
+              {
+                this->InsertVariableComponent(
+                  scalars, i, component, &(scalarsRead[i]), idx, elementType, SCALAR_PER_ELEMENT);
+              }
+              delete[] scalarsRead;
+            }
+            else
+            {
+              this->SkipFloatArrays(1, numCellsPerElement);
+            }
+            this->IFile->peek();
+            if (this->IFile->eof())
+            {
+              lineRead = 0;
+            }
+            else
+            {
+              lineRead = this->ReadLine(line);
+            }
+          } // end while
+        }   // end else
+      }
       if (component == 0)
       {
         scalars->SetName(description);
@@ -2072,7 +2322,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
         output->GetCellData()->AddArray(scalars);
       }
     }
-    else
+    else if (!partOffsets)
     {
       this->IFile->peek();
       if (this->IFile->eof())
@@ -2085,6 +2335,10 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
       }
     }
   }
+  if (!partOffsets)
+  {
+    this->PartOffsets[fileName][timeStep] = newPartOffsets;
+  }
 
   delete this->IFile;
   this->IFile = NULL;
@@ -2098,6 +2352,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
 {
   char line[80];
   int partId, realId, numCells, numCellsPerElement, i, idx;
+  vtkIdType localNumCells;
   vtkFloatArray* vectors;
   float *comp1, *comp2, *comp3;
   int lineRead, elementType;
@@ -2133,7 +2388,9 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
     return 0;
   }
 
-  if (this->UseFileSets)
+  // Once the time step is indexed, its parts are read directly.
+  PartOffsetsType* partOffsets = this->FindPartOffsets(fileName, timeStep);
+  if (this->UseFileSets && !partOffsets)
   {
     int realTimeStep = timeStep - 1;
     // Try to find the nearest time step for which we know the offset
@@ -2221,80 +2478,75 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
     }
   }
 
-  this->ReadLine(line);            // skip the description line
-  lineRead = this->ReadLine(line); // "part"
+  PartOffsetsType newPartOffsets;
+  size_t nextPart = 0;
+  lineRead = 1;
+  if (!partOffsets)
+  {
+    this->ReadLine(line);            // skip the description line
+    lineRead = this->ReadLine(line); // "part"
+  }
 
-  while (lineRead && strncmp(line, "part", 4) == 0)
+  while (
+    partOffsets ? nextPart < partOffsets->size() : (lineRead && strncmp(line, "part", 4) == 0))
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing with 1.
+    if (partOffsets)
+    {
+      partId = (*partOffsets)[nextPart].first;
+      this->IFile->clear();
+      this->IFile->seekg((*partOffsets)[nextPart++].second, ios::beg);
+    }
+    else
+    {
+      this->ReadPartId(&partId);
+      partId--; // EnSight starts #ing with 1.
+      newPartOffsets.push_back(std::make_pair(partId, static_cast<long>(this->IFile->tellg())));
+    }
     realId = this->InsertNewPartId(partId);
     output = this->GetDataSetFromBlock(compositeOutput, realId);
     numCells = this->GetTotalNumberOfCellIds(realId);
+    localNumCells = this->GetLocalTotalNumberOfCellIds(realId);
     if (numCells)
     {
       vectors = vtkFloatArray::New();
-      this->ReadLine(line); // element type or "block"
       vectors->SetNumberOfComponents(3);
-      vectors->SetNumberOfTuples(this->GetLocalTotalNumberOfCellIds(realId));
-      // need to find out from CellIds how many cells we have of this element
-      // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
-      if (strncmp(line, "block", 5) == 0)
-      {
-        comp1 = new float[numCells];
-        comp2 = new float[numCells];
-        comp3 = new float[numCells];
-        this->ReadFloatArray(comp1, numCells);
-        this->ReadFloatArray(comp2, numCells);
-        this->ReadFloatArray(comp3, numCells);
-        for (i = 0; i < numCells; i++)
-        {
-          tuple[0] = comp1[i];
-          tuple[1] = comp2[i];
-          tuple[2] = comp3[i];
-          this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_ELEMENT);
-        }
-        this->IFile->peek();
-        if (this->IFile->eof())
-        {
-          lineRead = 0;
-        }
-        else
-        {
-          lineRead = this->ReadLine(line);
-        }
-        delete[] comp1;
-        delete[] comp2;
-        delete[] comp3;
+      vectors->SetNumberOfTuples(localNumCells);
+
+      if (partOffsets && localNumCells == 0)
+      {
+        // None of the cells of this part are read by this process, and the
+        // next part is found with the index.
       }
       else
       {
-        while (lineRead && strncmp(line, "part", 4) != 0 && strncmp(line, "END TIME STEP", 13) != 0)
+        this->ReadLine(line); // element type or "block"
+
+        // need to find out from CellIds how many cells we have of this element
+        // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
+        if (strncmp(line, "block", 5) == 0)
         {
-          elementType = this->GetElementType(line);
-          if (elementType == -1)
+          if (localNumCells > 0)
           {
-            vtkErrorMacro("Unknown element type \"" << line << "\"");
-            delete this->IS;
-            this->IS = NULL;
-            vectors->Delete();
-            return 0;
+            comp1 = new float[numCells];
+            comp2 = new float[numCells];
+            comp3 = new float[numCells];
+            this->ReadFloatArray(comp1, numCells);
+            this->ReadFloatArray(comp2, numCells);
+            this->ReadFloatArray(comp3, numCells);
+            for (i = 0; i < numCells; i++)
+            {
+              tuple[0] = comp1[i];
+              tuple[1] = comp2[i];
+              tuple[2] = comp3[i];
+              this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_ELEMENT);
+            }
+            delete[] comp1;
+            delete[] comp2;
+            delete[] comp3;
           }
-          idx = this->UnstructuredPartIds->IsId(realId);
-          numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          comp1 = new float[numCellsPerElement];
-          comp2 = new float[numCellsPerElement];
-          comp3 = new float[numCellsPerElement];
-          this->ReadFloatArray(comp1, numCellsPerElement);
-          this->ReadFloatArray(comp2, numCellsPerElement);
-          this->ReadFloatArray(comp3, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
+          else
           {
-            tuple[0] = comp1[i];
-            tuple[1] = comp2[i];
-            tuple[2] = comp3[i];
-            this->InsertVariableComponent(
-              vectors, i, 0, tuple, idx, elementType, VECTOR_PER_ELEMENT);
+            this->SkipFloatArrays(3, numCells);
           }
           this->IFile->peek();
           if (this->IFile->eof())
@@ -2305,11 +2557,59 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
           {
             lineRead = this->ReadLine(line);
           }
-          delete[] comp1;
-          delete[] comp2;
-          delete[] comp3;
-        } // end while
-      }   // end else
+        }
+        else
+        {
+          while (
+            lineRead && strncmp(line, "part", 4) != 0 && strncmp(line, "END TIME STEP", 13) != 0)
+          {
+            elementType = this->GetElementType(line);
+            if (elementType == -1)
+            {
+              vtkErrorMacro("Unknown element type \"" << line << "\"");
+              delete this->IFile;
+              this->IFile = NULL;
+              vectors->Delete();
+              return 0;
+            }
+            idx = this->UnstructuredPartIds->IsId(realId);
+            numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
+            if (localNumCells > 0)
+            {
+              comp1 = new float[numCellsPerElement];
+              comp2 = new float[numCellsPerElement];
+              comp3 = new float[numCellsPerElement];
+              this->ReadFloatArray(comp1, numCellsPerElement);
+              this->ReadFloatArray(comp2, numCellsPerElement);
+              this->ReadFloatArray(comp3, numCellsPerElement);
+              for (i = 0; i < numCellsPerElement; i++)
+              {
+                tuple[0] = comp1[i];
+                tuple[1] = comp2[i];
+                tuple[2] = comp3[i];
+                this->InsertVariableComponent(
+                  vectors, i, 0, tuple, idx, elementType, VECTOR_PER_ELEMENT);
+              }
+              delete[] comp1;
+              delete[] comp2;
+              delete[] comp3;
+            }
+            else
+            {
+              this->SkipFloatArrays(3, numCellsPerElement);
+            }
+            this->IFile->peek();
+            if (this->IFile->eof())
+            {
+              lineRead = 0;
+            }
+            else
+            {
+              lineRead = this->ReadLine(line);
+            }
+          } // end while
+        }   // end else
+      }
       vectors->SetName(description);
       output->GetCellData()->AddArray(vectors);
       if (!output->GetCellData()->GetVectors())
@@ -2318,7 +2618,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
       }
       vectors->Delete();
     }
-    else
+    else if (!partOffsets)
     {
       this->IFile->peek();
       if (this->IFile->eof())
@@ -2331,6 +2631,10 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
       }
     }
   }
+  if (!partOffsets)
+  {
+    this->PartOffsets[fileName][timeStep] = newPartOffsets;
+  }
 
   delete this->IFile;
   this->IFile = NULL;
@@ -2344,6 +2648,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
 {
   char line[80];
   int partId, realId, numCells, numCellsPerElement, i, idx;
+  vtkIdType localNumCells;
   vtkFloatArray* tensors;
   int lineRead, elementType;
   float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
@@ -2379,7 +2684,9 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
     return 0;
   }
 
-  if (this->UseFileSets)
+  // Once the time step is indexed, its parts are read directly.
+  PartOffsetsType* partOffsets = this->FindPartOffsets(fileName, timeStep);
+  if (this->UseFileSets && !partOffsets)
   {
     int realTimeStep = timeStep - 1;
     // Try to find the nearest time step for which we know the offset
@@ -2467,102 +2774,88 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
     }
   }
 
-  this->ReadLine(line);            // skip the description line
-  lineRead = this->ReadLine(line); // "part"
+  PartOffsetsType newPartOffsets;
+  size_t nextPart = 0;
+  lineRead = 1;
+  if (!partOffsets)
+  {
+    this->ReadLine(line);            // skip the description line
+    lineRead = this->ReadLine(line); // "part"
+  }
 
-  while (lineRead && strncmp(line, "part", 4) == 0)
+  while (
+    partOffsets ? nextPart < partOffsets->size() : (lineRead && strncmp(line, "part", 4) == 0))
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing with 1.
+    if (partOffsets)
+    {
+      partId = (*partOffsets)[nextPart].first;
+      this->IFile->clear();
+      this->IFile->seekg((*partOffsets)[nextPart++].second, ios::beg);
+    }
+    else
+    {
+      this->ReadPartId(&partId);
+      partId--; // EnSight starts #ing with 1.
+      newPartOffsets.push_back(std::make_pair(partId, static_cast<long>(this->IFile->tellg())));
+    }
     realId = this->InsertNewPartId(partId);
     output = this->GetDataSetFromBlock(compositeOutput, realId);
     numCells = this->GetTotalNumberOfCellIds(realId);
+    localNumCells = this->GetLocalTotalNumberOfCellIds(realId);
     if (numCells)
     {
       tensors = vtkFloatArray::New();
-      this->ReadLine(line); // element type or "block"
       tensors->SetNumberOfComponents(6);
-      tensors->SetNumberOfTuples(this->GetLocalTotalNumberOfCellIds(realId));
-
-      // need to find out from CellIds how many cells we have of this element
-      // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
-      if (strncmp(line, "block", 5) == 0)
-      {
-        comp1 = new float[numCells];
-        comp2 = new float[numCells];
-        comp3 = new float[numCells];
-        comp4 = new float[numCells];
-        comp5 = new float[numCells];
-        comp6 = new float[numCells];
-        this->ReadFloatArray(comp1, numCells);
-        this->ReadFloatArray(comp2, numCells);
-        this->ReadFloatArray(comp3, numCells);
-        this->ReadFloatArray(comp4, numCells);
-        this->ReadFloatArray(comp6, numCells);
-        this->ReadFloatArray(comp5, numCells);
-        for (i = 0; i < numCells; i++)
-        {
-          tuple[0] = comp1[i];
-          tuple[1] = comp2[i];
-          tuple[2] = comp3[i];
-          tuple[3] = comp4[i];
-          tuple[4] = comp5[i];
-          tuple[5] = comp6[i];
-          this->InsertVariableComponent(tensors, i, -1, tuple, realId, 0, TENSOR_SYMM_PER_ELEMENT);
-        }
-        this->IFile->peek();
-        if (this->IFile->eof())
-        {
-          lineRead = 0;
-        }
-        else
-        {
-          lineRead = this->ReadLine(line);
-        }
-        delete[] comp1;
-        delete[] comp2;
-        delete[] comp3;
-        delete[] comp4;
-        delete[] comp5;
-        delete[] comp6;
+      tensors->SetNumberOfTuples(localNumCells);
+
+      if (partOffsets && localNumCells == 0)
+      {
+        // None of the cells of this part are read by this process, and the
+        // next part is found with the index.
       }
       else
       {
-        while (lineRead && strncmp(line, "part", 4) != 0 && strncmp(line, "END TIME STEP", 13) != 0)
+        this->ReadLine(line); // element type or "block"
+
+        // need to find out from CellIds how many cells we have of this element
+        // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
+        if (strncmp(line, "block", 5) == 0)
         {
-          elementType = this->GetElementType(line);
-          if (elementType == -1)
+          if (localNumCells > 0)
           {
-            vtkErrorMacro("Unknown element type \"" << line << "\"");
-            delete this->IS;
-            this->IS = NULL;
-            tensors->Delete();
-            return 0;
+            comp1 = new float[numCells];
+            comp2 = new float[numCells];
+            comp3 = new float[numCells];
+            comp4 = new float[numCells];
+            comp5 = new float[numCells];
+            comp6 = new float[numCells];
+            this->ReadFloatArray(comp1, numCells);
+            this->ReadFloatArray(comp2, numCells);
+            this->ReadFloatArray(comp3, numCells);
+            this->ReadFloatArray(comp4, numCells);
+            this->ReadFloatArray(comp6, numCells);
+            this->ReadFloatArray(comp5, numCells);
+            for (i = 0; i < numCells; i++)
+            {
+              tuple[0] = comp1[i];
+              tuple[1] = comp2[i];
+              tuple[2] = comp3[i];
+              tuple[3] = comp4[i];
+              tuple[4] = comp5[i];
+              tuple[5] = comp6[i];
+              this->InsertVariableComponent(
+                tensors, i, -1, tuple, realId, 0, TENSOR_SYMM_PER_ELEMENT);
+            }
+            delete[] comp1;
+            delete[] comp2;
+            delete[] comp3;
+            delete[] comp4;
+            delete[] comp5;
+            delete[] comp6;
           }
-          idx = this->UnstructuredPartIds->IsId(realId);
-          numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          comp1 = new float[numCellsPerElement];
-          comp2 = new float[numCellsPerElement];
-          comp3 = new float[numCellsPerElement];
-          comp4 = new float[numCellsPerElement];
-          comp5 = new float[numCellsPerElement];
-          comp6 = new float[numCellsPerElement];
-          this->ReadFloatArray(comp1, numCellsPerElement);
-          this->ReadFloatArray(comp2, numCellsPerElement);
-          this->ReadFloatArray(comp3, numCellsPerElement);
-          this->ReadFloatArray(comp4, numCellsPerElement);
-          this->ReadFloatArray(comp6, numCellsPerElement);
-          this->ReadFloatArray(comp5, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
+          else
           {
-            tuple[0] = comp1[i];
-            tuple[1] = comp2[i];
-            tuple[2] = comp3[i];
-            tuple[3] = comp4[i];
-            tuple[4] = comp5[i];
-            tuple[5] = comp6[i];
-            this->InsertVariableComponent(
-              tensors, i, 0, tuple, idx, elementType, TENSOR_SYMM_PER_ELEMENT);
+            this->SkipFloatArrays(6, numCells);
           }
           this->IFile->peek();
           if (this->IFile->eof())
@@ -2573,19 +2866,76 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
           {
             lineRead = this->ReadLine(line);
           }
-          delete[] comp1;
-          delete[] comp2;
-          delete[] comp3;
-          delete[] comp4;
-          delete[] comp5;
-          delete[] comp6;
-        } // end while
-      }   // end else
+        }
+        else
+        {
+          while (
+            lineRead && strncmp(line, "part", 4) != 0 && strncmp(line, "END TIME STEP", 13) != 0)
+          {
+            elementType = this->GetElementType(line);
+            if (elementType == -1)
+            {
+              vtkErrorMacro("Unknown element type \"" << line << "\"");
+              delete this->IFile;
+              this->IFile = NULL;
+              tensors->Delete();
+              return 0;
+            }
+            idx = this->UnstructuredPartIds->IsId(realId);
+            numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
+            if (localNumCells > 0)
+            {
+              comp1 = new float[numCellsPerElement];
+              comp2 = new float[numCellsPerElement];
+              comp3 = new float[numCellsPerElement];
+              comp4 = new float[numCellsPerElement];
+              comp5 = new float[numCellsPerElement];
+              comp6 = new float[numCellsPerElement];
+              this->ReadFloatArray(comp1, numCellsPerElement);
+              this->ReadFloatArray(comp2, numCellsPerElement);
+              this->ReadFloatArray(comp3, numCellsPerElement);
+              this->ReadFloatArray(comp4, numCellsPerElement);
+              this->ReadFloatArray(comp6, numCellsPerElement);
+              this->ReadFloatArray(comp5, numCellsPerElement);
+              for (i = 0; i < numCellsPerElement; i++)
+              {
+                tuple[0] = comp1[i];
+                tuple[1] = comp2[i];
+                tuple[2] = comp3[i];
+                tuple[3] = comp4[i];
+                tuple[4] = comp5[i];
+                tuple[5] = comp6[i];
+                this->InsertVariableComponent(
+                  tensors, i, 0, tuple, idx, elementType, TENSOR_SYMM_PER_ELEMENT);
+              }
+              delete[] comp1;
+              delete[] comp2;
+              delete[] comp3;
+              delete[] comp4;
+              delete[] comp5;
+              delete[] comp6;
+            }
+            else
+            {
+              this->SkipFloatArrays(6, numCellsPerElement);
+            }
+            this->IFile->peek();
+            if (this->IFile->eof())
+            {
+              lineRead = 0;
+            }
+            else
+            {
+              lineRead = this->ReadLine(line);
+            }
+          } // end while
+        }   // end else
+      }
       tensors->SetName(description);
       output->GetCellData()->AddArray(tensors);
       tensors->Delete();
     }
-    else
+    else if (!partOffsets)
     {
       this->IFile->peek();
       if (this->IFile->eof())
@@ -2598,6 +2948,10 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
       }
     }
   }
+  if (!partOffsets)
+  {
+    this->PartOffsets[fileName][timeStep] = newPartOffsets;
+  }
 
   delete this->IFile;
   this->IFile = NULL;
@@ -4268,6 +4622,30 @@ int vtkPEnSightGoldBinaryReader::ReadFloatArray(float* result, int numFloats)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::SkipFloatArrays(int numArrays, int numFloats)
+{
+  if (numFloats <= 0)
+  {
+    return;
+  }
+  const long arraySize = sizeof(float) * static_cast<long>(numFloats) + (this->Fortran ? 8 : 0);
+  this->IFile->seekg(numArrays * arraySize, ios::cur);
+}
+
+//----------------------------------------------------------------------------
+vtkPEnSightGoldBinaryReader::PartOffsetsType* vtkPEnSightGoldBinaryReader::FindPartOffsets(
+  const char* fileName, int timeStep)
+{
+  auto file = this->PartOffsets.find(fileName);
+  if (file == this->PartOffsets.end())
+  {
+    return nullptr;
+  }
+  auto step = file->second.find(timeStep);
+  return step != file->second.end() ? &step->second : nullptr;
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
   vtkPoints* points, long offset, int partId, bool skip)
@@ -4419,6 +4797,26 @@ int vtkPEnSightGoldBinaryReader::InjectCoordinatesAtEnd(
 //----------------------------------------------------------------------------
 void vtkPEnSightGoldBinaryReader::GetVectorFromFloatBuffer(vtkIdType i, float* vector)
 {
+  if (this->FloatBufferMappedData)
+  {
+    // Read the components directly from the mapped file.
+    const vtkIdType componentStride =
+      this->FloatBufferNumberOfVectors * sizeof(float) + (this->Fortran ? 8 : 0);
+    const char* data = this->FloatBufferMappedData + i * sizeof(float);
+    memcpy(vector, data, sizeof(float));
+    memcpy(vector + 1, data + componentStride, sizeof(float));
+    memcpy(vector + 2, data + 2 * componentStride, sizeof(float));
+    if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+    {
+      vtkByteSwap::Swap4LERange(vector, 3);
+    }
+    else
+    {
+      vtkByteSwap::Swap4BERange(vector, 3);
+    }
+    return;
+  }
+
   // We assume FloatBufferIndexBegin, FloatBufferFilePosition, and FloatBufferNumberOfVectors
   // were previously set.
   vtkIdType closestBufferBegin = (i / this->FloatBufferSize) * this->FloatBufferSize;
@@ -4437,6 +4835,21 @@ void vtkPEnSightGoldBinaryReader::GetVectorFromFloatBuffer(vtkIdType i, float* v
 //----------------------------------------------------------------------------
 void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
 {
+  // When the file is mapped in memory, vectors are read from it directly
+  // instead of being buffered.
+  this->FloatBufferMappedData = nullptr;
+  if (auto mapped = dynamic_cast<vtkMappedIStream*>(this->IFile))
+  {
+    const vtkIdType begin = this->FloatBufferFilePosition + (this->Fortran ? 4 : 0);
+    const vtkIdType end = this->FloatBufferFilePosition +
+      3 * (this->FloatBufferNumberOfVectors * sizeof(float) + (this->Fortran ? 8 : 0));
+    if (begin >= 0 && end <= static_cast<vtkIdType>(mapped->GetSize()))
+    {
+      this->FloatBufferMappedData = mapped->GetData() + begin;
+      return;
+    }
+  }
+
   long currentPosition = this->IFile->tellg();
 
   vtkIdType sizeToRead;
@@ -35,6 +35,9 @@
 #include "vtkPEnSightReader.h"
 #include "vtkPVVTKExtensionsIOEnSightModule.h" //needed for exports
 
+#include <utility> // For ivars
+#include <vector>  // For ivars
+
 class vtkMultiBlockDataSet;
 class vtkUnstructuredGrid;
 class vtkPoints;
@@ -50,6 +53,12 @@ protected:
   vtkPEnSightGoldBinaryReader();
   ~vtkPEnSightGoldBinaryReader() override;
 
+  /**
+   * Clears the index of the parts of the per-element variable files before
+   * reading the case file.
+   */
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
   // Returns 1 if successful.  Sets file size as a side action.
   int OpenFile(const char* filename);
 
@@ -222,8 +231,35 @@ protected:
   vtkIdType FloatBufferFilePosition;
   // Total number of vectors;
   vtkIdType FloatBufferNumberOfVectors;
+  // X variable of vector number 0 in the mapped file, when the file is mapped.
+  const char* FloatBufferMappedData;
+
+  /**
+   * Skips `numArrays` consecutive arrays of `numFloats` floats, as read by
+   * ReadFloatArray.
+   */
+  void SkipFloatArrays(int numArrays, int numFloats);
+
+  // Ids and offsets of the parts of a time step of a per-element variable
+  // file, in file order. The offset is the one of the element type or
+  // "block" line following the part id.
+  typedef std::vector<std::pair<int, long> > PartOffsetsType;
+
+  //@{
+  /**
+   * Index of the parts of the per-element variable files, by file name and
+   * time step. It is built the first time a time step is read, and then used
+   * to seek directly to the parts that have cells on this process. It is
+   * cleared whenever the case file is read.
+   * FindPartOffsets returns nullptr if the time step was not indexed yet.
+   */
+  PartOffsetsType* FindPartOffsets(const char* fileName, int timeStep);
+  std::map<std::string, std::map<int, PartOffsetsType> > PartOffsets;
+  //@}
 
 private:
+  class vtkMappedIStream;
+
   vtkPEnSightGoldBinaryReader(const vtkPEnSightGoldBinaryReader&) = delete;
   void operator=(const vtkPEnSightGoldBinaryReader&) = delete;
 };
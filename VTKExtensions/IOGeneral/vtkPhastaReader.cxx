@@ -26,6 +26,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -33,11 +34,20 @@ vtkStandardNewMacro(vtkPhastaReader);
 
 vtkCxxSetObjectMacro(vtkPhastaReader, CachedGrid, vtkUnstructuredGrid);
 
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#ifndef _WIN32
+#include <unistd.h> // for pread
+#endif
+
 struct vtkPhastaReaderInternal
 {
   struct FieldInfo
@@ -62,46 +72,12 @@ struct vtkPhastaReaderInternal
   FieldInfoMapType FieldInfoMap;
 };
 
-// Begin of copy from phastaIO
-
-#define swap_char(A, B)                                                                            \
-  {                                                                                                \
-    ucTmp = A;                                                                                     \
-    A = B;                                                                                         \
-    B = ucTmp;                                                                                     \
-  }
-
-std::map<int, char*> LastHeaderKey;
-std::vector<FILE*> fileArray;
-std::vector<int> byte_order;
-std::vector<int> header_type;
-int DataSize = 0;
-int LastHeaderNotFound = 0;
-int Wrong_Endian = 0;
-int Strict_Error = 0;
-int binary_format = 0;
-
-// the caller has the responsibility to delete the returned string
-char* vtkPhastaReader::StringStripper(const char istring[])
+namespace
 {
-  size_t length = strlen(istring);
-  char* dest = new char[length + 1];
-  strcpy(dest, istring);
-  dest[length] = '\0';
-
-  if (char* p = strpbrk(dest, " "))
-  {
-    *p = '\0';
-  }
-
-  return dest;
-}
-
-int vtkPhastaReader::cscompare(const char teststring[], const char targetstring[])
+int cscompare(const char teststring[], const char targetstring[])
 {
-
-  char* s1 = const_cast<char*>(teststring);
-  char* s2 = const_cast<char*>(targetstring);
+  const char* s1 = teststring;
+  const char* s2 = targetstring;
 
   while (*s1 == ' ')
   {
@@ -134,360 +110,316 @@ int vtkPhastaReader::cscompare(const char teststring[], const char targetstring[
   }
 }
 
-void vtkPhastaReader::isBinary(const char iotype[])
+void SwapArrayByteOrder(void* array, size_t nbytes, size_t nItems)
 {
-  char* fname = StringStripper(iotype);
-  if (cscompare(fname, "binary"))
-  {
-    binary_format = 1;
-  }
-  else
+  /* This swaps the byte order for the array of nItems each
+     of size nbytes */
+  unsigned char* ucDst = static_cast<unsigned char*>(array);
+  for (size_t i = 0; i < nItems; i++)
   {
-    binary_format = 0;
+    std::reverse(ucDst, ucDst + nbytes);
+    ucDst += nbytes;
   }
-  delete[] fname;
 }
 
-size_t vtkPhastaReader::typeSize(const char typestring[])
+//----------------------------------------------------------------------------
+/**
+ * A binary PHASTA file opened for reading.
+ *
+ * All headers are indexed when the file is opened, so that looking up a
+ * keyphrase does not rescan the file and data blocks are read with
+ * positional I/O. Once opened, ReadBlock can be called concurrently.
+ */
+class vtkPhastaReaderFile
 {
-  char* ts1 = StringStripper(typestring);
-
-  if (cscompare("integer", ts1))
+public:
+  struct Header
   {
-    delete[] ts1;
-    return sizeof(int);
-  }
-  else if (cscompare("double", ts1))
-  {
-    delete[] ts1;
-    return sizeof(double);
-  }
-  else if (cscompare("float", ts1))
-  {
-    delete[] ts1;
-    return sizeof(float);
-  }
-  else
+    std::string Key;
+    std::vector<int> Values;
+    vtkTypeInt64 DataOffset;
+    vtkTypeInt64 DataSize;
+  };
+
+  vtkPhastaReaderFile()
+    : File(nullptr)
+    , NextHeader(0)
+    , WrongEndian(false)
   {
-    vtkGenericWarningMacro(<< "unknown type : " << ts1 << endl);
-    delete[] ts1;
-    return 0;
   }
-}
+  ~vtkPhastaReaderFile() { this->Close(); }
+
+  bool Open(const char* filename);
+  void Close();
+
+  /**
+   * Returns the next header matching `keyphrase`, searching from the header
+   * following the last one found and wrapping around, like the sequential
+   * reads of phastaIO did. Returns nullptr if not found.
+   */
+  const Header* FindHeader(const char* keyphrase);
+
+  /**
+   * Reads `count` items of `itemSize` bytes, `offset` bytes into the data
+   * block of `header`, and fixes their byte order.
+   */
+  bool ReadBlock(
+    const Header* header, vtkTypeInt64 offset, void* buffer, size_t itemSize, size_t count);
+
+private:
+  vtkPhastaReaderFile(const vtkPhastaReaderFile&) = delete;
+  void operator=(const vtkPhastaReaderFile&) = delete;
+
+  bool BuildIndex();
+
+  FILE* File;
+  std::vector<Header> Headers;
+  size_t NextHeader;
+  bool WrongEndian;
+#ifdef _WIN32
+  std::mutex ReadMutex; // no positional reads on FILE, seek and read atomically
+#endif
+};
 
-namespace
+//----------------------------------------------------------------------------
+inline vtkTypeInt64 vtkPhastaTell(FILE* file)
 {
-void xfgets(char* str, int num, FILE* stream)
-{
-  if (fgets(str, num, stream) == NULL)
-  {
-    vtkGenericWarningMacro(<< "Could not read or end of file" << endl);
-  }
+#ifdef _WIN32
+  return _ftelli64(file);
+#else
+  return static_cast<vtkTypeInt64>(ftello(file));
+#endif
 }
 
-void xfread(void* ptr, size_t size, size_t count, FILE* stream)
+//----------------------------------------------------------------------------
+inline int vtkPhastaSeek(FILE* file, vtkTypeInt64 offset, int whence)
 {
-  if (fread(ptr, size, count, stream) != count)
-  {
-    vtkGenericWarningMacro(<< "Could not read or end of file" << endl);
-  }
+#ifdef _WIN32
+  return _fseeki64(file, offset, whence);
+#else
+  return fseeko(file, static_cast<off_t>(offset), whence);
+#endif
 }
 
-template <typename... Args>
-void xfscanf(FILE* stream, const char* format, Args... args)
+//----------------------------------------------------------------------------
+bool vtkPhastaReaderFile::Open(const char* filename)
 {
-  int ret = fscanf(stream, format, args...);
-  (void)ret;
-}
+  this->Close();
+  // Stripping a filename is not correct, since
+  // filenames can certainly have spaces.
+  this->File = fopen(filename, "rb");
+  if (!this->File)
+  {
+    vtkGenericWarningMacro(<< "unable to open file : " << filename << endl);
+    return false;
+  }
+  return this->BuildIndex();
 }
 
-int vtkPhastaReader::readHeader(FILE* fileObject, const char phrase[], int* params, int expect)
+//----------------------------------------------------------------------------
+void vtkPhastaReaderFile::Close()
 {
-  char* text_header;
-  char* token;
-  char Line[1024];
-  char junk;
-  int FOUND = 0;
-  size_t real_length;
-  int skip_size, integer_value;
-  int rewind_count = 0;
-
-  if (!fgets(Line, 1024, fileObject) && feof(fileObject))
+  if (this->File)
   {
-    rewind(fileObject);
-    clearerr(fileObject);
-    rewind_count++;
-
-    xfgets(Line, 1024, fileObject);
+    fclose(this->File);
+    this->File = nullptr;
   }
+  this->Headers.clear();
+  this->NextHeader = 0;
+  this->WrongEndian = false;
+}
 
-  while (!FOUND && (rewind_count < 2))
+//----------------------------------------------------------------------------
+bool vtkPhastaReaderFile::BuildIndex()
+{
+  char line[1024];
+  while (fgets(line, sizeof(line), this->File))
   {
-    if ((Line[0] != '\n') && (real_length = strcspn(Line, "#")))
+    const size_t length = strcspn(line, "#");
+    if (line[0] == '\n' || length == 0)
     {
-      text_header = new char[real_length + 1];
-      strncpy(text_header, Line, real_length);
-      text_header[real_length] = static_cast<char>(NULL);
-      token = strtok(text_header, ":");
-      if (cscompare(phrase, token))
-      {
-        FOUND = 1;
-        token = strtok(NULL, " ,;<>");
-        skip_size = atoi(token);
-        int i;
-        for (i = 0; i < expect && (token = strtok(NULL, " ,;<>")); i++)
-        {
-          params[i] = atoi(token);
-        }
-        if (i < expect)
-        {
-          vtkGenericWarningMacro(<< "Expected # of ints not found for: " << phrase << endl);
-        }
-      }
-      else if (cscompare(token, "byteorder magic number"))
-      {
-        if (binary_format)
-        {
-          xfread((void*)&integer_value, sizeof(int), 1, fileObject);
-          xfread(&junk, sizeof(char), 1, fileObject);
-          if (362436 != integer_value)
-          {
-            Wrong_Endian = 1;
-          }
-        }
-        else
-        {
-          xfscanf(fileObject, "%d\n", &integer_value);
-        }
-      }
-      else
-      {
-        /* some other header, so just skip over */
-        token = strtok(NULL, " ,;<>");
-        skip_size = atoi(token);
-        if (binary_format)
-        {
-          fseek(fileObject, skip_size, SEEK_CUR);
-        }
-        else
-        {
-          for (int gama = 0; gama < skip_size; gama++)
-          {
-            xfgets(Line, 1024, fileObject);
-          }
-        }
-      }
-      delete[] text_header;
+      continue;
     }
+    std::string text(line, length);
+    char* token = strtok(&text[0], ":");
+    if (!token)
+    {
+      continue;
+    }
+    Header header;
+    header.Key = token;
+    token = strtok(nullptr, " ,;<>");
+    header.DataSize = token ? atoi(token) : 0;
+    while ((token = strtok(nullptr, " ,;<>")) != nullptr)
+    {
+      header.Values.push_back(atoi(token));
+    }
+    header.DataOffset = vtkPhastaTell(this->File);
 
-    if (!FOUND)
+    if (cscompare(header.Key.c_str(), "byteorder magic number"))
     {
-      if (!fgets(Line, 1024, fileObject) && feof(fileObject))
+      int magic = 0;
+      if (fread(&magic, sizeof(int), 1, this->File) == 1 && magic != 362436)
       {
-        rewind(fileObject);
-        clearerr(fileObject);
-        rewind_count++;
-        xfgets(Line, 1024, fileObject);
+        this->WrongEndian = true;
       }
     }
+    else
+    {
+      this->Headers.push_back(header);
+    }
+    if (vtkPhastaSeek(this->File, header.DataOffset + header.DataSize, SEEK_SET) != 0)
+    {
+      break;
+    }
   }
-
-  if (!FOUND)
-  {
-    vtkGenericWarningMacro(<< "Could not find: " << phrase << endl);
-    return 1;
-  }
-  return 0;
+  clearerr(this->File);
+  return true;
 }
 
-void vtkPhastaReader::SwapArrayByteOrder(void* array, int nbytes, int nItems)
+//----------------------------------------------------------------------------
+const vtkPhastaReaderFile::Header* vtkPhastaReaderFile::FindHeader(const char* keyphrase)
 {
-  /* This swaps the byte order for the array of nItems each
-     of size nbytes , This will be called only locally  */
-  int i, j;
-  unsigned char ucTmp;
-  unsigned char* ucDst = (unsigned char*)array;
-
-  for (i = 0; i < nItems; i++)
+  const size_t numHeaders = this->Headers.size();
+  for (size_t cc = 0; cc < numHeaders; ++cc)
   {
-    for (j = 0; j < (nbytes / 2); j++)
+    const size_t index = (this->NextHeader + cc) % numHeaders;
+    if (cscompare(keyphrase, this->Headers[index].Key.c_str()))
     {
-      swap_char(ucDst[j], ucDst[(nbytes - 1) - j]);
+      this->NextHeader = index + 1;
+      return &this->Headers[index];
     }
-    ucDst += nbytes;
   }
+  vtkGenericWarningMacro(<< "Could not find: " << keyphrase << endl);
+  return nullptr;
 }
 
-void vtkPhastaReader::openfile(const char filename[], const char mode[], int* fileDescriptor)
+//----------------------------------------------------------------------------
+bool vtkPhastaReaderFile::ReadBlock(
+  const Header* header, vtkTypeInt64 offset, void* buffer, size_t itemSize, size_t count)
 {
-  FILE* file = NULL;
-  *fileDescriptor = 0;
-  // Stripping a filename is not correct, since
-  // filenames can certainly have spaces.
-  // char* fname = StringStripper( filename );
-  const char* fname = filename;
-  char* imode = StringStripper(mode);
-
-  if (cscompare("read", imode))
+  const size_t numBytes = itemSize * count;
+  if (!header || offset < 0 ||
+    offset + static_cast<vtkTypeInt64>(numBytes) > header->DataSize)
   {
-    file = fopen(fname, "rb");
+    vtkGenericWarningMacro(<< "Data block too small for the requested values" << endl);
+    return false;
   }
-  else if (cscompare("write", imode))
+  const vtkTypeInt64 position = header->DataOffset + offset;
+
+#ifdef _WIN32
+  std::lock_guard<std::mutex> lock(this->ReadMutex);
+  bool success = vtkPhastaSeek(this->File, position, SEEK_SET) == 0 &&
+    fread(buffer, 1, numBytes, this->File) == numBytes;
+#else
+  // pread does not move the file offset, so concurrent reads are safe.
+  char* dest = static_cast<char*>(buffer);
+  size_t done = 0;
+  const int fd = fileno(this->File);
+  while (done < numBytes)
   {
-    file = fopen(fname, "wb");
-  }
-  else if (cscompare("append", imode))
-  {
-    file = fopen(fname, "ab");
+    const ssize_t nread =
+      pread(fd, dest + done, numBytes - done, static_cast<off_t>(position + done));
+    if (nread <= 0)
+    {
+      break;
+    }
+    done += static_cast<size_t>(nread);
   }
+  bool success = done == numBytes;
+#endif
 
-  if (!file)
+  if (!success)
   {
-    vtkGenericWarningMacro(<< "unable to open file : " << fname << endl);
+    vtkGenericWarningMacro(<< "Could not read or end of file" << endl);
+    return false;
   }
-  else
+  if (this->WrongEndian)
   {
-    fileArray.push_back(file);
-    byte_order.push_back(0);
-    header_type.push_back(sizeof(int));
-    *fileDescriptor = static_cast<int>(fileArray.size());
+    SwapArrayByteOrder(buffer, itemSize, count);
   }
-  delete[] imode;
+  return true;
 }
 
-void vtkPhastaReader::closefile(int* fileDescriptor, const char mode[])
+//----------------------------------------------------------------------------
+// Looks up the next `keyphrase` header and copies its first `expect` values
+// into `params`.
+const vtkPhastaReaderFile::Header* ReadHeader(
+  vtkPhastaReaderFile& file, const char* keyphrase, int* params, int expect)
 {
-  char* imode = StringStripper(mode);
-
-  if (cscompare("write", imode) || cscompare("append", imode))
+  const vtkPhastaReaderFile::Header* header = file.FindHeader(keyphrase);
+  if (header)
   {
-    fflush(fileArray[*fileDescriptor - 1]);
+    const int available = static_cast<int>(header->Values.size());
+    if (available < expect)
+    {
+      vtkGenericWarningMacro(<< "Expected # of ints not found for: " << keyphrase << endl);
+    }
+    std::copy_n(header->Values.begin(), std::min(available, expect), params);
   }
-
-  fclose(fileArray[*fileDescriptor - 1]);
-  delete[] imode;
+  return header;
 }
 
-void vtkPhastaReader::readheader(int* fileDescriptor, const char keyphrase[], void* valueArray,
-  int* nItems, const char datatype[], const char iotype[])
+//----------------------------------------------------------------------------
+// A field of the field file, read and converted concurrently with the others.
+struct vtkPhastaFieldRead
 {
-  int filePtr = *fileDescriptor - 1;
-  FILE* fileObject;
-  int* valueListInt;
-
-  if (*fileDescriptor < 1 || *fileDescriptor > (int)fileArray.size())
-  {
-    vtkGenericWarningMacro(<< "No file associated with Descriptor " << *fileDescriptor << "\n"
-                           << "openfile function has to be called before \n"
-                           << "accessing the file\n "
-                           << "fatal error: cannot continue, returning out of call\n");
-    return;
-  }
-
-  LastHeaderKey[filePtr] = const_cast<char*>(keyphrase);
-  LastHeaderNotFound = 0;
-
-  fileObject = fileArray[filePtr];
-  Wrong_Endian = byte_order[filePtr];
-
-  isBinary(iotype);
-  typeSize(datatype); // redundant call, just avoid a compiler warning.
-
-  // right now we are making the assumption that we will only write integers
-  // on the header line.
-
-  valueListInt = static_cast<int*>(valueArray);
-  int ierr = readHeader(fileObject, keyphrase, valueListInt, *nItems);
-
-  byte_order[filePtr] = Wrong_Endian;
-
-  if (ierr)
-  {
-    LastHeaderNotFound = 1;
-  }
-
-  return;
-}
+  const vtkPhastaReaderFile::Header* Header;
+  vtkDataArray* Array;
+  int Index;
+  bool Success;
+};
 
-void vtkPhastaReader::readdatablock(int* fileDescriptor, const char keyphrase[], void* valueArray,
-  int* nItems, const char datatype[], const char iotype[])
+template <typename ValueType>
+bool ReadField(vtkPhastaReaderFile& file, const vtkPhastaFieldRead& field,
+  vtkAOSDataArrayTemplate<ValueType>* array)
 {
-  int filePtr = *fileDescriptor - 1;
-  FILE* fileObject;
-  char junk;
-
-  if (*fileDescriptor < 1 || *fileDescriptor > (int)fileArray.size())
+  // Variables are stored one after the other, only read the requested ones.
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  const int numComps = array->GetNumberOfComponents();
+  std::vector<ValueType> data(static_cast<size_t>(numTuples) * numComps);
+  const vtkTypeInt64 offset =
+    static_cast<vtkTypeInt64>(field.Index) * numTuples * sizeof(ValueType);
+  if (!file.ReadBlock(field.Header, offset, data.data(), sizeof(ValueType), data.size()))
   {
-    vtkGenericWarningMacro(<< "No file associated with Descriptor " << *fileDescriptor << "\n"
-                           << "openfile function has to be called before \n"
-                           << "accessing the file\n "
-                           << "fatal error: cannot continue, returning out of call\n");
-    return;
+    return false;
   }
-
-  // error check..
-  // since we require that a consistent header always precede the data block
-  // let us check to see that it is actually the case.
-
-  if (!cscompare(LastHeaderKey[filePtr], keyphrase))
+  ValueType* out = array->GetPointer(0);
+  for (int comp = 0; comp < numComps; ++comp)
   {
-    vtkGenericWarningMacro(<< "Header not consistent with data block\n"
-                           << "Header: " << LastHeaderKey[filePtr] << "\n"
-                           << "DataBlock: " << keyphrase << "\n"
-                           << "Please recheck read sequence \n");
-    if (Strict_Error)
+    const ValueType* in = &data[static_cast<size_t>(comp) * numTuples];
+    for (vtkIdType i = 0; i < numTuples; ++i)
     {
-      vtkGenericWarningMacro(<< "fatal error: cannot continue, returning out of call\n");
-      return;
+      out[i * numComps + comp] = in[i];
     }
   }
+  return true;
+}
 
-  if (LastHeaderNotFound)
-  {
-    return;
-  }
-
-  fileObject = fileArray[filePtr];
-  Wrong_Endian = byte_order[filePtr];
-
-  size_t type_size = typeSize(datatype);
-  int nUnits = *nItems;
-  isBinary(iotype);
+class vtkPhastaReadFieldsFunctor
+{
+public:
+  vtkPhastaReaderFile* File;
+  std::vector<vtkPhastaFieldRead>* Fields;
 
-  if (binary_format)
-  {
-    xfread(valueArray, type_size, nUnits, fileObject);
-    xfread(&junk, sizeof(char), 1, fileObject);
-    if (Wrong_Endian)
-    {
-      SwapArrayByteOrder(valueArray, static_cast<int>(type_size), nUnits);
-    }
-  }
-  else
+  void operator()(vtkIdType begin, vtkIdType end)
   {
-    char* ts1 = StringStripper(datatype);
-    if (cscompare("integer", ts1))
+    for (vtkIdType cc = begin; cc < end; ++cc)
     {
-      for (int n = 0; n < nUnits; n++)
+      vtkPhastaFieldRead& field = (*this->Fields)[cc];
+      if (vtkDoubleArray* doubles = vtkDoubleArray::SafeDownCast(field.Array))
       {
-        xfscanf(fileObject, "%d\n", (int*)((int*)valueArray + n));
+        field.Success = ReadField(*this->File, field, doubles);
       }
-    }
-    else if (cscompare("double", ts1))
-    {
-      for (int n = 0; n < nUnits; n++)
+      else if (vtkFloatArray* floats = vtkFloatArray::SafeDownCast(field.Array))
       {
-        xfscanf(fileObject, "%lf\n", (double*)((double*)valueArray + n));
+        field.Success = ReadField(*this->File, field, floats);
       }
     }
-    delete[] ts1;
   }
-
-  return;
+};
 }
 
-// End of copy from phastaIO
-
 vtkPhastaReader::vtkPhastaReader()
 {
   this->GeometryFileName = NULL;
@@ -641,33 +573,30 @@ void vtkPhastaReader::ReadGeomFile(
 
   /* misc variables*/
   int i, j, k, item;
-  int geomfile;
+  vtkPhastaReaderFile geomfile;
 
-  openfile(geomFileName, "read", &geomfile);
-  // geomfile = fopen(GeometryFileName,"rb");
-
-  if (!geomfile)
+  if (!geomfile.Open(geomFileName))
   {
     vtkErrorMacro(<< "Cannot open file " << geomFileName);
     return;
   }
 
   int expect;
-  int array[10];
+  int array[10] = { 0 };
   expect = 1;
 
   /* read number of nodes */
 
-  readheader(&geomfile, "number of nodes", array, &expect, "integer", "binary");
+  ReadHeader(geomfile, "number of nodes", array, expect);
   num_nodes = array[0];
 
   /* read number of elements */
-  readheader(&geomfile, "number of interior elements", array, &expect, "integer", "binary");
+  ReadHeader(geomfile, "number of interior elements", array, expect);
   num_elems = array[0];
   num_cells = array[0];
 
   /* read number of interior */
-  readheader(&geomfile, "number of interior tpblocks", array, &expect, "integer", "binary");
+  ReadHeader(geomfile, "number of interior tpblocks", array, expect);
   num_int_blocks = array[0];
 
   vtkDebugMacro(<< "Nodes: " << num_nodes << "Elements: " << num_elems
@@ -675,7 +604,13 @@ void vtkPhastaReader::ReadGeomFile(
 
   /* read coordinates */
   expect = 2;
-  readheader(&geomfile, "co-ordinates", array, &expect, "double", "binary");
+  const vtkPhastaReaderFile::Header* coordsHeader =
+    ReadHeader(geomfile, "co-ordinates", array, expect);
+  if (!coordsHeader)
+  {
+    vtkErrorMacro(<< "No co-ordinates in " << geomFileName);
+    return;
+  }
   // TEST *******************
   num_nodes = array[0];
   // TEST *******************
@@ -706,7 +641,13 @@ void vtkPhastaReader::ReadGeomFile(
   }
 
   item = num_nodes * dim;
-  readdatablock(&geomfile, "co-ordinates", pos, &item, "double", "binary");
+  if (!geomfile.ReadBlock(coordsHeader, 0, pos, sizeof(double), item))
+  {
+    vtkErrorMacro(<< "Unable to read co-ordinates from " << geomFileName);
+    delete[] coordinates;
+    delete[] pos;
+    return;
+  }
 
   for (i = 0; i < num_nodes; i++)
   {
@@ -736,12 +677,19 @@ void vtkPhastaReader::ReadGeomFile(
 
   for (k = 0; k < num_int_blocks; k++)
   {
-    readheader(&geomfile, "connectivity interior", array, &expect, "integer", "binary");
+    const vtkPhastaReaderFile::Header* connectivityHeader =
+      ReadHeader(geomfile, "connectivity interior", array, expect);
+    if (!connectivityHeader)
+    {
+      vtkErrorMacro(<< "Missing connectivity block in " << geomFileName);
+      break;
+    }
 
     /* read information about the block*/
     num_elems = array[0];
     num_vertices = array[1];
     num_per_line = array[3];
+    delete[] connectivity;
     connectivity = new int[num_elems * num_per_line];
 
     if (connectivity == NULL)
@@ -751,7 +699,11 @@ void vtkPhastaReader::ReadGeomFile(
     }
 
     item = num_elems * num_per_line;
-    readdatablock(&geomfile, "connectivity interior", connectivity, &item, "integer", "binary");
+    if (!geomfile.ReadBlock(connectivityHeader, 0, connectivity, sizeof(int), item))
+    {
+      vtkErrorMacro(<< "Unable to read connectivity from " << geomFileName);
+      break;
+    }
 
     /* insert cells */
     for (i = 0; i < num_elems; i++)
@@ -798,7 +750,6 @@ void vtkPhastaReader::ReadGeomFile(
   firstVertexNo = firstVertexNo + num_nodes;
 
   // clean up
-  closefile(&geomfile, "read");
   delete[] coordinates;
   delete[] pos;
   delete[] connectivity;
@@ -811,17 +762,14 @@ void vtkPhastaReader::ReadFieldFile(
   int i, j;
   int item;
   double* data;
-  int fieldfile;
+  vtkPhastaReaderFile fieldfile;
 
-  openfile(fieldFileName, "read", &fieldfile);
-  // fieldfile = fopen(FieldFileName,"rb");
-
-  if (!fieldfile)
+  if (!fieldfile.Open(fieldFileName))
   {
     vtkErrorMacro(<< "Cannot open file " << FieldFileName);
     return;
   }
-  int array[10], expect;
+  int array[10] = { 0 }, expect;
 
   /* read the solution */
   vtkDoubleArray* pressure = vtkDoubleArray::New();
@@ -833,7 +781,16 @@ void vtkPhastaReader::ReadFieldFile(
   temperature->SetName("temperature");
 
   expect = 3;
-  readheader(&fieldfile, "solution", array, &expect, "double", "binary");
+  const vtkPhastaReaderFile::Header* solutionHeader =
+    ReadHeader(fieldfile, "solution", array, expect);
+  if (!solutionHeader)
+  {
+    vtkErrorMacro(<< "No solution in " << fieldFileName);
+    pressure->Delete();
+    velocity->Delete();
+    temperature->Delete();
+    return;
+  }
   noOfNodes = array[0];
   this->NumberOfVariables = array[1];
 
@@ -847,10 +804,21 @@ void vtkPhastaReader::ReadFieldFile(
   if (data == NULL)
   {
     vtkErrorMacro(<< "Unable to allocate memory for field info");
+    pressure->Delete();
+    velocity->Delete();
+    temperature->Delete();
     return;
   }
 
-  readdatablock(&fieldfile, "solution", data, &item, "double", "binary");
+  if (!fieldfile.ReadBlock(solutionHeader, 0, data, sizeof(double), item))
+  {
+    vtkErrorMacro(<< "Unable to read solution from " << fieldFileName);
+    delete[] data;
+    pressure->Delete();
+    velocity->Delete();
+    temperature->Delete();
+    return;
+  }
 
   for (i = 5; i < this->NumberOfVariables; i++)
   {
@@ -893,7 +861,6 @@ void vtkPhastaReader::ReadFieldFile(
   }
 
   // clean up
-  closefile(&fieldfile, "read");
   delete[] data;
 
 } // closes ReadFieldFile
@@ -901,23 +868,22 @@ void vtkPhastaReader::ReadFieldFile(
 void vtkPhastaReader::ReadFieldFile(
   char* fieldFileName, int, vtkUnstructuredGrid* output, int& noOfDatas)
 {
+  int numOfVars;
+  vtkPhastaReaderFile fieldfile;
 
-  int i, j, numOfVars;
-  int item;
-  int fieldfile;
-
-  openfile(fieldFileName, "read", &fieldfile);
-  // fieldfile = fopen(FieldFileName,"rb");
-
-  if (!fieldfile)
+  if (!fieldfile.Open(fieldFileName))
   {
     vtkErrorMacro(<< "Cannot open file " << FieldFileName);
     return;
   }
-  int array[10], expect;
+  int array[10] = { 0 }, expect;
 
   int activeScalars = 0, activeTensors = 0;
 
+  // Look up and validate all the fields first, then read them concurrently.
+  std::vector<vtkPhastaFieldRead> fields;
+  std::vector<vtkDataSetAttributes*> fieldAttributes;
+
   vtkPhastaReaderInternal::FieldInfoMapType::iterator it = this->Internal->FieldInfoMap.begin();
   vtkPhastaReaderInternal::FieldInfoMapType::iterator itend = this->Internal->FieldInfoMap.end();
   for (; it != itend; it++)
@@ -935,19 +901,15 @@ void vtkPhastaReader::ReadFieldFile(
     else
       field = output->GetPointData();
 
-    // void *data;
-    int dtype; // (0=double, 1=float)
     vtkDataArray* dataArray;
     /* read the field data */
     if (strcmp(dataType, "double") == 0)
     {
       dataArray = vtkDoubleArray::New();
-      dtype = 0;
     }
     else if (strcmp(dataType, "float") == 0)
     {
       dataArray = vtkFloatArray::New();
-      dtype = 1;
     }
     else
     {
@@ -959,7 +921,14 @@ void vtkPhastaReader::ReadFieldFile(
     dataArray->SetNumberOfComponents(numOfComps);
 
     expect = 3;
-    readheader(&fieldfile, phastaFieldTag, array, &expect, dataType, "binary");
+    const vtkPhastaReaderFile::Header* header =
+      ReadHeader(fieldfile, phastaFieldTag, array, expect);
+    if (!header)
+    {
+      vtkErrorMacro("Field [phasta field tag:" << phastaFieldTag << "] not found");
+      dataArray->Delete();
+      continue;
+    }
     noOfDatas = array[0];
     this->NumberOfVariables = array[1];
     numOfVars = array[1];
@@ -986,197 +955,63 @@ void vtkPhastaReader::ReadFieldFile(
       continue;
     }
 
-    item = numOfVars * noOfDatas;
-    if (dtype == 0)
-    { // data is type double
-
-      double* data;
-      data = new double[item];
-
-      if (data == NULL)
-      {
-        vtkErrorMacro(<< "Unable to allocate memory for field info");
-
-        dataArray->Delete();
-        continue;
-      }
-
-      readdatablock(&fieldfile, phastaFieldTag, data, &item, dataType, "binary");
-
-      switch (numOfComps)
-      {
-        case 1:
-        {
-          int offset = index * noOfDatas;
-
-          if (!activeScalars)
-            field->SetActiveScalars(paraviewFieldTag);
-          else
-            activeScalars = 1;
-          for (i = 0; i < noOfDatas; i++)
-          {
-            dataArray->SetTuple1(i, data[offset + i]);
-          }
-        }
+    switch (numOfComps)
+    {
+      case 1:
+        if (!activeScalars)
+          field->SetActiveScalars(paraviewFieldTag);
+        else
+          activeScalars = 1;
         break;
-        case 3:
-        {
-          int offset[3];
-          for (j = 0; j < 3; j++)
-            offset[j] = (index + j) * noOfDatas;
-
-          if (!activeScalars)
-            field->SetActiveVectors(paraviewFieldTag);
-          else
-            activeScalars = 1;
-          for (i = 0; i < noOfDatas; i++)
-          {
-            dataArray->SetTuple3(i, data[offset[0] + i], data[offset[1] + i], data[offset[2] + i]);
-          }
-        }
+      case 3:
+        if (!activeScalars)
+          field->SetActiveVectors(paraviewFieldTag);
+        else
+          activeScalars = 1;
         break;
-        case 9:
-        {
-          int offset[9];
-          for (j = 0; j < 9; j++)
-            offset[j] = (index + j) * noOfDatas;
-
-          if (!activeTensors)
-            field->SetActiveTensors(paraviewFieldTag);
-          else
-            activeTensors = 1;
-          for (i = 0; i < noOfDatas; i++)
-          {
-            dataArray->SetTuple9(i, data[offset[0] + i], data[offset[1] + i], data[offset[2] + i],
-              data[offset[3] + i], data[offset[4] + i], data[offset[5] + i], data[offset[6] + i],
-              data[offset[7] + i], data[offset[8] + i]);
-          }
-        }
+      case 9:
+        if (!activeTensors)
+          field->SetActiveTensors(paraviewFieldTag);
+        else
+          activeTensors = 1;
         break;
-        default:
-          vtkErrorMacro("number of components [" << numOfComps << "] NOT supported");
-
-          dataArray->Delete();
-          delete[] data;
-          continue;
-      }
-
-      // clean up
-      delete[] data;
-    }
-    else if (dtype == 1)
-    { // data is type float
-
-      float* data;
-      data = new float[item];
-
-      if (data == NULL)
-      {
-        vtkErrorMacro(<< "Unable to allocate memory for field info");
+      default:
+        vtkErrorMacro("number of components [" << numOfComps << "] NOT supported");
 
         dataArray->Delete();
         continue;
-      }
-
-      readdatablock(&fieldfile, phastaFieldTag, data, &item, dataType, "binary");
+    }
 
-      switch (numOfComps)
-      {
-        case 1:
-        {
-          int offset = index * noOfDatas;
-
-          if (!activeScalars)
-            field->SetActiveScalars(paraviewFieldTag);
-          else
-            activeScalars = 1;
-          for (i = 0; i < noOfDatas; i++)
-          {
-            // double tmpval = (double) data[offset+i];
-            // dataArray->SetTuple1(i, tmpval);
-            dataArray->SetTuple1(i, data[offset + i]);
-          }
-        }
-        break;
-        case 3:
-        {
-          int offset[3];
-          for (j = 0; j < 3; j++)
-            offset[j] = (index + j) * noOfDatas;
-
-          if (!activeScalars)
-            field->SetActiveVectors(paraviewFieldTag);
-          else
-            activeScalars = 1;
-          for (i = 0; i < noOfDatas; i++)
-          {
-            // double tmpval[3];
-            // for(j=0;j<3;j++)
-            //   tmpval[j] = (double) data[offset[j]+i];
-            // dataArray->SetTuple3(i,
-            //                    tmpval[0], tmpval[1], tmpval[3]);
-            dataArray->SetTuple3(i, data[offset[0] + i], data[offset[1] + i], data[offset[2] + i]);
-          }
-        }
-        break;
-        case 9:
-        {
-          int offset[9];
-          for (j = 0; j < 9; j++)
-            offset[j] = (index + j) * noOfDatas;
-
-          if (!activeTensors)
-            field->SetActiveTensors(paraviewFieldTag);
-          else
-            activeTensors = 1;
-          for (i = 0; i < noOfDatas; i++)
-          {
-            // double tmpval[9];
-            // for(j=0;j<9;j++)
-            //   tmpval[j] = (double) data[offset[j]+i];
-            // dataArray->SetTuple9(i,
-            //                     tmpval[0],
-            //                     tmpval[1],
-            //                     tmpval[2],
-            //                     tmpval[3],
-            //                     tmpval[4],
-            //                     tmpval[5],
-            //                     tmpval[6],
-            //                     tmpval[7],
-            //                     tmpval[8]);
-            dataArray->SetTuple9(i, data[offset[0] + i], data[offset[1] + i], data[offset[2] + i],
-              data[offset[3] + i], data[offset[4] + i], data[offset[5] + i], data[offset[6] + i],
-              data[offset[7] + i], data[offset[8] + i]);
-          }
-        }
-        break;
-        default:
-          vtkErrorMacro("number of components [" << numOfComps << "] NOT supported");
+    vtkPhastaFieldRead fieldRead;
+    fieldRead.Header = header;
+    fieldRead.Array = dataArray;
+    fieldRead.Index = index;
+    fieldRead.Success = false;
+    fields.push_back(fieldRead);
+    fieldAttributes.push_back(field);
+  }
 
-          dataArray->Delete();
-          delete[] data;
-          continue;
-      }
+  vtkPhastaReadFieldsFunctor reader;
+  reader.File = &fieldfile;
+  reader.Fields = &fields;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(fields.size()), 1, reader);
 
-      // clean up
-      delete[] data;
+  for (size_t cc = 0; cc < fields.size(); ++cc)
+  {
+    vtkDataArray* dataArray = fields[cc].Array;
+    if (fields[cc].Success)
+    {
+      fieldAttributes[cc]->AddArray(dataArray);
     }
     else
     {
-      vtkErrorMacro("Data type [" << dataType << "] NOT supported");
-      continue;
+      vtkErrorMacro(<< "Unable to read field [paraview field tag:" << dataArray->GetName()
+                    << "] from " << fieldFileName);
     }
 
-    field->AddArray(dataArray);
-
     // clean up
     dataArray->Delete();
-    // delete [] data;
   }
-
-  // close up
-  closefile(&fieldfile, "read");
-
 } // closes ReadFieldFile
 
 void vtkPhastaReader::PrintSelf(ostream& os, vtkIndent indent)
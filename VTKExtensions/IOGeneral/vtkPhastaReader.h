@@ -91,19 +91,6 @@ private:
 
   int NumberOfVariables; // number of variable in the field file
 
-  static char* StringStripper(const char istring[]);
-  static int cscompare(const char teststring[], const char targetstring[]);
-  static void isBinary(const char iotype[]);
-  static size_t typeSize(const char typestring[]);
-  static int readHeader(FILE* fileObject, const char phrase[], int* params, int expect);
-  static void SwapArrayByteOrder(void* array, int nbytes, int nItems);
-  static void openfile(const char filename[], const char mode[], int* fileDescriptor);
-  static void closefile(int* fileDescriptor, const char mode[]);
-  static void readheader(int* fileDescriptor, const char keyphrase[], void* valueArray, int* nItems,
-    const char datatype[], const char iotype[]);
-  static void readdatablock(int* fileDescriptor, const char keyphrase[], void* valueArray,
-    int* nItems, const char datatype[], const char iotype[]);
-
 private:
   vtkPhastaReaderInternal* Internal;
 
@@ -14,13 +14,232 @@
 =========================================================================*/
 #include "vtkRawImageFileSeriesReader.h"
 
-#include "vtkImageReader2.h"
+#include "vtkByteSwap.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageReader.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#include "vtksys/Encoding.hxx"
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Copy-on-write memory mapping of a byte range of a file. Pages are only read
+// from disk when accessed, and writing to the mapping never modifies the file.
+class vtkRawImageMappedRegion
+{
+public:
+  vtkRawImageMappedRegion() = default;
+  ~vtkRawImageMappedRegion() { vtkRawImageMappedRegion::Unmap(this->Base, this->Length); }
+
+  bool Map(const char* filename, vtkTypeInt64 offset, vtkTypeInt64 length)
+  {
+    if (offset < 0 || length <= 0)
+    {
+      return false;
+    }
+#ifdef _WIN32
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWide(filename).c_str(), GENERIC_READ,
+      FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < offset + length)
+    {
+      CloseHandle(file);
+      return false;
+    }
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const vtkTypeInt64 start = offset - offset % info.dwAllocationGranularity;
+    const size_t size = static_cast<size_t>(offset + length - start);
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+      return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_COPY, static_cast<DWORD>(start >> 32),
+      static_cast<DWORD>(start & 0xffffffff), size);
+    CloseHandle(mapping);
+    if (data == nullptr)
+    {
+      return false;
+    }
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < offset + length)
+    {
+      close(fd);
+      return false;
+    }
+    const vtkTypeInt64 pageSize = sysconf(_SC_PAGESIZE);
+    const vtkTypeInt64 start = offset - offset % pageSize;
+    const size_t size = static_cast<size_t>(offset + length - start);
+    void* data =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(start));
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+      return false;
+    }
+#endif
+    this->Base = static_cast<char*>(data);
+    this->Length = size;
+    this->Data = this->Base + (offset - start);
+    return true;
+  }
+
+  // Pointer to the first byte of the requested range.
+  char* GetData() const { return this->Data; }
+
+  // Transfers the ownership of the mapping to a data array that references
+  // it. The mapping is released when the array frees its memory.
+  void TransferTo(vtkDataArray* array, vtkIdType numberOfValues);
+
+  static void Unmap(char* base, size_t length)
+  {
+    if (base)
+    {
+#ifdef _WIN32
+      (void)length;
+      UnmapViewOfFile(base);
+#else
+      munmap(base, length);
+#endif
+    }
+  }
+
+private:
+  vtkRawImageMappedRegion(const vtkRawImageMappedRegion&) = delete;
+  void operator=(const vtkRawImageMappedRegion&) = delete;
+
+  char* Base = nullptr;
+  size_t Length = 0;
+  char* Data = nullptr;
+};
+
+//----------------------------------------------------------------------------
+// Mappings referenced by data arrays, indexed by the array pointer. Data
+// arrays only give their pointer to the free function, so this is needed to
+// find what to unmap. Never destroyed since arrays may outlive static data.
+struct vtkRawImageArrayMappings
+{
+  std::mutex Mutex;
+  std::map<void*, std::pair<char*, size_t> > Mappings;
+};
+
+vtkRawImageArrayMappings& GetArrayMappings()
+{
+  static vtkRawImageArrayMappings* mappings = new vtkRawImageArrayMappings;
+  return *mappings;
+}
+
+void vtkRawImageFreeArrayMapping(void* data)
+{
+  vtkRawImageArrayMappings& mappings = GetArrayMappings();
+  std::pair<char*, size_t> mapping(nullptr, 0);
+  {
+    std::lock_guard<std::mutex> lock(mappings.Mutex);
+    auto iter = mappings.Mappings.find(data);
+    if (iter == mappings.Mappings.end())
+    {
+      return;
+    }
+    mapping = iter->second;
+    mappings.Mappings.erase(iter);
+  }
+  vtkRawImageMappedRegion::Unmap(mapping.first, mapping.second);
+}
+
+void vtkRawImageMappedRegion::TransferTo(vtkDataArray* array, vtkIdType numberOfValues)
+{
+  vtkRawImageArrayMappings& mappings = GetArrayMappings();
+  {
+    std::lock_guard<std::mutex> lock(mappings.Mutex);
+    mappings.Mappings[this->Data] = std::make_pair(this->Base, this->Length);
+  }
+  array->SetVoidArray(this->Data, numberOfValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(&vtkRawImageFreeArrayMapping);
+  this->Base = nullptr;
+  this->Length = 0;
+  this->Data = nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Copies the rows of the update extent from the mapped file(s) to the output
+// scalars, one slice per iteration so that page faults are served in
+// parallel.
+class vtkRawImageCopySlicesFunctor
+{
+public:
+  // Mapped data of the first requested row of each slice.
+  std::vector<const char*> Slices;
+  // Offset, in rows, from one output row to the next in the file, either 1 or
+  // -1 when rows are stored from top to bottom.
+  vtkTypeInt64 RowStep;
+  vtkTypeInt64 RowIncrement;
+  vtkTypeInt64 RowLength;
+  int NumberOfRows;
+  int ScalarSize;
+  bool SwapBytes;
+  char* Output;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType slice = begin; slice < end; ++slice)
+    {
+      const char* source = this->Slices[slice];
+      char* dest = this->Output + slice * this->NumberOfRows * this->RowLength;
+      for (int row = 0; row < this->NumberOfRows; ++row)
+      {
+        memcpy(dest, source, this->RowLength);
+        if (this->SwapBytes && this->ScalarSize > 1)
+        {
+          vtkByteSwap::SwapVoidRange(dest, this->RowLength / this->ScalarSize, this->ScalarSize);
+        }
+        source += this->RowStep * this->RowIncrement;
+        dest += this->RowLength;
+      }
+    }
+  }
+};
+}
 
 vtkStandardNewMacro(vtkRawImageFileSeriesReader);
 //----------------------------------------------------------------------------
 vtkRawImageFileSeriesReader::vtkRawImageFileSeriesReader()
   : FileDimensionality(2)
+  , UseMemoryMapping(true)
 {
   for (int i = 0; i < 6; i++)
   {
@@ -55,6 +274,157 @@ void vtkRawImageFileSeriesReader::UpdateReaderDataExtent()
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkRawImageFileSeriesReader::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->UseMemoryMapping && request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()) &&
+    this->RequestMappedData(outputVector->GetInformationObject(0)))
+  {
+    if (!this->ReadAsImageStack && this->NumberOfFilesToPrefetch > 0)
+    {
+      this->PrefetchNextFiles();
+    }
+    return 1;
+  }
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+bool vtkRawImageFileSeriesReader::RequestMappedData(vtkInformation* outInfo)
+{
+  // Options of vtkImageReader that need to process the values are not
+  // supported.
+  vtkImageReader* reader = vtkImageReader::SafeDownCast(this->Reader);
+  vtkImageData* output = vtkImageData::GetData(outInfo);
+  if (!reader || !output || reader->GetTransform())
+  {
+    return false;
+  }
+  const int* voi = reader->GetDataVOI();
+  if (voi[0] || voi[1] || voi[2] || voi[3] || voi[4] || voi[5])
+  {
+    return false;
+  }
+  const int scalarType = reader->GetDataScalarType();
+  const int numComps = reader->GetNumberOfScalarComponents();
+  const int scalarSize = vtkDataArray::GetDataTypeSize(scalarType);
+  if (scalarSize <= 0 || scalarSize > 8 || numComps <= 0)
+  {
+    return false;
+  }
+  const vtkTypeUInt64 typeMask =
+    scalarSize == 8 ? ~vtkTypeUInt64(0) : (vtkTypeUInt64(1) << (8 * scalarSize)) - 1;
+  if ((reader->GetDataMask() & typeMask) != typeMask)
+  {
+    return false;
+  }
+
+  const int fileDim = reader->GetFileDimensionality();
+  if (fileDim == 3 && reader->GetFileNames())
+  {
+    return false;
+  }
+  int dataExt[6];
+  reader->GetDataExtent(dataExt);
+  int ext[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), ext);
+  for (int i = 0; i < 3; ++i)
+  {
+    if (ext[2 * i] > ext[2 * i + 1] || ext[2 * i] < dataExt[2 * i] ||
+      ext[2 * i + 1] > dataExt[2 * i + 1])
+    {
+      return false;
+    }
+  }
+
+  // Same layout as vtkImageReader2: rows are stored from top to bottom when
+  // FileLowerLeft is off, and 2D files each hold one slice.
+  const vtkTypeInt64 incX = static_cast<vtkTypeInt64>(scalarSize) * numComps;
+  const vtkTypeInt64 incY = incX * (dataExt[1] - dataExt[0] + 1);
+  const vtkTypeInt64 incZ = incY * (dataExt[3] - dataExt[2] + 1);
+  const bool flip = !reader->GetFileLowerLeft();
+  const vtkTypeInt64 firstRow = flip ? dataExt[3] - ext[3] : ext[2] - dataExt[2];
+  const vtkTypeInt64 lastRow = flip ? dataExt[3] - ext[2] : ext[3] - dataExt[2];
+  const vtkTypeInt64 rowLength = incX * (ext[1] - ext[0] + 1);
+  const int numRows = ext[3] - ext[2] + 1;
+  const int numSlices = ext[5] - ext[4] + 1;
+  const int numRegions = fileDim == 3 ? 1 : numSlices;
+
+  std::vector<std::unique_ptr<vtkRawImageMappedRegion> > regions;
+  vtkRawImageCopySlicesFunctor copier;
+  for (int r = 0; r < numRegions; ++r)
+  {
+    const int slice = fileDim == 3 ? dataExt[4] : ext[4] + r;
+    reader->ComputeInternalFileName(slice);
+    const char* filename = reader->GetInternalFileName();
+    const vtkTypeInt64 header = static_cast<vtkTypeInt64>(reader->GetHeaderSize(slice));
+    if (!filename || header < 0)
+    {
+      return false;
+    }
+    const vtkTypeInt64 slices = fileDim == 3 ? numSlices : 1;
+    const vtkTypeInt64 start = header + (fileDim == 3 ? (ext[4] - dataExt[4]) * incZ : 0) +
+      firstRow * incY + (ext[0] - dataExt[0]) * incX;
+    const vtkTypeInt64 end = start + (slices - 1) * incZ + (lastRow - firstRow) * incY + rowLength;
+
+    std::unique_ptr<vtkRawImageMappedRegion> region(new vtkRawImageMappedRegion);
+    if (!region->Map(filename, start, end - start))
+    {
+      vtkDebugMacro("Cannot map " << filename << ", using the image reader.");
+      return false;
+    }
+    for (vtkTypeInt64 cc = 0; cc < slices; ++cc)
+    {
+      // Output rows go from bottom to top, so start from the last row when
+      // the file rows go from top to bottom.
+      const vtkTypeInt64 firstOutputRowOffset = flip ? (lastRow - firstRow) * incY : 0;
+      copier.Slices.push_back(region->GetData() + cc * incZ + firstOutputRowOffset);
+    }
+    regions.push_back(std::move(region));
+  }
+
+  const vtkIdType numValues = static_cast<vtkIdType>(numComps) * (ext[1] - ext[0] + 1) *
+    numRows * numSlices;
+  vtkSmartPointer<vtkDataArray> scalars =
+    vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(scalarType));
+  scalars->SetNumberOfComponents(numComps);
+  scalars->SetName(reader->GetScalarArrayName());
+
+  const bool contiguous = numRegions == 1 && ext[0] == dataExt[0] && ext[1] == dataExt[1] &&
+    ext[2] == dataExt[2] && ext[3] == dataExt[3];
+  const bool aligned = reinterpret_cast<uintptr_t>(copier.Slices[0]) % scalarSize == 0;
+  if (contiguous && aligned && !flip && !reader->GetSwapBytes())
+  {
+    // The mapped memory is exactly the output scalars.
+    regions[0]->TransferTo(scalars, numValues);
+  }
+  else
+  {
+    scalars->SetNumberOfTuples(numValues / numComps);
+    copier.RowStep = flip ? -1 : 1;
+    copier.RowIncrement = incY;
+    copier.RowLength = rowLength;
+    copier.NumberOfRows = numRows;
+    copier.ScalarSize = scalarSize;
+    copier.SwapBytes = reader->GetSwapBytes() != 0;
+    copier.Output = static_cast<char*>(scalars->GetVoidPointer(0));
+    vtkSMPTools::For(0, numSlices, copier);
+  }
+
+  output->SetExtent(ext);
+  if (outInfo->Has(vtkDataObject::SPACING()))
+  {
+    output->SetSpacing(outInfo->Get(vtkDataObject::SPACING()));
+  }
+  if (outInfo->Has(vtkDataObject::ORIGIN()))
+  {
+    output->SetOrigin(outInfo->Get(vtkDataObject::ORIGIN()));
+  }
+  output->GetPointData()->SetScalars(scalars);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkRawImageFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -66,4 +436,5 @@ void vtkRawImageFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << ")\n";
   os << indent << "File Dimensionality: " << this->FileDimensionality << "\n";
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << "\n";
 }
@@ -19,6 +19,13 @@
  * vtkRawImageFileSeriesReader is designed to read in raw files. The issue
  * with raw files is that the extents are not known and must be passed to
  * vtkImageReader2 and subclasses.
+ *
+ * When UseMemoryMapping is on, the requested update extent is read directly
+ * from a memory mapping of the file(s) instead of reading whole slices
+ * through the internal vtkImageReader, so that only the pages overlapping the
+ * update extent are read from disk. When the update extent covers whole
+ * slices of a single file that needs no byte swapping or row flipping, the
+ * output scalars reference the mapping directly and nothing is copied.
 */
 
 #ifndef vtkRawImageFileSeriesReader_h
@@ -50,6 +57,22 @@ public:
   vtkGetVector6Macro(DataExtent, int);
   //@}
 
+  //@{
+  /**
+   * When on, the data is read through a memory mapping of the file(s) when
+   * the internal reader options allow it. The internal reader is used
+   * otherwise. Default is on.
+   */
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+  //@}
+
+  /**
+   * Overridden to read the data through a memory mapping when possible.
+   */
+  int ProcessRequest(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
 protected:
   vtkRawImageFileSeriesReader();
   ~vtkRawImageFileSeriesReader();
@@ -82,6 +105,15 @@ protected:
   int FileDimensionality;
   //@}
 
+  bool UseMemoryMapping;
+
+  /**
+   * Reads the update extent of the output through a memory mapping. Returns
+   * false, without modifying the output, if the internal reader options are
+   * not supported or if the file(s) cannot be mapped.
+   */
+  bool RequestMappedData(vtkInformation* outInfo);
+
 private:
   vtkRawImageFileSeriesReader(const vtkRawImageFileSeriesReader&) = delete;
   void operator=(const vtkRawImageFileSeriesReader&) = delete;
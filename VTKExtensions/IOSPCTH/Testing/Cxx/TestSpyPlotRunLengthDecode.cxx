@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSpyPlotRunLengthDecode.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks vtkSpyPlotUniReader::DecodeRunLengthData against synthetic CTH
+// run-length encoded streams and measures its throughput. Streams mix long
+// runs of constant values, as found in void regions, and literal runs.
+//
+// Use `--iterations=N` to change the number of times each stream is decoded.
+
+#include "vtkNew.h"
+#include "vtkSpyPlotUniReader.h"
+#include "vtkTimerLog.h"
+#include "vtkType.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <vtksys/CommandLineArguments.hxx>
+
+namespace
+{
+void AppendBigEndianFloat(std::vector<unsigned char>& stream, float value)
+{
+  vtkTypeUInt32 bits;
+  memcpy(&bits, &value, sizeof(float));
+  stream.push_back(static_cast<unsigned char>(bits >> 24));
+  stream.push_back(static_cast<unsigned char>(bits >> 16));
+  stream.push_back(static_cast<unsigned char>(bits >> 8));
+  stream.push_back(static_cast<unsigned char>(bits));
+}
+
+// Encodes `values` using runs of at most 127 repeated values and literal runs
+// of at most 127 values, as CTH does.
+std::vector<unsigned char> Encode(const std::vector<float>& values)
+{
+  std::vector<unsigned char> stream;
+  size_t cc = 0;
+  while (cc < values.size())
+  {
+    size_t run = 1;
+    while (cc + run < values.size() && run < 127 && values[cc + run] == values[cc])
+    {
+      ++run;
+    }
+    if (run > 2)
+    {
+      stream.push_back(static_cast<unsigned char>(run));
+      AppendBigEndianFloat(stream, values[cc]);
+      cc += run;
+      continue;
+    }
+    size_t literal = 0;
+    while (cc + literal < values.size() && literal < 127 &&
+      !(cc + literal + 2 < values.size() && values[cc + literal] == values[cc + literal + 1] &&
+        values[cc + literal] == values[cc + literal + 2]))
+    {
+      ++literal;
+    }
+    literal = std::max<size_t>(literal, 1);
+    stream.push_back(static_cast<unsigned char>(128 + literal));
+    for (size_t kk = 0; kk < literal; ++kk)
+    {
+      AppendBigEndianFloat(stream, values[cc + kk]);
+    }
+    cc += literal;
+  }
+  return stream;
+}
+
+std::vector<float> GenerateValues(int size)
+{
+  std::vector<float> values(size);
+  for (int cc = 0; cc < size; ++cc)
+  {
+    // Constant stretches alternating with a smoothly varying field.
+    values[cc] = (cc / 500) % 2 ? 0.0f : static_cast<float>(std::sin(0.01 * cc));
+  }
+  return values;
+}
+}
+
+int TestSpyPlotRunLengthDecode(int argc, char* argv[])
+{
+  int iterations = 200;
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  arg.StoreUnusedArguments(true);
+  arg.AddArgument("--iterations", vtksys::CommandLineArguments::EQUAL_ARGUMENT, &iterations,
+    "Number of times each stream is decoded.");
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return EXIT_FAILURE;
+  }
+
+  const int size = 256 * 256;
+  const std::vector<float> values = GenerateValues(size);
+  const std::vector<unsigned char> stream = Encode(values);
+  const int streamSize = static_cast<int>(stream.size());
+
+  // Float decoding must be exact.
+  std::vector<float> decoded(size);
+  if (!vtkSpyPlotUniReader::DecodeRunLengthData(&stream[0], streamSize, &decoded[0], size) ||
+    decoded != values)
+  {
+    cerr << "Float decoding mismatch." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Unsigned char decoding scales values by 255.
+  std::vector<unsigned char> decodedChars(size);
+  if (!vtkSpyPlotUniReader::DecodeRunLengthData(&stream[0], streamSize, &decodedChars[0], size))
+  {
+    cerr << "Unsigned char decoding failed." << endl;
+    return EXIT_FAILURE;
+  }
+  for (int cc = 0; cc < size; ++cc)
+  {
+    if (decodedChars[cc] != static_cast<unsigned char>(values[cc] * 255))
+    {
+      cerr << "Unsigned char decoding mismatch at " << cc << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Malformed streams must be rejected.
+  if (vtkSpyPlotUniReader::DecodeRunLengthData(&stream[0], streamSize, &decoded[0], size / 2))
+  {
+    cerr << "Decoding more values than expected was not reported." << endl;
+    return EXIT_FAILURE;
+  }
+  if (vtkSpyPlotUniReader::DecodeRunLengthData(&stream[0], streamSize - 2, &decoded[0], size))
+  {
+    cerr << "Decoding a truncated stream was not reported." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int iter = 0; iter < iterations; ++iter)
+  {
+    vtkSpyPlotUniReader::DecodeRunLengthData(&stream[0], streamSize, &decoded[0], size);
+  }
+  timer->StopTimer();
+
+  const double elapsed = timer->GetElapsedTime();
+  const double total = static_cast<double>(size) * iterations;
+  cout << "Decoded " << total << " values from " << streamSize << " byte streams in " << elapsed
+       << " s (" << total / std::max(elapsed, 1e-9) << " values/s)" << endl;
+  return EXIT_SUCCESS;
+}
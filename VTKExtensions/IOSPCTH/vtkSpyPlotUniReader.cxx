@@ -5,6 +5,7 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
@@ -12,6 +13,9 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <sstream>
 #include <vector>
 
@@ -41,6 +45,103 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+inline float vtkSpyPlotReadBigEndianFloat(const unsigned char* ptr)
+{
+  // Written with shifts so that the literal run loop below is vectorized.
+  const vtkTypeUInt32 bits = (static_cast<vtkTypeUInt32>(ptr[0]) << 24) |
+    (static_cast<vtkTypeUInt32>(ptr[1]) << 16) | (static_cast<vtkTypeUInt32>(ptr[2]) << 8) |
+    static_cast<vtkTypeUInt32>(ptr[3]);
+  float val;
+  memcpy(&val, &bits, sizeof(float));
+  return val;
+}
+
+template <class t>
+int vtkSpyPlotUniReaderRunLengthDataDecode(
+  const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
+{
+  int outIndex = 0, inIndex = 0;
+
+  /* Run-length decode */
+  while ((outIndex < outSize) && (inIndex < inSize))
+  {
+    // Okay get the run length
+    const int runLength = in[inIndex];
+    if (runLength < 128)
+    {
+      // A single value repeated runLength times
+      if (inIndex + 5 > inSize || outIndex + runLength > outSize)
+      {
+        return 0;
+      }
+      const t val = static_cast<t>(vtkSpyPlotReadBigEndianFloat(in + inIndex + 1) * scale);
+      std::fill_n(out + outIndex, runLength, val);
+      outIndex += runLength;
+      inIndex += 5;
+    }
+    else // runLength >= 128
+    {
+      // runLength - 128 literal values
+      const int count = runLength - 128;
+      if (inIndex + 1 + 4 * count > inSize || outIndex + count > outSize)
+      {
+        return 0;
+      }
+      const unsigned char* src = in + inIndex + 1;
+      t* dst = out + outIndex;
+      for (int k = 0; k < count; ++k)
+      {
+        dst[k] = static_cast<t>(vtkSpyPlotReadBigEndianFloat(src + 4 * k) * scale);
+      }
+      outIndex += count;
+      inIndex += 4 * count + 1;
+    }
+  } // while
+
+  return 1;
+}
+
+// A plane of a block, read from the file and waiting to be decoded.
+struct vtkSpyPlotEncodedPlane
+{
+  size_t Offset;
+  int NumberOfBytes;
+  float* FloatOutput;
+  unsigned char* UnsignedCharOutput;
+  int PlaneSize;
+};
+
+// Decodes independent planes concurrently.
+class vtkSpyPlotDecodePlanesFunctor
+{
+public:
+  const unsigned char* Buffer;
+  const std::vector<vtkSpyPlotEncodedPlane>* Planes;
+  std::atomic<bool> Failed;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end && !this->Failed; ++cc)
+    {
+      const vtkSpyPlotEncodedPlane& plane = (*this->Planes)[cc];
+      const unsigned char* in = this->Buffer + plane.Offset;
+      const int status = plane.FloatOutput
+        ? vtkSpyPlotUniReader::DecodeRunLengthData(
+            in, plane.NumberOfBytes, plane.FloatOutput, plane.PlaneSize)
+        : vtkSpyPlotUniReader::DecodeRunLengthData(
+            in, plane.NumberOfBytes, plane.UnsignedCharOutput, plane.PlaneSize);
+      if (!status)
+      {
+        this->Failed = true;
+      }
+    }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -215,6 +316,8 @@ int vtkSpyPlotUniReader::MakeCurrent()
   }
 
   std::vector<unsigned char> arrayBuffer;
+  std::vector<unsigned char> encodedBytes;
+  std::vector<vtkSpyPlotEncodedPlane> encodedPlanes;
   vtksys::ifstream ifs(this->FileName, ios::binary | ios::in);
   vtkSpyPlotIStream spis;
   spis.SetStream(&ifs);
@@ -390,6 +493,23 @@ int vtkSpyPlotUniReader::MakeCurrent()
     // << " [" << var->Name << "]" );
     // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
     spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
+    // The encoded planes of all the blocks are read first, then decoded
+    // concurrently since planes are independent.
+    encodedBytes.clear();
+    encodedPlanes.clear();
+    std::vector<int> newBlocks;
+    // Do not keep partially read or decoded blocks around.
+    auto discardNewBlocks = [&](vtkDataArray* current) {
+      if (current)
+      {
+        current->Delete();
+      }
+      for (int id : newBlocks)
+      {
+        var->DataBlocks[id]->Delete();
+        var->DataBlocks[id] = 0;
+      }
+    };
     int numBytes;
     int block;
     int actualBlockId = 0;
@@ -429,45 +549,62 @@ int vtkSpyPlotUniReader::MakeCurrent()
           if (!spis.ReadInt32s(&numBytes, 1))
           {
             vtkErrorMacro("Problem reading the number of bytes");
+            discardNewBlocks(dataArray);
             return 0;
           }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
-          {
-            arrayBuffer.resize(numBytes);
-          }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
-          {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
-          }
-          if (floatArray)
+          if (!dataArray)
           {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
+            // Not decoded, skip the bytes
+            if (static_cast<int>(arrayBuffer.size()) < numBytes)
             {
-              vtkErrorMacro("Problem RLD decoding float data array");
-              return 0;
+              arrayBuffer.resize(numBytes);
             }
-          }
-          if (unsignedCharArray)
-          {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
+            if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
             {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
+              vtkErrorMacro("Problem reading the bytes");
+              discardNewBlocks(dataArray);
               return 0;
             }
+            continue;
+          }
+          vtkSpyPlotEncodedPlane plane;
+          plane.Offset = encodedBytes.size();
+          plane.NumberOfBytes = numBytes;
+          plane.FloatOutput = floatArray ? floatArray->GetPointer(zax * planeSize) : nullptr;
+          plane.UnsignedCharOutput =
+            unsignedCharArray ? unsignedCharArray->GetPointer(zax * planeSize) : nullptr;
+          plane.PlaneSize = planeSize;
+          encodedBytes.resize(plane.Offset + numBytes);
+          if (numBytes > 0 && !spis.ReadString(&encodedBytes[plane.Offset], numBytes))
+          {
+            vtkErrorMacro("Problem reading the bytes");
+            discardNewBlocks(dataArray);
+            return 0;
           }
+          encodedPlanes.push_back(plane);
         }
         if (dataArray)
         {
           var->DataBlocks[actualBlockId] = dataArray;
           var->GhostCellsFixed[actualBlockId] = 0;
+          newBlocks.push_back(actualBlockId);
           vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
           actualBlockId++;
         }
       }
     }
+
+    vtkSpyPlotDecodePlanesFunctor decoder;
+    decoder.Buffer = encodedBytes.empty() ? nullptr : &encodedBytes[0];
+    decoder.Planes = &encodedPlanes;
+    decoder.Failed = false;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(encodedPlanes.size()), decoder);
+    if (decoder.Failed)
+    {
+      vtkErrorMacro("Problem RLD decoding data array " << var->Name);
+      discardNewBlocks(nullptr);
+      return 0;
+    }
   }
 
   if (blocksUpdated && needMarkers)
@@ -665,86 +802,64 @@ void vtkSpyPlotUniReader::PrintInformation()
    n bytes long. */
 
 //-----------------------------------------------------------------------------
-template <class t>
-int vtkSpyPlotUniReaderRunLengthDataDecode(
-  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
+int vtkSpyPlotUniReader::DecodeRunLengthData(
+  const unsigned char* in, int inSize, float* out, int outSize)
 {
-  int outIndex = 0, inIndex = 0;
-
-  const unsigned char* ptmp = in;
+  return ::vtkSpyPlotUniReaderRunLengthDataDecode(in, inSize, out, outSize);
+}
 
-  /* Run-length decode */
-  while ((outIndex < outSize) && (inIndex < inSize))
-  {
-    // Okay get the run length
-    unsigned char runLength = *ptmp;
-    ptmp++;
-    if (runLength < 128)
-    {
-      float val;
-      memcpy(&val, ptmp, sizeof(float));
-      vtkByteSwap::SwapBE(&val);
-      ptmp += 4;
-      // Now populate the out data
-      int k;
-      for (k = 0; k < runLength; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-      }
-      inIndex += 5;
-    }
-    else // runLength >= 128
-    {
-      int k;
-      for (k = 0; k < runLength - 128; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        float val;
-        memcpy(&val, ptmp, sizeof(float));
-        vtkByteSwap::SwapBE(&val);
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-        ptmp += 4;
-      }
-      inIndex += 4 * (runLength - 128) + 1;
-    }
-  } // while
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::DecodeRunLengthData(
+  const unsigned char* in, int inSize, int* out, int outSize)
+{
+  return ::vtkSpyPlotUniReaderRunLengthDataDecode(in, inSize, out, outSize);
+}
 
-  return 1;
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::DecodeRunLengthData(
+  const unsigned char* in, int inSize, unsigned char* out, int outSize)
+{
+  return ::vtkSpyPlotUniReaderRunLengthDataDecode(
+    in, inSize, out, outSize, static_cast<unsigned char>(255));
 }
 
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, float* out, int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(this, in, inSize, out, outSize);
+  if (!vtkSpyPlotUniReader::DecodeRunLengthData(in, inSize, out, outSize))
+  {
+    vtkErrorMacro("Problem doing RLD decode. "
+      << "Truncated data or too much data generated. Expected: " << outSize);
+    return 0;
+  }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, int* out, int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(this, in, inSize, out, outSize);
+  if (!vtkSpyPlotUniReader::DecodeRunLengthData(in, inSize, out, outSize))
+  {
+    vtkErrorMacro("Problem doing RLD decode. "
+      << "Truncated data or too much data generated. Expected: " << outSize);
+    return 0;
+  }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, unsigned char* out, int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(
-    this, in, inSize, out, outSize, static_cast<unsigned char>(255));
+  if (!vtkSpyPlotUniReader::DecodeRunLengthData(in, inSize, out, outSize))
+  {
+    vtkErrorMacro("Problem doing RLD decode. "
+      << "Truncated data or too much data generated. Expected: " << outSize);
+    return 0;
+  }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
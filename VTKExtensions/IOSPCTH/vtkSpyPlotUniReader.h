@@ -231,6 +231,19 @@ public:
   vtkSetMacro(DataTypeChanged, int);
   void SetDownConvertVolumeFraction(int vf);
 
+  //@{
+  /**
+   * Decodes `inSize` bytes of CTH run-length encoded data into `outSize`
+   * values. When decoding to unsigned char, values are scaled by 255.
+   * Returns 0 if the encoded data is truncated or would generate more than
+   * `outSize` values.
+   */
+  static int DecodeRunLengthData(const unsigned char* in, int inSize, float* out, int outSize);
+  static int DecodeRunLengthData(const unsigned char* in, int inSize, int* out, int outSize);
+  static int DecodeRunLengthData(
+    const unsigned char* in, int inSize, unsigned char* out, int outSize);
+  //@}
+
 protected:
   vtkSpyPlotUniReader();
   ~vtkSpyPlotUniReader() override;
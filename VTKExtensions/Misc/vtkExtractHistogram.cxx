@@ -14,9 +14,11 @@
 =========================================================================*/
 #include "vtkExtractHistogram.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkGraph.h"
@@ -27,10 +29,13 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 
+#include <cmath>
 #include <map>
 #include <string>
 #include <vector>
@@ -283,6 +288,189 @@ inline int vtkExtractHistogramClamp(int value, int min, int max)
   return value;
 }
 
+namespace
+{
+// Counts the values of an array falling in each bin, using thread local
+// counts. Bins are uniform, so the bin of each value is computed directly.
+// When `BinIndices` is set, the bin of each tuple is also recorded so that
+// other arrays can be accumulated per bin afterwards.
+template <typename ArrayT>
+class vtkExtractHistogramBinFunctor
+{
+public:
+  vtkExtractHistogramBinFunctor(ArrayT* array, int component, double min, double offset,
+    double delta, int binCount, int* binIndices)
+    : Array(array)
+    , Component(component)
+    , Min(min)
+    , Offset(offset)
+    , Delta(delta)
+    , BinCount(binCount)
+    , BinIndices(binIndices)
+  {
+  }
+
+  void Initialize() { this->LocalCounts.Local().assign(this->BinCount, 0); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(this->Array);
+    std::vector<vtkIdType>& counts = this->LocalCounts.Local();
+    const int numComps = this->Array->GetNumberOfComponents();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      double value;
+      // if component is equal to the number of components, then the magnitude was requested.
+      if (this->Component == numComps)
+      {
+        value = 0;
+        for (int j = 0; j < numComps; ++j)
+        {
+          const double comp = static_cast<double>(accessor.Get(i, j));
+          value += comp * comp;
+        }
+        value = std::sqrt(value);
+      }
+      else
+      {
+        value = static_cast<double>(accessor.Get(i, this->Component));
+      }
+      int index = static_cast<int>((value - this->Min + this->Offset) / this->Delta);
+
+      // If the value is equal to max, include it in the last bin.
+      index = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
+      ++counts[index];
+      if (this->BinIndices)
+      {
+        this->BinIndices[i] = index;
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  void AddCounts(vtkIntArray* binValues)
+  {
+    for (auto iter = this->LocalCounts.begin(); iter != this->LocalCounts.end(); ++iter)
+    {
+      for (int bin = 0; bin < this->BinCount; ++bin)
+      {
+        binValues->SetValue(bin, binValues->GetValue(bin) + static_cast<int>((*iter)[bin]));
+      }
+    }
+  }
+
+private:
+  ArrayT* Array;
+  int Component;
+  double Min;
+  double Offset;
+  double Delta;
+  int BinCount;
+  int* BinIndices;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > LocalCounts;
+};
+
+struct vtkExtractHistogramBinWorker
+{
+  int Component;
+  double Min;
+  double Offset;
+  double Delta;
+  int BinCount;
+  int* BinIndices;
+  vtkIntArray* BinValues;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    vtkExtractHistogramBinFunctor<ArrayT> functor(array, this->Component, this->Min, this->Offset,
+      this->Delta, this->BinCount, this->BinIndices);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+    functor.AddCounts(this->BinValues);
+  }
+};
+
+// Sums the tuples of an array per bin, given the bin of each tuple.
+template <typename ArrayT>
+class vtkExtractHistogramTotalsFunctor
+{
+public:
+  vtkExtractHistogramTotalsFunctor(ArrayT* array, const int* binIndices, int binCount)
+    : Array(array)
+    , BinIndices(binIndices)
+    , BinCount(binCount)
+  {
+  }
+
+  void Initialize()
+  {
+    this->LocalTotals.Local().assign(
+      static_cast<size_t>(this->BinCount) * this->Array->GetNumberOfComponents(), 0.0);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(this->Array);
+    std::vector<double>& totals = this->LocalTotals.Local();
+    const int numComps = this->Array->GetNumberOfComponents();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      double* binTotals = &totals[static_cast<size_t>(this->BinIndices[i]) * numComps];
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        binTotals[comp] += static_cast<double>(accessor.Get(i, comp));
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  void AddTotals(std::vector<std::vector<double> >& totalValues)
+  {
+    const int numComps = this->Array->GetNumberOfComponents();
+    totalValues.resize(this->BinCount);
+    for (auto& binTotals : totalValues)
+    {
+      binTotals.resize(numComps);
+    }
+    for (auto iter = this->LocalTotals.begin(); iter != this->LocalTotals.end(); ++iter)
+    {
+      const std::vector<double>& totals = *iter;
+      for (int bin = 0; bin < this->BinCount; ++bin)
+      {
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          totalValues[bin][comp] += totals[static_cast<size_t>(bin) * numComps + comp];
+        }
+      }
+    }
+  }
+
+private:
+  ArrayT* Array;
+  const int* BinIndices;
+  int BinCount;
+  vtkSMPThreadLocal<std::vector<double> > LocalTotals;
+};
+
+struct vtkExtractHistogramTotalsWorker
+{
+  const int* BinIndices;
+  vtkIdType NumberOfTuples;
+  int BinCount;
+  std::vector<std::vector<double> >* TotalValues;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    vtkExtractHistogramTotalsFunctor<ArrayT> functor(array, this->BinIndices, this->BinCount);
+    vtkSMPTools::For(0, this->NumberOfTuples, functor);
+    functor.AddTotals(*this->TotalValues);
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 void vtkExtractHistogram::BinAnArray(
   vtkDataArray* data_array, vtkIntArray* bin_values, double min, double max, vtkFieldData* field)
@@ -295,62 +483,56 @@ void vtkExtractHistogram::BinAnArray(
     return;
   }
 
-  int num_of_tuples = data_array->GetNumberOfTuples();
+  const vtkIdType num_of_tuples = data_array->GetNumberOfTuples();
+  if (num_of_tuples == 0)
+  {
+    return;
+  }
   double bin_delta =
     (max - min) / (this->CenterBinsAroundMinAndMax ? (this->BinCount - 1) : this->BinCount);
   double half_delta = bin_delta / 2.0;
 
-  for (int i = 0; i != num_of_tuples; ++i)
+  // Record the bin of each tuple only if other arrays are to be accumulated.
+  std::vector<int> bin_indices;
+  if (this->CalculateAverages)
   {
-    if (i % 1000 == 0)
-    {
-      this->UpdateProgress(0.10 + 0.90 * i / num_of_tuples);
-    }
-    double value;
-    // if component is equal to the number of components, then the magnitude was requested.
-    if (this->Component == data_array->GetNumberOfComponents())
-    {
-      value = 0;
-      double comp;
-      for (int j = 0; j < data_array->GetNumberOfComponents(); ++j)
-      {
-        comp = data_array->GetComponent(i, j);
-        value += comp * comp;
-      }
-      value = sqrt(value);
-    }
-    else
-    {
-      value = data_array->GetComponent(i, this->Component);
-    }
-    int index = static_cast<int>(
-      (value - min + (this->CenterBinsAroundMinAndMax ? half_delta : 0.)) / bin_delta);
+    bin_indices.resize(num_of_tuples);
+  }
 
-    // If the value is equal to max, include it in the last bin.
-    index = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
-    bin_values->SetValue(index, bin_values->GetValue(index) + 1);
+  this->UpdateProgress(0.10);
+  vtkExtractHistogramBinWorker binWorker;
+  binWorker.Component = this->Component;
+  binWorker.Min = min;
+  binWorker.Offset = this->CenterBinsAroundMinAndMax ? half_delta : 0.;
+  binWorker.Delta = bin_delta;
+  binWorker.BinCount = this->BinCount;
+  binWorker.BinIndices = bin_indices.empty() ? nullptr : bin_indices.data();
+  binWorker.BinValues = bin_values;
+  if (!vtkArrayDispatch::Dispatch::Execute(data_array, binWorker))
+  {
+    binWorker(data_array);
+  }
 
-    if (this->CalculateAverages)
+  if (this->CalculateAverages)
+  {
+    this->UpdateProgress(0.50);
+    // Get all other arrays, add their values to the bin. At the end, each
+    // total is divided by the number of elements in the bin.
+    vtkExtractHistogramTotalsWorker totalsWorker;
+    totalsWorker.BinIndices = bin_indices.data();
+    totalsWorker.NumberOfTuples = num_of_tuples;
+    totalsWorker.BinCount = this->BinCount;
+    int num_arrays = field->GetNumberOfArrays();
+    for (int idx = 0; idx < num_arrays; idx++)
     {
-      // Get all other arrays, add their value to the bin
-      // For each bin, we will need 2 values per array ->
-      // total, num. elements
-      // at the end, divide each total by num. elements
-      int num_arrays = field->GetNumberOfArrays();
-      for (int idx = 0; idx < num_arrays; idx++)
+      vtkDataArray* array = field->GetArray(idx);
+      if (array && array != data_array && array->GetName() &&
+        array->GetNumberOfTuples() >= num_of_tuples)
       {
-        vtkDataArray* array = field->GetArray(idx);
-        if (array && array != data_array && array->GetName())
+        totalsWorker.TotalValues = &this->Internal->ArrayValues[array->GetName()].TotalValues;
+        if (!vtkArrayDispatch::Dispatch::Execute(array, totalsWorker))
         {
-          vtkEHInternals::ArrayValuesType& arrayValues =
-            this->Internal->ArrayValues[array->GetName()];
-          arrayValues.TotalValues.resize(this->BinCount);
-          int numComps = array->GetNumberOfComponents();
-          arrayValues.TotalValues[index].resize(numComps);
-          for (int comp = 0; comp < numComps; comp++)
-          {
-            arrayValues.TotalValues[index][comp] += array->GetComponent(i, comp);
-          }
+          totalsWorker(array);
         }
       }
     }
@@ -422,6 +604,7 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
     vtkDataArray* data_array = this->GetInputArrayToProcess(0, inputVector);
     this->BinAnArray(data_array, bin_values, min, max, this->GetInputFieldData(input));
   }
+  this->UpdateProgress(1.0);
 
   if (this->CalculateAverages)
   {